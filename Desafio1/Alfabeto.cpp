@@ -0,0 +1,401 @@
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include "Alfabeto.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define DESAFIO_X86_SIMD 1
+#endif
+
+using namespace std;
+
+Alfabeto::Alfabeto() {
+    memset(filas, 0, sizeof(filas));
+}
+
+void Alfabeto::agregar(unsigned char c) {
+    filas[c >> 7][c & 15] |= (unsigned char)(1u << ((c >> 4) & 7));
+}
+
+void Alfabeto::agregarRango(unsigned char desde, unsigned char hasta) {
+    for (int c = desde; c <= hasta; c++) {
+        agregar((unsigned char)c);
+    }
+}
+
+int Alfabeto::tamaño() const {
+    int cantidad = 0;
+    for (int c = 0; c < 256; c++) {
+        cantidad += contiene((unsigned char)c) ? 1 : 0;
+    }
+    return cantidad;
+}
+
+// ---------------------------------------------------------------------------
+// Validación
+// ---------------------------------------------------------------------------
+
+/*
+ * Las posiciones de los caracteres dentro de un grupo de ternas son las congruentes
+ * con 2 módulo 3. Un grupo de 16 ternas ocupa 48 bytes (tres registros SSE) y uno de
+ * 32 ternas, 96 bytes (tres registros AVX2): con estas máscaras se descartan los bits
+ * de las referencias y cuentas, que pueden tener cualquier valor.
+ */
+static constexpr uint64_t PosicionesCaracter(int desde, int cantidad) {
+    uint64_t mascara = 0;
+    for (int i = 0; i < cantidad; i++) {
+        if ((desde + i) % 3 == 2) {
+            mascara |= 1ULL << i;
+        }
+    }
+    return mascara;
+}
+
+static const uint64_t CARACTERES_48 = PosicionesCaracter(0, 48);
+static const uint64_t CARACTERES_96_BAJOS = PosicionesCaracter(0, 64);
+static const uint64_t CARACTERES_96_ALTOS = PosicionesCaracter(64, 32);
+
+static size_t PrimerFueraEscalar(const Alfabeto& alfabeto, const unsigned char* bytes, size_t cantidad) {
+    for (size_t i = 0; i < cantidad; i++) {
+        if (!alfabeto.contiene(bytes[i])) {
+            return i;
+        }
+    }
+    return cantidad;
+}
+
+static size_t PrimeraTernaInvalidaEscalar(const Alfabeto& alfabeto, const unsigned char* ternas,
+                                          size_t numTernas) {
+    for (size_t t = 0; t < numTernas; t++) {
+        if (!alfabeto.contiene(ternas[3 * t + 2])) {
+            return t;
+        }
+    }
+    return numTernas;
+}
+
+#ifdef DESAFIO_X86_SIMD
+
+/*
+ * Consulta del mapa con pshufb: el nibble bajo elige la fila (en la tabla baja si el
+ * byte es menor a 128, en la alta si no) y el nibble alto elige el bit de esa fila.
+ * pshufb deja en cero los bytes cuyo índice tiene el bit alto prendido, así que
+ * sumar el bit de signo al índice apaga la tabla que no corresponde sin mezclas.
+ * El resultado tiene 0xFF en los bytes que NO pertenecen al alfabeto.
+ */
+
+__attribute__((target("ssse3")))
+static inline __m128i FueraSSSE3(__m128i x, __m128i baja, __m128i alta, __m128i potencias) {
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    const __m128i signo = _mm_set1_epi8((char)0x80);
+    __m128i bajo = _mm_and_si128(x, nibble);
+    __m128i alto = _mm_and_si128(_mm_srli_epi16(x, 4), nibble);
+    __m128i mitad = _mm_and_si128(x, signo);
+    __m128i filaBaja = _mm_shuffle_epi8(baja, _mm_or_si128(bajo, mitad));
+    __m128i filaAlta = _mm_shuffle_epi8(alta, _mm_or_si128(bajo, _mm_xor_si128(mitad, signo)));
+    __m128i bit = _mm_shuffle_epi8(potencias, alto);
+    __m128i presente = _mm_and_si128(_mm_or_si128(filaBaja, filaAlta), bit);
+    return _mm_cmpeq_epi8(presente, _mm_setzero_si128());
+}
+
+__attribute__((target("ssse3")))
+static size_t PrimerFueraSSSE3(const Alfabeto& alfabeto, const unsigned char* bytes, size_t cantidad) {
+    const __m128i baja = _mm_loadu_si128((const __m128i*)alfabeto.fila(0));
+    const __m128i alta = _mm_loadu_si128((const __m128i*)alfabeto.fila(1));
+    const __m128i potencias = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+
+    size_t i = 0;
+    for (; i + 16 <= cantidad; i += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(bytes + i));
+        unsigned int fuera = (unsigned int)_mm_movemask_epi8(FueraSSSE3(x, baja, alta, potencias));
+        if (fuera != 0) {
+            return i + (size_t)__builtin_ctz(fuera);
+        }
+    }
+    return i + PrimerFueraEscalar(alfabeto, bytes + i, cantidad - i);
+}
+
+__attribute__((target("ssse3")))
+static size_t PrimeraTernaInvalidaSSSE3(const Alfabeto& alfabeto, const unsigned char* ternas,
+                                        size_t numTernas) {
+    const __m128i baja = _mm_loadu_si128((const __m128i*)alfabeto.fila(0));
+    const __m128i alta = _mm_loadu_si128((const __m128i*)alfabeto.fila(1));
+    const __m128i potencias = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+
+    size_t t = 0;
+    for (; t + 16 <= numTernas; t += 16) {
+        const unsigned char* p = ternas + 3 * t;
+        uint64_t fuera =
+            (uint64_t)(unsigned int)_mm_movemask_epi8(FueraSSSE3(_mm_loadu_si128((const __m128i*)p), baja, alta, potencias))
+            | (uint64_t)(unsigned int)_mm_movemask_epi8(FueraSSSE3(_mm_loadu_si128((const __m128i*)(p + 16)), baja, alta, potencias)) << 16
+            | (uint64_t)(unsigned int)_mm_movemask_epi8(FueraSSSE3(_mm_loadu_si128((const __m128i*)(p + 32)), baja, alta, potencias)) << 32;
+        fuera &= CARACTERES_48;
+        if (fuera != 0) {
+            return t + (size_t)__builtin_ctzll(fuera) / 3;
+        }
+    }
+    return t + PrimeraTernaInvalidaEscalar(alfabeto, ternas + 3 * t, numTernas - t);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i FueraAVX2(__m256i x, __m256i baja, __m256i alta, __m256i potencias) {
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    const __m256i signo = _mm256_set1_epi8((char)0x80);
+    __m256i bajo = _mm256_and_si256(x, nibble);
+    __m256i alto = _mm256_and_si256(_mm256_srli_epi16(x, 4), nibble);
+    __m256i mitad = _mm256_and_si256(x, signo);
+    __m256i filaBaja = _mm256_shuffle_epi8(baja, _mm256_or_si256(bajo, mitad));
+    __m256i filaAlta = _mm256_shuffle_epi8(alta, _mm256_or_si256(bajo, _mm256_xor_si256(mitad, signo)));
+    __m256i bit = _mm256_shuffle_epi8(potencias, alto);
+    __m256i presente = _mm256_and_si256(_mm256_or_si256(filaBaja, filaAlta), bit);
+    return _mm256_cmpeq_epi8(presente, _mm256_setzero_si256());
+}
+
+// pshufb de 256 bits consulta cada mitad del registro por separado: las tablas van repetidas
+__attribute__((target("avx2")))
+static size_t PrimerFueraAVX2(const Alfabeto& alfabeto, const unsigned char* bytes, size_t cantidad) {
+    const __m256i baja = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)alfabeto.fila(0)));
+    const __m256i alta = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)alfabeto.fila(1)));
+    const __m256i potencias = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+                                               1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+
+    size_t i = 0;
+    for (; i + 32 <= cantidad; i += 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(bytes + i));
+        unsigned int fuera = (unsigned int)_mm256_movemask_epi8(FueraAVX2(x, baja, alta, potencias));
+        if (fuera != 0) {
+            return i + (size_t)__builtin_ctz(fuera);
+        }
+    }
+    return i + PrimerFueraEscalar(alfabeto, bytes + i, cantidad - i);
+}
+
+__attribute__((target("avx2")))
+static size_t PrimeraTernaInvalidaAVX2(const Alfabeto& alfabeto, const unsigned char* ternas,
+                                       size_t numTernas) {
+    const __m256i baja = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)alfabeto.fila(0)));
+    const __m256i alta = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)alfabeto.fila(1)));
+    const __m256i potencias = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+                                               1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+
+    size_t t = 0;
+    for (; t + 32 <= numTernas; t += 32) {
+        const unsigned char* p = ternas + 3 * t;
+        uint64_t bajos =
+            (uint64_t)(unsigned int)_mm256_movemask_epi8(FueraAVX2(_mm256_loadu_si256((const __m256i*)p), baja, alta, potencias))
+            | (uint64_t)(unsigned int)_mm256_movemask_epi8(FueraAVX2(_mm256_loadu_si256((const __m256i*)(p + 32)), baja, alta, potencias)) << 32;
+        uint64_t altos =
+            (uint64_t)(unsigned int)_mm256_movemask_epi8(FueraAVX2(_mm256_loadu_si256((const __m256i*)(p + 64)), baja, alta, potencias));
+        bajos &= CARACTERES_96_BAJOS;
+        altos &= CARACTERES_96_ALTOS;
+        if (bajos != 0) {
+            return t + (size_t)__builtin_ctzll(bajos) / 3;
+        }
+        if (altos != 0) {
+            return t + (64 + (size_t)__builtin_ctzll(altos)) / 3;
+        }
+    }
+    return t + PrimeraTernaInvalidaSSSE3(alfabeto, ternas + 3 * t, numTernas - t);
+}
+
+#endif // DESAFIO_X86_SIMD
+
+/**
+ * @brief Implementaciones de la validación elegidas para este procesador.
+ */
+struct ValidacionAlfabeto {
+    size_t (*primerFuera)(const Alfabeto&, const unsigned char*, size_t);
+    size_t (*primeraTernaInvalida)(const Alfabeto&, const unsigned char*, size_t);
+    const char* nombre;
+};
+
+static ValidacionAlfabeto ElegirValidacion() {
+#ifdef DESAFIO_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return ValidacionAlfabeto{ PrimerFueraAVX2, PrimeraTernaInvalidaAVX2, "AVX2" };
+    }
+    if (__builtin_cpu_supports("ssse3")) {
+        return ValidacionAlfabeto{ PrimerFueraSSSE3, PrimeraTernaInvalidaSSSE3, "SSSE3" };
+    }
+#endif
+    return ValidacionAlfabeto{ PrimerFueraEscalar, PrimeraTernaInvalidaEscalar, "escalar" };
+}
+
+/**
+ * @brief Implementación elegida, detectada una sola vez en el primer uso.
+ */
+static const ValidacionAlfabeto& ValidacionActual() {
+    static const ValidacionAlfabeto validacion = ElegirValidacion();
+    return validacion;
+}
+
+size_t Alfabeto::primerFuera(const unsigned char* bytes, size_t cantidad) const {
+    return ValidacionActual().primerFuera(*this, bytes, cantidad);
+}
+
+size_t Alfabeto::primeraTernaInvalida(const unsigned char* ternas, size_t numTernas) const {
+    return ValidacionActual().primeraTernaInvalida(*this, ternas, numTernas);
+}
+
+const char* ImplementacionAlfabeto() {
+    return ValidacionActual().nombre;
+}
+
+// ---------------------------------------------------------------------------
+// Alfabetos predefinidos y archivos
+// ---------------------------------------------------------------------------
+
+bool AlfabetoPredefinido(const char* nombre, Alfabeto& alfabeto) {
+    Alfabeto resultado;
+    resultado.agregarRango('a', 'z');
+    if (strcmp(nombre, "minusculas") == 0) {
+        alfabeto = resultado;
+        return true;
+    }
+
+    resultado.agregarRango('A', 'Z');
+    if (strcmp(nombre, "letras") == 0) {
+        alfabeto = resultado;
+        return true;
+    }
+
+    resultado.agregarRango('0', '9');
+    if (strcmp(nombre, "alfanumerico") == 0) {
+        alfabeto = resultado;
+        return true;
+    }
+
+    resultado.agregarRango(0x20, 0x7E);
+    resultado.agregar('\t');
+    resultado.agregar('\n');
+    resultado.agregar('\r');
+    if (strcmp(nombre, "texto") == 0) {
+        alfabeto = resultado;
+        return true;
+    }
+
+    // Bytes de continuación y primeros bytes válidos de secuencias de 2 a 4 bytes
+    resultado.agregarRango(0x80, 0xBF);
+    resultado.agregarRango(0xC2, 0xF4);
+    if (strcmp(nombre, "utf8") == 0) {
+        alfabeto = resultado;
+        return true;
+    }
+    return false;
+}
+
+static int ValorHexadecimal(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+/**
+ * @brief Lee un byte de una línea del archivo de alfabeto, interpretando los escapes.
+ *
+ * @return false si el escape `\xHH` está incompleto.
+ */
+static bool LeerByteAlfabeto(const string& linea, size_t& i, unsigned char& byte) {
+    char c = linea[i++];
+    if (c != '\\' || i >= linea.size()) {
+        byte = (unsigned char)c;
+        return true;
+    }
+
+    char escape = linea[i++];
+    switch (escape) {
+    case 'n': byte = '\n'; return true;
+    case 'r': byte = '\r'; return true;
+    case 't': byte = '\t'; return true;
+    case 'x': {
+        int alto = (i < linea.size()) ? ValorHexadecimal(linea[i]) : -1;
+        int bajo = (i + 1 < linea.size()) ? ValorHexadecimal(linea[i + 1]) : -1;
+        if (alto < 0 || bajo < 0) {
+            return false;
+        }
+        i += 2;
+        byte = (unsigned char)(alto * 16 + bajo);
+        return true;
+    }
+    default:
+        byte = (unsigned char)escape;  // "\\", "\-" y cualquier otro carácter escapado
+        return true;
+    }
+}
+
+bool LeerAlfabeto(const char* ruta, Alfabeto& alfabeto) {
+    ifstream archivo(ruta, ios::binary);
+    if (!archivo.is_open()) {
+        cout << "No se pudo abrir el alfabeto " << ruta << endl;
+        return false;
+    }
+
+    Alfabeto resultado;
+    string linea;
+    int numeroLinea = 0;
+    while (getline(archivo, linea)) {
+        numeroLinea++;
+        if (!linea.empty() && linea.back() == '\r') {
+            linea.pop_back();
+        }
+        if (!linea.empty() && linea[0] == '#') {
+            continue;
+        }
+
+        size_t i = 0;
+        while (i < linea.size()) {
+            unsigned char desde = 0;
+            bool valido = LeerByteAlfabeto(linea, i, desde);
+            unsigned char hasta = desde;
+            if (valido && i + 1 < linea.size() && linea[i] == '-') {
+                i++;
+                valido = LeerByteAlfabeto(linea, i, hasta) && desde <= hasta;
+            }
+            if (!valido) {
+                cout << ruta << ":" << numeroLinea << ": escape o rango invalido" << endl;
+                return false;
+            }
+            resultado.agregarRango(desde, hasta);
+        }
+    }
+
+    if (resultado.tamaño() == 0) {
+        cout << "El alfabeto " << ruta << " esta vacio" << endl;
+        return false;
+    }
+    alfabeto = resultado;
+    return true;
+}
+
+bool CargarAlfabeto(const char* especificacion, Alfabeto& alfabeto) {
+    return AlfabetoPredefinido(especificacion, alfabeto) || LeerAlfabeto(especificacion, alfabeto);
+}
+
+/**
+ * @brief Alfabeto compartido por todo el programa; empieza siendo 'a' a 'z'.
+ */
+static Alfabeto& AlfabetoGlobal() {
+    static Alfabeto alfabeto = [] {
+        Alfabeto minusculas;
+        minusculas.agregarRango('a', 'z');
+        return minusculas;
+    }();
+    return alfabeto;
+}
+
+const Alfabeto& AlfabetoActivo() {
+    return AlfabetoGlobal();
+}
+
+void ConfigurarAlfabeto(const Alfabeto& alfabeto) {
+    AlfabetoGlobal() = alfabeto;
+}
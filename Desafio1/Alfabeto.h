@@ -0,0 +1,90 @@
+#ifndef ALFABETO_H
+#define ALFABETO_H
+
+#include <cstddef>
+
+/**
+ * @brief Conjunto de bytes que los descompresores aceptan como carácter de una terna.
+ *
+ * Es un mapa de 256 bits guardado como dos tablas de 16 filas, indexadas por el nibble
+ * bajo del byte: el bit `h` de `filas[0][l]` indica si está el byte `h * 16 + l` (h de 0
+ * a 7) y `filas[1]` cubre los bytes 128 a 255. Con esa forma, `pshufb` consulta 16 o 32
+ * bytes a la vez (ver @ref primerFuera).
+ *
+ * Por defecto el alfabeto activo son las minúsculas 'a' a 'z', el formato original.
+ */
+class Alfabeto {
+public:
+    /** @brief Alfabeto vacío. */
+    Alfabeto();
+
+    void agregar(unsigned char c);
+    void agregarRango(unsigned char desde, unsigned char hasta);
+
+    bool contiene(unsigned char c) const {
+        return (filas[c >> 7][c & 15] >> ((c >> 4) & 7)) & 1;
+    }
+
+    /** @brief Cantidad de bytes del alfabeto. */
+    int tamaño() const;
+
+    /**
+     * @brief Posición del primer byte que no pertenece al alfabeto, o `cantidad` si todos pertenecen.
+     */
+    size_t primerFuera(const unsigned char* bytes, size_t cantidad) const;
+
+    /**
+     * @brief Primera terna cuyo carácter (tercer byte) no pertenece al alfabeto, o `numTernas`.
+     *
+     * @param ternas Ternas ya descifradas, una detrás de otra.
+     */
+    size_t primeraTernaInvalida(const unsigned char* ternas, size_t numTernas) const;
+
+    /** @brief Tablas por nibble bajo (ver la descripción de la clase). */
+    const unsigned char* fila(int mitad) const { return filas[mitad]; }
+
+private:
+    unsigned char filas[2][16];
+};
+
+/**
+ * @brief Arma un alfabeto predefinido: "minusculas" (a-z), "letras" (a-z, A-Z),
+ *        "alfanumerico" (letras y dígitos), "texto" (ASCII imprimible, tabulador y
+ *        saltos de línea) o "utf8" (texto más los bytes de secuencias UTF-8).
+ *
+ * @return false si el nombre no es uno de los predefinidos.
+ */
+bool AlfabetoPredefinido(const char* nombre, Alfabeto& alfabeto);
+
+/**
+ * @brief Lee un alfabeto de un archivo de texto.
+ *
+ * Cada línea agrega sus bytes; `x-y` agrega un rango y `\n`, `\r`, `\t`, `\\`, `\-`
+ * y `\xHH` escriben bytes que no se pueden poner directamente. Las líneas que empiezan
+ * con `#` son comentarios.
+ *
+ * @return false si no se pudo abrir el archivo o el alfabeto quedó vacío.
+ */
+bool LeerAlfabeto(const char* ruta, Alfabeto& alfabeto);
+
+/**
+ * @brief Alfabeto predefinido si `especificacion` es un nombre conocido; si no, lo lee del archivo.
+ */
+bool CargarAlfabeto(const char* especificacion, Alfabeto& alfabeto);
+
+/**
+ * @brief Alfabeto con el que validan los descompresores, filtros y compresores.
+ *
+ * Se cambia con @ref ConfigurarAlfabeto antes de empezar a buscar; durante la búsqueda
+ * los hilos solo lo leen.
+ */
+const Alfabeto& AlfabetoActivo();
+
+void ConfigurarAlfabeto(const Alfabeto& alfabeto);
+
+/**
+ * @brief Nombre de la implementación de @ref Alfabeto::primerFuera elegida ("AVX2", "SSSE3" o "escalar").
+ */
+const char* ImplementacionAlfabeto();
+
+#endif // ALFABETO_H
@@ -0,0 +1,173 @@
+#include <cstdio>
+#include <cstring>
+#include "ArchivoMapeado.h"
+#include "ManipulacionTexto.h"
+#include "Metricas.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define DESAFIO_POSIX 1
+#endif
+
+using namespace std;
+
+ArchivoMapeado::ArchivoMapeado() : buffer(nullptr), longitud(0), esMapeo(false), valido(false) {}
+
+ArchivoMapeado::ArchivoMapeado(const char* rutaArchivo) : ArchivoMapeado() {
+    abrir(rutaArchivo);
+}
+
+ArchivoMapeado::~ArchivoMapeado() {
+    cerrar();
+}
+
+ArchivoMapeado::ArchivoMapeado(ArchivoMapeado&& otro) noexcept
+    : buffer(otro.buffer), longitud(otro.longitud), esMapeo(otro.esMapeo), valido(otro.valido) {
+    otro.buffer = nullptr;
+    otro.longitud = 0;
+    otro.esMapeo = false;
+    otro.valido = false;
+}
+
+ArchivoMapeado& ArchivoMapeado::operator=(ArchivoMapeado&& otro) noexcept {
+    if (this != &otro) {
+        cerrar();
+        buffer = otro.buffer;
+        longitud = otro.longitud;
+        esMapeo = otro.esMapeo;
+        valido = otro.valido;
+        otro.buffer = nullptr;
+        otro.longitud = 0;
+        otro.esMapeo = false;
+        otro.valido = false;
+    }
+    return *this;
+}
+
+/**
+ * @brief Libera el mapeo o el buffer y deja el objeto vacío.
+ */
+void ArchivoMapeado::cerrar() {
+#ifdef DESAFIO_POSIX
+    if (esMapeo && buffer != nullptr) {
+        munmap(const_cast<unsigned char*>(buffer), longitud);
+        buffer = nullptr;
+    }
+#endif
+    delete[] buffer;
+    buffer = nullptr;
+    longitud = 0;
+    esMapeo = false;
+    valido = false;
+}
+
+#ifdef DESAFIO_POSIX
+
+/**
+ * @brief Lee un descriptor hasta el final en un buffer dinámico (tuberías, stdin, etc.).
+ */
+bool ArchivoMapeado::leerDescriptor(int fd) {
+    size_t capacidad = 1 << 16;
+    unsigned char* datos = new unsigned char[capacidad];
+    size_t usado = 0;
+
+    while (true) {
+        if (usado == capacidad) {
+            unsigned char* nuevo = new unsigned char[capacidad * 2];
+            memcpy(nuevo, datos, usado);
+            delete[] datos;
+            datos = nuevo;
+            capacidad *= 2;
+        }
+        ssize_t leidos = read(fd, datos + usado, capacidad - usado);
+        if (leidos < 0) {
+            delete[] datos;
+            return false;
+        }
+        if (leidos == 0) {
+            break;
+        }
+        usado += (size_t)leidos;
+    }
+
+    buffer = datos;
+    longitud = usado;
+    esMapeo = false;
+    return true;
+}
+
+#endif // DESAFIO_POSIX
+
+/**
+ * @brief Abre un archivo para lectura sin copiarlo cuando es posible.
+ *
+ * Los archivos regulares se mapean en memoria de solo lectura con `mmap` y se avisa
+ * al sistema que se leerán en orden y completos (`MADV_SEQUENTIAL`, `MADV_WILLNEED`).
+ * Las tuberías, `stdin` (ruta "-") y los sistemas sin `mmap` se leen a un buffer.
+ *
+ * @param rutaArchivo Ruta del archivo, o "-" para la entrada estándar.
+ * @return true si el contenido quedó disponible, false en caso de error.
+ */
+bool ArchivoMapeado::abrir(const char* rutaArchivo) {
+    MedidorEtapa medidor(ETAPA_LECTURA);
+    cerrar();
+    if (rutaArchivo == nullptr) {
+        return false;
+    }
+
+#ifdef DESAFIO_POSIX
+    if (strcmp(rutaArchivo, "-") == 0) {
+        valido = leerDescriptor(STDIN_FILENO);
+        return valido;
+    }
+
+    int fd = open(rutaArchivo, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        return false;
+    }
+
+    if (!S_ISREG(info.st_mode)) {
+        valido = leerDescriptor(fd);
+        close(fd);
+        return valido;
+    }
+
+    longitud = (size_t)info.st_size;
+    if (longitud == 0) {
+        close(fd);
+        valido = true;  // Archivo vacío: no hay nada que mapear
+        return true;
+    }
+
+    void* mapeo = mmap(nullptr, longitud, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // El mapeo sigue siendo válido después de cerrar el descriptor
+    if (mapeo == MAP_FAILED) {
+        longitud = 0;
+        return false;
+    }
+
+    madvise(mapeo, longitud, MADV_SEQUENTIAL);
+    madvise(mapeo, longitud, MADV_WILLNEED);
+
+    buffer = static_cast<const unsigned char*>(mapeo);
+    esMapeo = true;
+    valido = true;
+    return true;
+#else
+    // Sin mmap: lectura completa con la función de siempre
+    int size = 0;
+    buffer = leerArchivoACharArray(rutaArchivo, size);
+    longitud = (buffer != nullptr) ? (size_t)size : 0;
+    valido = (buffer != nullptr);
+    return valido;
+#endif
+}
@@ -0,0 +1,44 @@
+#ifndef ARCHIVOMAPEADO_H
+#define ARCHIVOMAPEADO_H
+
+#include <cstddef>
+
+/**
+ * @brief Archivo de solo lectura expuesto como un bloque de bytes, sin copias.
+ *
+ * En sistemas POSIX los archivos regulares se mapean en memoria (`mmap`), de modo
+ * que la búsqueda trabaja directamente sobre las páginas del archivo. Las tuberías
+ * y la entrada estándar (ruta "-") se leen a un buffer propio. El contenido se
+ * libera al destruir el objeto.
+ */
+class ArchivoMapeado {
+public:
+    ArchivoMapeado();
+    explicit ArchivoMapeado(const char* rutaArchivo);
+    ~ArchivoMapeado();
+
+    ArchivoMapeado(const ArchivoMapeado&) = delete;
+    ArchivoMapeado& operator=(const ArchivoMapeado&) = delete;
+    ArchivoMapeado(ArchivoMapeado&& otro) noexcept;
+    ArchivoMapeado& operator=(ArchivoMapeado&& otro) noexcept;
+
+    bool abrir(const char* rutaArchivo);
+    void cerrar();
+
+    /** @brief true si el archivo se pudo leer (un archivo vacío también es válido). */
+    bool abierto() const { return valido; }
+    const unsigned char* datos() const { return buffer; }
+    size_t size() const { return longitud; }
+    /** @brief true si el contenido es un mapeo del archivo y no una copia. */
+    bool mapeado() const { return esMapeo; }
+
+private:
+    bool leerDescriptor(int fd);
+
+    const unsigned char* buffer;
+    size_t longitud;
+    bool esMapeo;
+    bool valido;
+};
+
+#endif // ARCHIVOMAPEADO_H
@@ -0,0 +1,447 @@
+
+/**
+ * @file Benchmark.cpp
+ * @brief Mediciones de rendimiento y generador del corpus sintético.
+ *
+ * Uso:
+ * - `Benchmark generar DIRECTORIO N [opciones]`: crea `EncriptadoN.txt` y `pistaN.txt`.
+ *   Opciones: `--formato rle|lz78`, `--tamano 64M` (sufijos K, M y G), `--alfabeto abc`,
+ *   `--repeticion 0.5`, `--clave 77`, `--bits 3`, `--semilla 1`, `--pista 12`, `--texto`,
+ *   `--cifrado xor-rotr` (con clave de varios bytes separados por comas, p. ej. `--clave 77,12`),
+ *   `--caracteres minusculas|letras|alfanumerico|texto|utf8|ARCHIVO` (los que acepta `--alfabeto`).
+ * - `Benchmark medir DIRECTORIO | ENCRIPTADO PISTA [opciones]`: mide cada etapa y escribe
+ *   una línea JSON por medición en la salida estándar (búsqueda, descompresores, búsqueda
+ *   de la pista y compresores).
+ *   Opciones: `--repeticiones R`, `--hilos N`, `--clave K --bits B` (omite la búsqueda),
+ *   `--caracteres` (alfabeto de validación, como en `generar`).
+ *
+ * Las asignaciones se cuentan reemplazando `operator new` en este ejecutable.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <sys/stat.h>
+#include <vector>
+#include "Benchmark.h"
+#include "Alfabeto.h"
+#include "ArchivoMapeado.h"
+#include "BuscadorPista.h"
+#include "BusquedaParametros.h"
+#include "CompresionDescompresion.h"
+#include "ConjuntoPistas.h"
+#include "ContextoDescompresion.h"
+#include "EsquemasCifrado.h"
+#include "Metricas.h"
+#include "ProcesamientoLotes.h"
+#include "Sumideros.h"
+using namespace std;
+
+// ---------------------------------------------------------------------------
+// Conteo de asignaciones
+// ---------------------------------------------------------------------------
+
+static atomic<uint64_t> asignaciones(0);
+static atomic<uint64_t> bytesAsignados(0);
+
+void* operator new(size_t cantidad) {
+    asignaciones.fetch_add(1, memory_order_relaxed);
+    bytesAsignados.fetch_add(cantidad, memory_order_relaxed);
+    void* memoria = malloc(cantidad > 0 ? cantidad : 1);
+    if (memoria == nullptr) {
+        throw bad_alloc();
+    }
+    return memoria;
+}
+
+void operator delete(void* memoria) noexcept {
+    free(memoria);
+}
+
+void operator delete(void* memoria, size_t) noexcept {
+    free(memoria);
+}
+
+// ---------------------------------------------------------------------------
+// Mediciones
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Resultado agregado de varias repeticiones de una misma medición.
+ */
+struct Medicion {
+    string prueba;
+    string archivo;
+    uint64_t bytesEntrada = 0;
+    uint64_t bytesSalida = 0;
+    int candidatos = 0;
+    int repeticiones = 0;
+    double mejorSegundos = 0.0;
+    double promedioSegundos = 0.0;
+    uint64_t asignaciones = 0;      // Por repetición
+    uint64_t bytesAsignados = 0;    // Por repetición
+    bool valido = false;
+};
+
+/**
+ * @brief Ejecuta `funcion` varias veces y registra el mejor tiempo y el promedio.
+ *
+ * La salida de consola de la función medida se descarta. `funcion` retorna si la
+ * operación fue válida y deja en `salida` los bytes producidos.
+ */
+template <typename Funcion>
+static Medicion Medir(const string& prueba, const string& archivo, uint64_t bytesEntrada,
+                      int repeticiones, Funcion funcion) {
+    Medicion medicion;
+    medicion.prueba = prueba;
+    medicion.archivo = archivo;
+    medicion.bytesEntrada = bytesEntrada;
+    medicion.repeticiones = repeticiones;
+
+    streambuf* consola = cout.rdbuf();
+    ostringstream descartada;
+    double suma = 0.0;
+    for (int r = 0; r < repeticiones; r++) {
+        uint64_t asignacionesAntes = asignaciones.load();
+        uint64_t bytesAntes = bytesAsignados.load();
+        cout.rdbuf(descartada.rdbuf());
+
+        auto inicio = chrono::steady_clock::now();
+        uint64_t salida = 0;
+        medicion.valido = funcion(salida);
+        double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+
+        cout.rdbuf(consola);
+        descartada.str(string());
+        medicion.bytesSalida = salida;
+        medicion.asignaciones = asignaciones.load() - asignacionesAntes;
+        medicion.bytesAsignados = bytesAsignados.load() - bytesAntes;
+        suma += segundos;
+        if (r == 0 || segundos < medicion.mejorSegundos) {
+            medicion.mejorSegundos = segundos;
+        }
+    }
+    medicion.promedioSegundos = suma / repeticiones;
+    return medicion;
+}
+
+/**
+ * @brief Escribe la medición como una línea JSON.
+ */
+static void Informar(const Medicion& m) {
+    double mbs = (m.mejorSegundos > 0.0) ? (double)m.bytesEntrada / 1e6 / m.mejorSegundos : 0.0;
+    double candidatosSeg = (m.mejorSegundos > 0.0) ? m.candidatos / m.mejorSegundos : 0.0;
+
+    string archivo;
+    for (char c : m.archivo) {
+        if (c == '"' || c == '\\') {
+            archivo.push_back('\\');
+        }
+        archivo.push_back(c);
+    }
+
+    cout << "{\"prueba\":\"" << m.prueba << "\",\"archivo\":\"" << archivo << "\""
+         << ",\"valido\":" << (m.valido ? "true" : "false")
+         << ",\"bytes_entrada\":" << m.bytesEntrada << ",\"bytes_salida\":" << m.bytesSalida
+         << ",\"repeticiones\":" << m.repeticiones
+         << ",\"mejor_s\":" << m.mejorSegundos << ",\"promedio_s\":" << m.promedioSegundos
+         << ",\"mb_s\":" << mbs
+         << ",\"candidatos\":" << m.candidatos << ",\"candidatos_s\":" << candidatosSeg
+         << ",\"asignaciones\":" << m.asignaciones << ",\"bytes_asignados\":" << m.bytesAsignados
+         << "}" << endl;
+}
+
+/**
+ * @brief Mide todas las etapas sobre un par encriptado/pista.
+ *
+ * @param clave Clave conocida, o -1 para obtenerla midiendo @ref BuscarParametros.
+ */
+static bool MedirArchivo(const string& rutaEncriptado, const string& rutaPista, int repeticiones,
+                         int numHilos, int clave, int bits) {
+    ArchivoMapeado enc(rutaEncriptado.c_str());
+    ArchivoMapeado pistaArchivo(rutaPista.c_str());
+    // Tambien se miden las funciones originales (descompresionRLE, buscarSecuencia), que usan int
+    if (!enc.abierto() || !pistaArchivo.abierto() || enc.size() == 0 || pistaArchivo.size() == 0
+        || enc.size() > (size_t)INT_MAX || pistaArchivo.size() > (size_t)INT_MAX) {
+        cerr << "No se pudieron leer " << rutaEncriptado << " y " << rutaPista << endl;
+        return false;
+    }
+
+    const unsigned char* data = enc.datos();
+    int size = (int)enc.size();
+    const unsigned char* pista = pistaArchivo.datos();
+    int sizePista = (int)pistaArchivo.size();
+
+    if (clave < 0) {
+        int nbits = 0;
+        int claveK = 0;
+        Medicion busqueda = Medir("BuscarParametros", rutaEncriptado, (uint64_t)size, repeticiones,
+                                  [&](uint64_t&) {
+            return BuscarParametros(data, nbits, claveK, size, sizePista, pista, nullptr, numHilos);
+        });
+        if (busqueda.valido) {
+            busqueda.candidatos = claveK * 8 + nbits + 1;  // Candidatos hasta el ganador, en orden
+        }
+        Informar(busqueda);
+        if (!busqueda.valido) {
+            return false;
+        }
+        clave = claveK;
+        bits = nbits;
+    }
+
+    BuscadorPista buscador(pista, (size_t)sizePista);
+    int metodo = VerificarCandidato(data, size, buscador, (unsigned char)clave, bits);
+    if (metodo == METODO_NINGUNO) {
+        cerr << rutaEncriptado << ": la pista no aparece con clave " << clave << " y " << bits << " bits" << endl;
+        return false;
+    }
+
+    Informar(Medir("ProbarDescompresion", rutaEncriptado, (uint64_t)size, repeticiones, [&](uint64_t&) {
+        return ProbarDescompresion(data, size, pista, sizePista, (unsigned char)clave, bits, nullptr);
+    }));
+
+    Informar(Medir("VerificarCandidato", rutaEncriptado, (uint64_t)size, repeticiones, [&](uint64_t&) {
+        return VerificarCandidato(data, size, buscador, (unsigned char)clave, bits) != METODO_NINGUNO;
+    }));
+
+    // Lo mismo reutilizando la memoria de trabajo entre repeticiones, como hace la búsqueda
+    ContextoDescompresion contexto;
+    Informar(Medir("VerificarCandidatoContexto", rutaEncriptado, (uint64_t)size, repeticiones, [&](uint64_t&) {
+        return VerificarCandidato(data, size, buscador, (unsigned char)clave, bits, METODOS_TODOS,
+                                  &contexto) != METODO_NINGUNO;
+    }));
+
+    // Varias pistas en un solo autómata: la pista y sus dos mitades, exigiendo todas
+    ConjuntoPistas conjunto;
+    conjunto.agregar(pista, (size_t)sizePista);
+    conjunto.agregar(pista, (size_t)(sizePista + 1) / 2);
+    conjunto.agregar(pista + sizePista / 2, (size_t)(sizePista - sizePista / 2));
+    conjunto.preparar(PISTAS_TODAS);
+    Informar(Medir("VerificarCandidatoPistas", rutaEncriptado, (uint64_t)size, repeticiones, [&](uint64_t&) {
+        return VerificarCandidato(data, size, conjunto, (unsigned char)clave, bits, METODOS_TODOS,
+                                  &contexto) != METODO_NINGUNO;
+    }));
+
+    // Descompresores: la versión de dos pasadas y la de flujo hacia un sumidero que solo cuenta
+    bool esRLE = (metodo == METODO_RLE);
+    Informar(Medir(esRLE ? "descompresionRLE" : "descompresionLZ78", rutaEncriptado, (uint64_t)size,
+                   repeticiones, [&](uint64_t& salida) {
+        int total = 0;
+        bool esValido = false;
+        unsigned char* texto = esRLE
+            ? descompresionRLE(const_cast<unsigned char*>(data), size, (unsigned char)clave, bits, total, esValido)
+            : descompresionLZ78(const_cast<unsigned char*>(data), size, (unsigned char)clave, bits, total, esValido);
+        delete[] texto;
+        salida = (uint64_t)total;
+        return esValido;
+    }));
+
+    Informar(Medir(esRLE ? "descompresionRLEFlujo" : "descompresionLZ78Flujo", rutaEncriptado,
+                   (uint64_t)size, repeticiones, [&](uint64_t& salida) {
+        SumideroFuncion contador([](const unsigned char*, size_t) { return true; });
+        size_t total = 0;
+        bool esValido = esRLE
+            ? descompresionRLEFlujo(data, (size_t)size, (unsigned char)clave, bits, contador, total)
+            : descompresionLZ78Flujo(data, (size_t)size, (unsigned char)clave, bits, contador, total);
+        salida = total;
+        return esValido;
+    }));
+
+    // El texto completo en memoria, como al guardar el ganador: en serie y repartido entre los hilos
+    if (!esRLE) {
+        ClaveCifrado cifrado((unsigned char)clave, bits);
+        const int hilosPrueba[2] = { 1, numHilos };
+        for (int hilos : hilosPrueba) {
+            Informar(Medir((hilos == 1) ? "descompresionLZ78Memoria" : "descompresionLZ78Paralela", rutaEncriptado,
+                           (uint64_t)size, repeticiones, [&](uint64_t& salida) {
+                SumideroMemoria texto;
+                size_t total = 0;
+                bool esValido = descompresionLZ78Paralela(data, (size_t)size, cifrado, texto, total, hilos);
+                salida = total;
+                return esValido;
+            }));
+            if (numHilos == 1) {
+                break;
+            }
+        }
+    }
+
+    // buscarSecuencia sobre el texto ya descomprimido
+    size_t total = 0;
+    int metodoTexto = METODO_NINGUNO;
+    unsigned char* texto = DescomprimirConPista(data, size, buscador, (unsigned char)clave, bits, total, metodoTexto);
+    if (texto != nullptr) {
+        if (total <= (size_t)INT_MAX) {
+            Informar(Medir("buscarSecuencia", rutaEncriptado, (uint64_t)total, repeticiones, [&](uint64_t&) {
+                return buscarSecuencia(texto, (int)total, const_cast<unsigned char*>(pista), sizePista);
+            }));
+        }
+
+        // Compresión del mismo texto con los mismos parámetros
+        Informar(Medir(esRLE ? "compresionRLE" : "compresionLZ78", rutaEncriptado, (uint64_t)total,
+                       repeticiones, [&](uint64_t& salida) {
+            size_t comprimido = 0;
+            unsigned char* ternas = esRLE
+                ? compresionRLE(texto, (size_t)total, (unsigned char)clave, bits, comprimido)
+                : compresionLZ78(texto, (size_t)total, (unsigned char)clave, bits, comprimido);
+            delete[] ternas;
+            salida = comprimido;
+            return ternas != nullptr;
+        }));
+        delete[] texto;
+    }
+    return true;
+}
+
+/**
+ * @brief Interpreta tamaños como "4096", "64K", "10M" o "1G".
+ */
+static uint64_t LeerTamaño(const char* texto) {
+    char* fin = nullptr;
+    uint64_t valor = strtoull(texto, &fin, 10);
+    switch (*fin) {
+    case 'k': case 'K': return valor << 10;
+    case 'm': case 'M': return valor << 20;
+    case 'g': case 'G': return valor << 30;
+    default: return valor;
+    }
+}
+
+/**
+ * @brief Configura el alfabeto de validación a partir de `--caracteres`.
+ */
+static bool ConfigurarCaracteres(const char* especificacion) {
+    Alfabeto alfabeto;
+    if (!CargarAlfabeto(especificacion, alfabeto)) {
+        cerr << "Alfabetos predefinidos: minusculas, letras, alfanumerico, texto, utf8" << endl;
+        return false;
+    }
+    ConfigurarAlfabeto(alfabeto);
+    return true;
+}
+
+static int Generar(int argc, char* argv[]) {
+    if (argc < 4) {
+        cerr << "Uso: Benchmark generar DIRECTORIO N [opciones]" << endl;
+        return 1;
+    }
+    string directorio = argv[2];
+    int numero = atoi(argv[3]);
+    ParametrosCorpus parametros;
+    bool guardarTexto = false;
+
+    for (int i = 4; i < argc; i++) {
+        bool hayValor = (i + 1 < argc);
+        if (strcmp(argv[i], "--formato") == 0 && hayValor) {
+            parametros.metodo = (strcmp(argv[++i], "lz78") == 0) ? METODO_LZ78 : METODO_RLE;
+        } else if (strcmp(argv[i], "--tamano") == 0 && hayValor) {
+            parametros.tamaño = LeerTamaño(argv[++i]);
+        } else if (strcmp(argv[i], "--alfabeto") == 0 && hayValor) {
+            parametros.alfabeto = argv[++i];
+        } else if (strcmp(argv[i], "--repeticion") == 0 && hayValor) {
+            parametros.repeticion = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--clave") == 0 && hayValor) {
+            parametros.clave.clear();
+            for (const char* p = argv[++i]; *p != '\0';) {
+                char* fin = nullptr;
+                parametros.clave.push_back((int)strtol(p, &fin, 10));
+                p = (*fin == ',') ? fin + 1 : fin + strlen(fin);
+            }
+        } else if (strcmp(argv[i], "--cifrado") == 0 && hayValor) {
+            parametros.cifrado = argv[++i];
+        } else if (strcmp(argv[i], "--caracteres") == 0 && hayValor) {
+            if (!ConfigurarCaracteres(argv[++i])) {
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--bits") == 0 && hayValor) {
+            parametros.bits = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--semilla") == 0 && hayValor) {
+            parametros.semilla = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--pista") == 0 && hayValor) {
+            parametros.largoPista = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--texto") == 0) {
+            guardarTexto = true;
+        } else {
+            cerr << "Opcion desconocida: " << argv[i] << endl;
+            return 1;
+        }
+    }
+
+    bool claveValida = !parametros.clave.empty() && (int)parametros.clave.size() <= MAX_LONGITUD_CLAVE;
+    for (int byte : parametros.clave) {
+        claveValida = claveValida && byte >= 0 && byte <= 254;
+    }
+    if (!claveValida || parametros.bits < 0 || parametros.bits > 7) {
+        cerr << "Cada byte de la clave debe estar entre 0 y 254 y los bits entre 0 y 7" << endl;
+        return 1;
+    }
+    return GenerarCorpus(parametros, directorio, numero, guardarTexto) ? 0 : 1;
+}
+
+static int MedirComando(int argc, char* argv[]) {
+    vector<string> rutas;
+    int repeticiones = 3;
+    int numHilos = 1;
+    int clave = -1;
+    int bits = 0;
+
+    for (int i = 2; i < argc; i++) {
+        bool hayValor = (i + 1 < argc);
+        if (strcmp(argv[i], "--repeticiones") == 0 && hayValor) {
+            repeticiones = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--hilos") == 0 && hayValor) {
+            numHilos = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--clave") == 0 && hayValor) {
+            clave = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--bits") == 0 && hayValor) {
+            bits = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--caracteres") == 0 && hayValor) {
+            if (!ConfigurarCaracteres(argv[++i])) {
+                return 1;
+            }
+        } else {
+            rutas.push_back(argv[i]);
+        }
+    }
+    if (repeticiones < 1) {
+        repeticiones = 1;
+    }
+
+    vector<TrabajoArchivo> trabajos;
+    struct stat info;
+    if (rutas.size() == 1 && stat(rutas[0].c_str(), &info) == 0 && S_ISDIR(info.st_mode)) {
+        if (!DescubrirArchivos(rutas[0], trabajos)) {
+            return 1;
+        }
+    } else if (rutas.size() == 2) {
+        trabajos.push_back({ 1, rutas[0], rutas[1], string(), {} });
+    } else {
+        cerr << "Uso: Benchmark medir DIRECTORIO | ENCRIPTADO PISTA [opciones]" << endl;
+        return 1;
+    }
+
+    bool correcto = true;
+    for (const TrabajoArchivo& trabajo : trabajos) {
+        correcto = MedirArchivo(trabajo.rutaEncriptado, trabajo.rutaPista, repeticiones, numHilos, clave, bits)
+                   && correcto;
+    }
+    return correcto ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc >= 2 && strcmp(argv[1], "generar") == 0) {
+        return Generar(argc, argv);
+    }
+    if (argc >= 2 && strcmp(argv[1], "medir") == 0) {
+        return MedirComando(argc, argv);
+    }
+    cerr << "Uso: Benchmark generar DIRECTORIO N [opciones]" << endl;
+    cerr << "     Benchmark medir DIRECTORIO | ENCRIPTADO PISTA [opciones]" << endl;
+    return 1;
+}
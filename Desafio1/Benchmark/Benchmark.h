@@ -0,0 +1,41 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Metricas.h"
+
+/**
+ * @brief Parámetros de un archivo sintético del corpus de pruebas.
+ */
+struct ParametrosCorpus {
+    int metodo = METODO_RLE;                            // METODO_RLE o METODO_LZ78
+    uint64_t tamaño = 1 << 20;                          // Bytes del texto original
+    std::string alfabeto = "abcdefghijklmnopqrstuvwxyz"; // Solo caracteres del alfabeto activo
+    double repeticion = 0.5;                            // 0 = texto aleatorio, cerca de 1 = muy repetitivo
+    std::string cifrado = "xor-rotr";                   // Nombre del EsquemaCifrado
+    std::vector<int> clave = { 77 };                    // Bytes de la clave XOR (0-254), uno por byte del esquema
+    int bits = 3;                                       // Bits de rotación (0-7)
+    uint32_t semilla = 1;
+    int largoPista = 12;
+};
+
+/**
+ * @brief Genera `EncriptadoN.txt` y `pistaN.txt` (y opcionalmente `textoN.txt`) en un directorio.
+ *
+ * El texto se produce y comprime por bloques, así que el tamaño solo está limitado
+ * por el disco. Con `repeticion` se controla a la vez el largo de las corridas de un
+ * mismo carácter (lo que aprovecha RLE) y la frecuencia con que se copian frases
+ * ya vistas (lo que aprovecha LZ78). La pista es un fragmento del texto.
+ *
+ * @param parametros Formato, tamaño, alfabeto, repetitividad y cifrado.
+ * @param directorio Directorio de salida (debe existir).
+ * @param numero N de los nombres de archivo.
+ * @param guardarTexto Si es true también escribe el texto original en `textoN.txt`.
+ * @return true si los archivos se escribieron correctamente.
+ */
+bool GenerarCorpus(const ParametrosCorpus& parametros, const std::string& directorio, int numero,
+                   bool guardarTexto);
+
+#endif // BENCHMARK_H
@@ -0,0 +1,163 @@
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "Benchmark.h"
+#include "Alfabeto.h"
+#include "CompresionDescompresion.h"
+#include "EsquemasCifrado.h"
+#include "Metricas.h"
+#include "Sumideros.h"
+using namespace std;
+
+// Bytes de texto que se generan y comprimen por vuelta
+static const size_t TAMAÑO_BLOQUE_TEXTO = 1 << 20;
+
+/**
+ * @brief Produce texto sintético con corridas y frases repetidas.
+ */
+class GeneradorTexto {
+public:
+    GeneradorTexto(const ParametrosCorpus& parametros)
+        : azar(parametros.semilla), alfabeto(parametros.alfabeto), repeticion(parametros.repeticion) {
+        if (repeticion < 0.0) {
+            repeticion = 0.0;
+        } else if (repeticion > 0.99) {
+            repeticion = 0.99;
+        }
+    }
+
+    /**
+     * @brief Llena `destino` con `cantidad` bytes de texto.
+     *
+     * Con probabilidad `repeticion / 2` se copia una frase reciente del mismo bloque;
+     * en otro caso se elige un carácter del alfabeto y se repite mientras un sorteo
+     * con probabilidad `repeticion` lo permita.
+     */
+    void llenar(unsigned char* destino, size_t cantidad) {
+        uniform_real_distribution<double> uniforme(0.0, 1.0);
+        size_t i = 0;
+        while (i < cantidad) {
+            if (i >= 16 && uniforme(azar) < repeticion * 0.5) {
+                size_t distancia = 1 + azar() % (i < 4096 ? i : 4096);
+                size_t largo = 4 + azar() % 60;
+                for (size_t j = 0; j < largo && i < cantidad; j++, i++) {
+                    destino[i] = destino[i - distancia];
+                }
+                continue;
+            }
+
+            unsigned char caracter = (unsigned char)alfabeto[azar() % alfabeto.size()];
+            destino[i++] = caracter;
+            for (int corrida = 1; corrida < 64 && i < cantidad && uniforme(azar) < repeticion; corrida++) {
+                destino[i++] = caracter;
+            }
+        }
+    }
+
+private:
+    mt19937 azar;
+    const string& alfabeto;
+    double repeticion;
+};
+
+/**
+ * @brief Genera el texto por bloques y lo comprime y encripta con `Compresor` hacia `salida`.
+ *
+ * De paso copia en `pista` los bytes del texto que caen en [inicioPista, inicioPista + largoPista)
+ * y, si `texto` está abierto, guarda el texto original.
+ */
+template <typename Compresor>
+static bool ComprimirCorpus(const ParametrosCorpus& parametros, const ClaveCifrado& cifrado, Sumidero& salida,
+                            ofstream& texto, uint64_t inicioPista, uint64_t largoPista, string& pista) {
+    GeneradorTexto generador(parametros);
+    Compresor compresor(cifrado, salida);
+    vector<unsigned char> bloque(TAMAÑO_BLOQUE_TEXTO);
+
+    for (uint64_t hecho = 0; hecho < parametros.tamaño;) {
+        size_t cantidad = (size_t)min<uint64_t>(TAMAÑO_BLOQUE_TEXTO, parametros.tamaño - hecho);
+        generador.llenar(bloque.data(), cantidad);
+
+        for (uint64_t i = max(hecho, inicioPista); i < min(hecho + cantidad, inicioPista + largoPista); i++) {
+            pista.push_back((char)bloque[(size_t)(i - hecho)]);
+        }
+        if (!compresor.procesar(bloque.data(), cantidad)) {
+            return false;
+        }
+        if (texto.is_open()) {
+            texto.write(reinterpret_cast<const char*>(bloque.data()), (streamsize)cantidad);
+        }
+        hecho += cantidad;
+    }
+    return compresor.finalizar();
+}
+
+bool GenerarCorpus(const ParametrosCorpus& parametros, const string& directorio, int numero,
+                   bool guardarTexto) {
+    if (parametros.alfabeto.empty() || parametros.tamaño == 0) {
+        cout << "Error: alfabeto vacio o tamaño cero" << endl;
+        return false;
+    }
+    const Alfabeto& aceptados = AlfabetoActivo();
+    for (char c : parametros.alfabeto) {
+        if (!aceptados.contiene((unsigned char)c)) {
+            cout << "Error: el alfabeto solo puede tener caracteres aceptados por los descompresores" << endl;
+            return false;
+        }
+    }
+
+    const EsquemaCifrado* esquema = BuscarEsquemaCifrado(parametros.cifrado.c_str());
+    if (esquema == nullptr) {
+        cout << "Error: esquema de cifrado desconocido " << parametros.cifrado << endl;
+        return false;
+    }
+    if ((int)parametros.clave.size() != esquema->longitudClave) {
+        cout << "Error: el esquema " << esquema->nombre << " usa claves de " << esquema->longitudClave
+             << " bytes" << endl;
+        return false;
+    }
+    ParametrosCifrado claveCorpus = {};
+    for (int i = 0; i < esquema->longitudClave; i++) {
+        claveCorpus.clave[i] = (unsigned char)parametros.clave[i];
+    }
+    claveCorpus.longitudClave = esquema->longitudClave;
+    claveCorpus.bits = parametros.bits;
+    ClaveCifrado cifrado(*esquema, claveCorpus);
+
+    string sufijo = to_string(numero) + ".txt";
+    SumideroArchivo salida((directorio + "/Encriptado" + sufijo).c_str());
+    ofstream texto;
+    if (guardarTexto) {
+        texto.open(directorio + "/texto" + sufijo, ios::binary | ios::trunc);
+    }
+    if (!salida.abierto() || (guardarTexto && !texto.is_open())) {
+        cout << "Error: no se pudieron crear los archivos en " << directorio << endl;
+        return false;
+    }
+
+    // La pista se toma de una posición al azar del texto mientras se genera
+    uint64_t largoPista = (uint64_t)parametros.largoPista;
+    if (largoPista == 0 || largoPista > parametros.tamaño) {
+        largoPista = parametros.tamaño;
+    }
+    mt19937_64 azarPista(parametros.semilla ^ 0x9E3779B97F4A7C15ULL);
+    uint64_t inicioPista = azarPista() % (parametros.tamaño - largoPista + 1);
+    string pista;
+
+    bool comprimido = (parametros.metodo == METODO_LZ78)
+        ? ComprimirCorpus<CompresorLZ78>(parametros, cifrado, salida, texto, inicioPista, largoPista, pista)
+        : ComprimirCorpus<CompresorRLE>(parametros, cifrado, salida, texto, inicioPista, largoPista, pista);
+    if (!comprimido) {
+        cout << "Error al comprimir o escribir " << directorio << "/Encriptado" << sufijo << endl;
+        return false;
+    }
+
+    ofstream archivoPista(directorio + "/pista" + sufijo, ios::binary | ios::trunc);
+    archivoPista.write(pista.data(), (streamsize)pista.size());
+    archivoPista.close();
+    if (guardarTexto) {
+        texto.close();
+    }
+    return !archivoPista.fail() && !(guardarTexto && texto.fail());
+}
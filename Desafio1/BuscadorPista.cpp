@@ -0,0 +1,320 @@
+#include <cstring>
+#include "BuscadorPista.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define DESAFIO_X86_SIMD 1
+#endif
+
+using namespace std;
+
+/**
+ * @brief Prepara el buscador: tablas de salto y factorización crítica de la pista.
+ *
+ * La factorización (posición `critica` y período `periodo`) es la del algoritmo
+ * Two-Way de Crochemore y Perrin: se toma el mayor de los dos sufijos máximos
+ * (con el orden normal y con el inverso) de la pista.
+ *
+ * @param pista Secuencia a buscar (se copia internamente).
+ * @param sizePista Tamaño de la pista.
+ */
+BuscadorPista::BuscadorPista(const unsigned char* pista, size_t sizePista)
+    : patron(pista, pista + sizePista), automataPista(pista, sizePista), critica(0), periodo(1),
+      memoriaPeriodica(0), filtroSIMD(FILTRO_NINGUNO) {
+    size_t m = patron.size();
+    const unsigned char* n = patron.data();
+
+    memset(presente, 0, sizeof(presente));
+    memset(salto, 0, sizeof(salto));
+    for (size_t i = 0; i < m; i++) {
+        presente[n[i]] = true;
+        salto[n[i]] = i + 1;  // Última aparición de cada byte (tabla de Horspool)
+    }
+
+    if (m == 0) {
+        return;
+    }
+
+    // Sufijo máximo con el orden normal
+    size_t ip = (size_t)-1, jp = 0, k = 1, p = 1;
+    while (jp + k < m) {
+        if (n[ip + k] == n[jp + k]) {
+            if (k == p) {
+                jp += p;
+                k = 1;
+            } else {
+                k++;
+            }
+        } else if (n[ip + k] > n[jp + k]) {
+            jp += k;
+            k = 1;
+            p = jp - ip;
+        } else {
+            ip = jp++;
+            k = p = 1;
+        }
+    }
+    size_t ms = ip;
+    size_t p0 = p;
+
+    // Sufijo máximo con el orden inverso
+    ip = (size_t)-1;
+    jp = 0;
+    k = p = 1;
+    while (jp + k < m) {
+        if (n[ip + k] == n[jp + k]) {
+            if (k == p) {
+                jp += p;
+                k = 1;
+            } else {
+                k++;
+            }
+        } else if (n[ip + k] < n[jp + k]) {
+            jp += k;
+            k = 1;
+            p = jp - ip;
+        } else {
+            ip = jp++;
+            k = p = 1;
+        }
+    }
+    if (ip + 1 > ms + 1) {
+        ms = ip;
+    } else {
+        p = p0;
+    }
+
+    // Si la pista no es periódica, el salto tras una falla en la mitad izquierda es fijo
+    if (memcmp(n, n + p, ms + 1) != 0) {
+        memoriaPeriodica = 0;
+        p = ((ms > m - ms - 1) ? ms : m - ms - 1) + 1;
+    } else {
+        memoriaPeriodica = m - p;
+    }
+    critica = ms;
+    periodo = p;
+
+#ifdef DESAFIO_X86_SIMD
+    // Filtro de primer y último byte para pistas cortas
+    if (m >= 2 && m <= MAX_PISTA_FILTRO) {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            filtroSIMD = FILTRO_AVX2;
+        } else if (__builtin_cpu_supports("sse2")) {
+            filtroSIMD = FILTRO_SSE2;
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Búsqueda Two-Way con salto de Horspool por el último byte. Tiempo lineal en el peor caso.
+ */
+size_t BuscadorPista::buscarDosVias(const unsigned char* texto, size_t sizeTexto) const {
+    const unsigned char* n = patron.data();
+    size_t m = patron.size();
+    size_t ms = critica;
+    size_t p = periodo;
+    size_t mem = 0;
+
+    size_t pos = 0;
+    while (sizeTexto - pos >= m) {
+        const unsigned char* h = texto + pos;
+
+        // Mirar primero el último byte de la ventana
+        unsigned char ultimo = h[m - 1];
+        if (!presente[ultimo]) {
+            pos += m;
+            mem = 0;
+            continue;
+        }
+        size_t k = m - salto[ultimo];
+        if (k) {
+            if (k < mem) {
+                k = mem;
+            }
+            pos += k;
+            mem = 0;
+            continue;
+        }
+
+        // Comparar la mitad derecha
+        for (k = (ms + 1 > mem) ? ms + 1 : mem; k < m && n[k] == h[k]; k++) {
+        }
+        if (k < m) {
+            pos += k - ms;
+            mem = 0;
+            continue;
+        }
+
+        // Comparar la mitad izquierda
+        for (k = ms + 1; k > mem && n[k - 1] == h[k - 1]; k--) {
+        }
+        if (k <= mem) {
+            return pos;
+        }
+        pos += p;
+        mem = memoriaPeriodica;
+    }
+    return NO_ENCONTRADO;
+}
+
+#ifdef DESAFIO_X86_SIMD
+
+/*
+ * Filtro vectorial: se compara a la vez el primer byte de la pista con las
+ * posiciones i..i+15 (o 31) y el último byte con i+m-1..; solo las posiciones
+ * donde coinciden ambos se verifican con memcmp.
+ */
+
+__attribute__((target("sse2")))
+static size_t BuscarFiltroSSE2(const unsigned char* texto, size_t sizeTexto,
+                               const unsigned char* pista, size_t m) {
+    const __m128i primero = _mm_set1_epi8((char)pista[0]);
+    const __m128i ultimo = _mm_set1_epi8((char)pista[m - 1]);
+
+    size_t i = 0;
+    for (; i + m - 1 + 16 <= sizeTexto; i += 16) {
+        __m128i bloqueInicio = _mm_loadu_si128((const __m128i*)(texto + i));
+        __m128i bloqueFin = _mm_loadu_si128((const __m128i*)(texto + i + m - 1));
+        unsigned int mascara = (unsigned int)_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(bloqueInicio, primero), _mm_cmpeq_epi8(bloqueFin, ultimo)));
+        while (mascara != 0) {
+            unsigned int bit = (unsigned int)__builtin_ctz(mascara);
+            if (memcmp(texto + i + bit + 1, pista + 1, m - 2) == 0) {
+                return i + bit;
+            }
+            mascara &= mascara - 1;
+        }
+    }
+    for (; i + m <= sizeTexto; i++) {
+        if (texto[i] == pista[0] && memcmp(texto + i, pista, m) == 0) {
+            return i;
+        }
+    }
+    return BuscadorPista::NO_ENCONTRADO;
+}
+
+__attribute__((target("avx2")))
+static size_t BuscarFiltroAVX2(const unsigned char* texto, size_t sizeTexto,
+                               const unsigned char* pista, size_t m) {
+    const __m256i primero = _mm256_set1_epi8((char)pista[0]);
+    const __m256i ultimo = _mm256_set1_epi8((char)pista[m - 1]);
+
+    size_t i = 0;
+    for (; i + m - 1 + 32 <= sizeTexto; i += 32) {
+        __m256i bloqueInicio = _mm256_loadu_si256((const __m256i*)(texto + i));
+        __m256i bloqueFin = _mm256_loadu_si256((const __m256i*)(texto + i + m - 1));
+        unsigned int mascara = (unsigned int)_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(bloqueInicio, primero), _mm256_cmpeq_epi8(bloqueFin, ultimo)));
+        while (mascara != 0) {
+            unsigned int bit = (unsigned int)__builtin_ctz(mascara);
+            if (memcmp(texto + i + bit + 1, pista + 1, m - 2) == 0) {
+                return i + bit;
+            }
+            mascara &= mascara - 1;
+        }
+    }
+    for (; i + m <= sizeTexto; i++) {
+        if (texto[i] == pista[0] && memcmp(texto + i, pista, m) == 0) {
+            return i;
+        }
+    }
+    return BuscadorPista::NO_ENCONTRADO;
+}
+
+#endif // DESAFIO_X86_SIMD
+
+/**
+ * @brief Retorna la posición de la primera aparición de la pista en el texto.
+ *
+ * @return Posición encontrada o @ref NO_ENCONTRADO.
+ */
+size_t BuscadorPista::buscar(const unsigned char* texto, size_t sizeTexto) const {
+    size_t m = patron.size();
+    if (texto == nullptr || m == 0 || sizeTexto < m) {
+        return NO_ENCONTRADO;
+    }
+
+    if (m == 1) {
+        const void* encontrado = memchr(texto, patron[0], sizeTexto);
+        return encontrado ? (size_t)((const unsigned char*)encontrado - texto) : NO_ENCONTRADO;
+    }
+
+#ifdef DESAFIO_X86_SIMD
+    if (filtroSIMD == FILTRO_AVX2) {
+        return BuscarFiltroAVX2(texto, sizeTexto, patron.data(), m);
+    }
+    if (filtroSIMD == FILTRO_SSE2) {
+        return BuscarFiltroSSE2(texto, sizeTexto, patron.data(), m);
+    }
+#endif
+    return buscarDosVias(texto, sizeTexto);
+}
+
+/**
+ * @brief Indica si la pista aparece en el texto.
+ */
+bool BuscadorPista::contenidaEn(const unsigned char* texto, size_t sizeTexto) const {
+    return buscar(texto, sizeTexto) != NO_ENCONTRADO;
+}
+
+// ---------------------------------------------------------------------------
+// AutomataPista
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Construye el autómata KMP de la pista.
+ *
+ * Para pistas de hasta MAX_ESTADOS_DFA bytes se arma la tabla completa de
+ * transiciones (un acceso por byte). Para pistas más largas se usa la función de
+ * fallo de KMP, que ocupa memoria lineal y tiene costo amortizado constante.
+ */
+AutomataPista::AutomataPista(const unsigned char* pista, size_t sizePista)
+    : patron(pista, pista + sizePista) {
+    size_t m = patron.size();
+    if (m == 0) {
+        return;
+    }
+
+    // Función de fallo: mayor borde propio de cada prefijo
+    fallo.assign(m, 0);
+    for (size_t i = 1, k = 0; i < m; i++) {
+        while (k > 0 && patron[i] != patron[k]) {
+            k = fallo[k - 1];
+        }
+        if (patron[i] == patron[k]) {
+            k++;
+        }
+        fallo[i] = (unsigned int)k;
+    }
+
+    if (m > MAX_ESTADOS_DFA) {
+        return;
+    }
+
+    // Tabla completa: el estado j recuerda cuántos bytes de la pista coinciden
+    transiciones.assign(m * 256, 0);
+    transiciones[patron[0]] = 1;
+    unsigned int respaldo = 0;
+    for (size_t j = 1; j < m; j++) {
+        for (int c = 0; c < 256; c++) {
+            transiciones[j * 256 + c] = transiciones[respaldo * 256 + c];
+        }
+        transiciones[j * 256 + patron[j]] = (unsigned int)(j + 1);
+        respaldo = transiciones[respaldo * 256 + patron[j]];
+    }
+}
+
+/**
+ * @brief Estado siguiente tras leer el byte `c`. No debe llamarse desde el estado aceptado.
+ */
+unsigned int AutomataPista::avanzar(unsigned int estado, unsigned char c) const {
+    if (!transiciones.empty()) {
+        return transiciones[estado * 256 + c];
+    }
+    while (estado > 0 && patron[estado] != c) {
+        estado = fallo[estado - 1];
+    }
+    return (patron[estado] == c) ? estado + 1 : 0;
+}
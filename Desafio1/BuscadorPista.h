@@ -0,0 +1,78 @@
+#ifndef BUSCADORPISTA_H
+#define BUSCADORPISTA_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Autómata KMP de una pista, para buscarla byte a byte mientras se descomprime.
+ *
+ * El estado es la cantidad de bytes de la pista que coinciden con el final de lo leído;
+ * la pista aparece al llegar al estado `size()`. Es de solo lectura una vez construido,
+ * así que puede compartirse entre hilos (cada uno guarda su propio estado).
+ */
+class AutomataPista {
+public:
+    AutomataPista(const unsigned char* pista, size_t sizePista);
+
+    /** @brief Estado siguiente tras leer `c` (no llamar desde el estado aceptado). */
+    unsigned int avanzar(unsigned int estado, unsigned char c) const;
+    /** @brief Indica si el estado corresponde a la pista completa. */
+    bool aceptado(unsigned int estado) const { return estado == patron.size(); }
+    /** @brief Tamaño de la pista. */
+    size_t size() const { return patron.size(); }
+
+private:
+    static const size_t MAX_ESTADOS_DFA = 1024;
+
+    std::vector<unsigned char> patron;
+    std::vector<unsigned int> fallo;
+    std::vector<unsigned int> transiciones;
+};
+
+/**
+ * @brief Buscador de una pista fija, preprocesado una vez y reutilizable en muchos textos.
+ *
+ * Para pistas de 2 a 32 bytes usa un filtro vectorial (AVX2 o SSE2) que compara a la vez
+ * el primer y el último byte de la pista en 32 o 16 posiciones, y verifica con `memcmp`
+ * solo las posiciones que pasan el filtro. Para pistas más largas usa el algoritmo Two-Way
+ * con salto de Horspool por el último byte, que es lineal en el peor caso (por ejemplo en
+ * textos repetitivos como "aaaa..."). Los métodos de búsqueda son `const`, así que un mismo
+ * buscador puede compartirse entre hilos.
+ */
+class BuscadorPista {
+public:
+    /** @brief Valor que retorna `buscar` cuando la pista no aparece. */
+    static const size_t NO_ENCONTRADO = (size_t)-1;
+
+    BuscadorPista(const unsigned char* pista, size_t sizePista);
+
+    /** @brief Posición de la primera aparición de la pista, o @ref NO_ENCONTRADO. */
+    size_t buscar(const unsigned char* texto, size_t sizeTexto) const;
+    /** @brief Indica si la pista aparece en el texto. */
+    bool contenidaEn(const unsigned char* texto, size_t sizeTexto) const;
+
+    /** @brief Bytes de la pista. */
+    const unsigned char* datos() const { return patron.data(); }
+    /** @brief Tamaño de la pista. */
+    size_t size() const { return patron.size(); }
+    /** @brief Autómata de la misma pista, para buscarla durante la descompresión. */
+    const AutomataPista& automata() const { return automataPista; }
+
+private:
+    static const size_t MAX_PISTA_FILTRO = 32;
+    enum Filtro { FILTRO_NINGUNO, FILTRO_SSE2, FILTRO_AVX2 };
+
+    size_t buscarDosVias(const unsigned char* texto, size_t sizeTexto) const;
+
+    std::vector<unsigned char> patron;
+    AutomataPista automataPista;
+    bool presente[256];
+    size_t salto[256];
+    size_t critica;
+    size_t periodo;
+    size_t memoriaPeriodica;
+    Filtro filtroSIMD;
+};
+
+#endif // BUSCADORPISTA_H
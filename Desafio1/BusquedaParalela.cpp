@@ -0,0 +1,311 @@
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "BuscadorPista.h"
+#include "BusquedaParametros.h"
+#include "ConjuntoPistas.h"
+#include "ContextoDescompresion.h"
+#include "EsquemasCifrado.h"
+#include "Metricas.h"
+#include "ProgresoBusqueda.h"
+using namespace std;
+
+/**
+ * @brief Rango de candidatos [inicio, fin) asignado a un hilo de busqueda.
+ *
+ * Cada candidato es un indice clave * 8 + bits (o el indice de @ref EsquemaCifrado),
+ * de modo que el orden de los indices coincide con el del ciclo secuencial.
+ */
+struct RangoCandidatos {
+    mutex cerrojo;
+    int inicio = 0;
+    int fin = 0;
+};
+
+/**
+ * @brief Estado compartido por todos los hilos de una busqueda paralela.
+ */
+struct EstadoBusqueda {
+    const unsigned char* data;
+    size_t size;
+    const BuscadorPista* buscador;   // Una sola pista...
+    const ConjuntoPistas* conjunto;  // ...o un conjunto (el otro queda en nullptr)
+    const EsquemaCifrado* esquema;   // nullptr = esquema original con indice clave * 8 + bits
+    int totalCandidatos;
+    unsigned char* metodos; // Mascara de metodos por candidato
+    ProgresoBusqueda* progreso;  // Candidatos ya descartados (opcional)
+    vector<RangoCandidatos> rangos;
+    atomic<int> mejor;      // Menor indice ganador encontrado hasta ahora
+    vector<unsigned char> evaluados;  // 1 en cada candidato que llego a descomprimirse
+
+    EstadoBusqueda(int numHilos, int total)
+        : buscador(nullptr), conjunto(nullptr), esquema(nullptr), totalCandidatos(total), progreso(nullptr),
+          rangos(numHilos), mejor(total), evaluados((size_t)total, 0) {}
+};
+
+/**
+ * @brief Toma el siguiente candidato del rango propio.
+ *
+ * Los candidatos con indice mayor al mejor ganador ya no pueden cambiar el
+ * resultado, por lo que el rango se recorta y el hilo deja de evaluarlos.
+ */
+static bool TomarPropio(EstadoBusqueda& estado, int hilo, int& indice) {
+    RangoCandidatos& rango = estado.rangos[hilo];
+    lock_guard<mutex> lock(rango.cerrojo);
+
+    int limite = estado.mejor.load();
+    if (rango.fin > limite) {
+        rango.fin = limite;
+    }
+    if (rango.inicio >= rango.fin) {
+        return false;
+    }
+    indice = rango.inicio++;
+    return true;
+}
+
+/**
+ * @brief Roba la mitad superior del rango con mas trabajo pendiente.
+ *
+ * @return true si se obtuvo trabajo nuevo para el hilo `hilo`.
+ */
+static bool Robar(EstadoBusqueda& estado, int hilo) {
+    int numHilos = (int)estado.rangos.size();
+
+    for (int intento = 0; intento < numHilos; intento++) {
+        // Elegir la victima con mas candidatos pendientes
+        int victima = -1;
+        int pendientesMax = 0;
+        for (int i = 0; i < numHilos; i++) {
+            if (i == hilo) {
+                continue;
+            }
+            RangoCandidatos& rango = estado.rangos[i];
+            lock_guard<mutex> lock(rango.cerrojo);
+            int fin = (rango.fin < estado.mejor.load()) ? rango.fin : estado.mejor.load();
+            int pendientes = fin - rango.inicio;
+            if (pendientes > pendientesMax) {
+                pendientesMax = pendientes;
+                victima = i;
+            }
+        }
+
+        if (victima < 0) {
+            return false;
+        }
+
+        int robadoInicio = 0;
+        int robadoFin = 0;
+        {
+            RangoCandidatos& rango = estado.rangos[victima];
+            lock_guard<mutex> lock(rango.cerrojo);
+            int limite = estado.mejor.load();
+            if (rango.fin > limite) {
+                rango.fin = limite;
+            }
+            int pendientes = rango.fin - rango.inicio;
+            if (pendientes <= 0) {
+                continue;  // La victima termino mientras se elegia; buscar otra
+            }
+            int mitad = rango.inicio + pendientes / 2;
+            robadoInicio = mitad;
+            robadoFin = rango.fin;
+            rango.fin = mitad;
+        }
+
+        RangoCandidatos& propio = estado.rangos[hilo];
+        lock_guard<mutex> lock(propio.cerrojo);
+        propio.inicio = robadoInicio;
+        propio.fin = robadoFin;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Ciclo principal de cada hilo: evalua candidatos propios y luego roba.
+ *
+ * Todos los candidatos del hilo reutilizan el mismo contexto de descompresion; si no
+ * se recibe uno, el hilo crea el suyo.
+ */
+static void TrabajadorBusqueda(EstadoBusqueda* estado, int hilo, ContextoDescompresion* contexto) {
+    if (contexto == nullptr) {
+        ContextoDescompresion propio;
+        TrabajadorBusqueda(estado, hilo, &propio);
+        return;
+    }
+
+    while (true) {
+        int indice = 0;
+        if (!TomarPropio(*estado, hilo, indice)) {
+            if (!Robar(*estado, hilo)) {
+                return;
+            }
+            continue;
+        }
+
+        // Descartado en una corrida anterior: no se vuelve a evaluar
+        if (estado->progreso != nullptr && estado->progreso->agotado(indice)) {
+            continue;
+        }
+
+        // Cada indice lo toma un solo hilo, asi que la marca no necesita sincronizarse
+        estado->evaluados[indice] = 1;
+        int clave = indice / 8;
+        int bits = indice % 8;
+
+        int metodo = (estado->esquema != nullptr)
+            ? VerificarCandidato(estado->data, estado->size, *estado->buscador,
+                                 ClaveCifrado(*estado->esquema, indice), estado->metodos[indice], contexto)
+            : (estado->conjunto != nullptr)
+            ? VerificarCandidato(estado->data, estado->size, *estado->conjunto,
+                                 (unsigned char)clave, bits, estado->metodos[indice], contexto)
+            : VerificarCandidato(estado->data, estado->size, *estado->buscador,
+                                 (unsigned char)clave, bits, estado->metodos[indice], contexto);
+        if (metodo != METODO_NINGUNO) {
+            // Quedarse con el menor indice ganador
+            int actual = estado->mejor.load();
+            while (indice < actual && !estado->mejor.compare_exchange_weak(actual, indice)) {
+            }
+        } else if (estado->progreso != nullptr) {
+            estado->progreso->marcar(indice);
+        }
+    }
+}
+
+/**
+ * @brief Normaliza la cantidad de hilos: 0 o negativo usa los nucleos disponibles.
+ */
+static int HilosBusqueda(int numHilos, int totalCandidatos = TOTAL_CANDIDATOS) {
+    if (numHilos <= 0) {
+        numHilos = (int)thread::hardware_concurrency();
+        if (numHilos <= 0) {
+            numHilos = 1;
+        }
+    }
+    return (numHilos > totalCandidatos) ? totalCandidatos : numHilos;
+}
+
+/**
+ * @brief Reparte los candidatos, corre los hilos y deja en `indice` el menor ganador.
+ */
+static bool EjecutarBusqueda(EstadoBusqueda& estado, int& indice, int& intentos,
+                             ContextoDescompresion* contexto) {
+    int numHilos = (int)estado.rangos.size();
+    int total = estado.totalCandidatos;
+
+    // Reparto inicial en rangos contiguos del mismo tamaño
+    for (int i = 0; i < numHilos; i++) {
+        estado.rangos[i].inicio = (int)((long long)total * i / numHilos);
+        estado.rangos[i].fin = (int)((long long)total * (i + 1) / numHilos);
+    }
+
+    vector<thread> hilos;
+    for (int i = 1; i < numHilos; i++) {
+        hilos.emplace_back(TrabajadorBusqueda, &estado, i, nullptr);
+    }
+    TrabajadorBusqueda(&estado, 0, contexto);
+    for (thread& h : hilos) {
+        h.join();
+    }
+
+    // Los candidatos evaluados por encima del ganador antes de que se conociera no cuentan,
+    // asi los intentos son los mismos que los de recorrer los indices en orden
+    indice = estado.mejor.load();
+    int ultimo = (indice < total) ? indice : total - 1;
+    intentos = 0;
+    for (int i = 0; i <= ultimo; i++) {
+        intentos += estado.evaluados[i];
+    }
+    return indice < total;
+}
+
+/**
+ * @brief Busqueda con el esquema original: separa el indice ganador en clave y bits.
+ */
+static bool EjecutarBusqueda(EstadoBusqueda& estado, int& nbits, int& claveK, int& intentos,
+                             ContextoDescompresion* contexto) {
+    int indice = 0;
+    if (!EjecutarBusqueda(estado, indice, intentos, contexto)) {
+        return false;
+    }
+    claveK = indice / 8;
+    nbits = indice % 8;
+    return true;
+}
+
+/**
+ * @brief Busca en paralelo el menor candidato (clave, bits) cuya descompresion contiene la pista.
+ *
+ * El espacio de 255 x 8 candidatos se divide en rangos contiguos, uno por hilo.
+ * Un hilo que termina su rango roba la mitad pendiente del rango mas cargado.
+ * Cuando un hilo encuentra la pista, los demas descartan los candidatos con indice
+ * mayor, pero terminan los menores para que el resultado sea el mismo de la
+ * busqueda secuencial.
+ *
+ * @param data Datos encriptados.
+ * @param size Tamaño de los datos.
+ * @param buscador Buscador preparado con la pista (compartido por todos los hilos).
+ * @param metodos Mascara de metodos a probar por candidato (TOTAL_CANDIDATOS posiciones).
+ * @param numHilos Cantidad de hilos (0 o negativo = nucleos disponibles).
+ * @param nbits Salida: bits de rotacion encontrados.
+ * @param claveK Salida: clave XOR encontrada.
+ * @param intentos Salida: candidatos evaluados hasta el ganador inclusive (o todos, si no hubo),
+ *                 la misma cuenta que la busqueda secuencial.
+ * @param contexto Memoria de trabajo del hilo que llama (opcional).
+ * @param progreso Candidatos ya descartados, que se saltean, y donde se marcan los nuevos (opcional).
+ * @return true si algun candidato contiene la pista.
+ */
+bool BuscarParametrosParalelo(const unsigned char* data, size_t size, const BuscadorPista& buscador,
+                              unsigned char* metodos, int numHilos, int& nbits, int& claveK, int& intentos,
+                              ContextoDescompresion* contexto, ProgresoBusqueda* progreso) {
+    EstadoBusqueda estado(HilosBusqueda(numHilos), TOTAL_CANDIDATOS);
+    estado.data = data;
+    estado.size = size;
+    estado.buscador = &buscador;
+    estado.metodos = metodos;
+    estado.progreso = progreso;
+    return EjecutarBusqueda(estado, nbits, claveK, intentos, contexto);
+}
+
+/**
+ * @brief Igual que la version con una pista, pero cada candidato se acepta segun el
+ * criterio del conjunto (ver @ref ConjuntoPistas::requeridas).
+ */
+bool BuscarParametrosParalelo(const unsigned char* data, size_t size, const ConjuntoPistas& conjunto,
+                              unsigned char* metodos, int numHilos, int& nbits, int& claveK, int& intentos,
+                              ContextoDescompresion* contexto, ProgresoBusqueda* progreso) {
+    EstadoBusqueda estado(HilosBusqueda(numHilos), TOTAL_CANDIDATOS);
+    estado.data = data;
+    estado.size = size;
+    estado.conjunto = &conjunto;
+    estado.metodos = metodos;
+    estado.progreso = progreso;
+    return EjecutarBusqueda(estado, nbits, claveK, intentos, contexto);
+}
+
+/**
+ * @brief Busqueda paralela en el espacio de claves de cualquier esquema de cifrado.
+ *
+ * Usa el mismo reparto y robo de rangos; el indice de cada candidato es el de
+ * @ref EsquemaCifrado::parametros, asi que el ganador coincide con el de recorrer
+ * los indices en orden.
+ *
+ * @param metodos Mascara por candidato (`esquema.totalCandidatos()` posiciones).
+ * @param indice Salida: indice del menor candidato que contiene la pista.
+ */
+bool BuscarParametrosEsquema(const unsigned char* data, size_t size, const BuscadorPista& buscador,
+                             const EsquemaCifrado& esquema, unsigned char* metodos, int numHilos,
+                             int& indice, int& intentos, ContextoDescompresion* contexto,
+                             ProgresoBusqueda* progreso) {
+    int total = esquema.totalCandidatos();
+    EstadoBusqueda estado(HilosBusqueda(numHilos, total), total);
+    estado.data = data;
+    estado.size = size;
+    estado.buscador = &buscador;
+    estado.esquema = &esquema;
+    estado.metodos = metodos;
+    estado.progreso = progreso;
+    return EjecutarBusqueda(estado, indice, intentos, contexto);
+}
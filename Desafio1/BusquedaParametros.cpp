@@ -1,33 +1,710 @@
 #include <iostream>
-#include "funciones.h"
+#include <vector>
+#include "BuscadorPista.h"
+#include "BusquedaParametros.h"
+#include "CacheParametros.h"
+#include "CompresionDescompresion.h"
+#include "ConjuntoPistas.h"
+#include "ContextoDescompresion.h"
+#include "EsquemasCifrado.h"
+#include "FiltrosCandidatos.h"
+#include "ManipulacionTexto.h"
+#include "Metricas.h"
+#include "ProgresoBusqueda.h"
+#include "Sumideros.h"
 using namespace std;
 
 /**
  * @brief Funcion para buscar una secuencia dentro de otra usando arreglos
+ *
+ * Para busquedas repetidas con la misma pista conviene crear un BuscadorPista
+ * una sola vez y reutilizarlo.
  */
 bool buscarSecuencia(unsigned char* texto, int sizeTexto, unsigned char* pista, int sizePista) {
-    if (texto == nullptr || pista == nullptr || sizeTexto < sizePista) {
+    if (texto == nullptr || pista == nullptr || sizeTexto < sizePista || sizePista <= 0) {
         return false;
     }
 
-    for (int i = 0; i <= sizeTexto - sizePista; i++) {
-        bool coincide = true;
-        for (int j = 0; j < sizePista; j++) {
-            if (texto[i + j] != pista[j]) {
-                coincide = false;
-                break;
+    BuscadorPista buscador(pista, sizePista);
+    return buscador.contenidaEn(texto, sizeTexto);
+}
+
+/**
+ * @brief Descomprime por completo un candidato con un metodo en la salida del contexto.
+ *
+ * Una sola pasada por candidato: cada terna se desencripta una vez y se escribe en memoria.
+ * El texto LZ78 de un archivo grande se reparte entre los hilos de
+ * @ref ConfigurarDescompresionParalela (ver @ref descompresionLZ78Paralela).
+ *
+ * @param totalFlujo Tamaño del texto que queda en `contexto.salida()`.
+ * @return true si los datos son validos para el metodo.
+ */
+static bool ConstruirCandidato(const unsigned char* data, size_t size, const ClaveCifrado& cifrado,
+                               int metodo, ContextoDescompresion& contexto, size_t& totalFlujo) {
+    contexto.reiniciar();
+    SumideroMemoria& salida = contexto.salida();
+    totalFlujo = 0;
+    bool esValido;
+    {
+        MedidorEtapa medidor(ETAPA_CONSTRUCCION);
+        esValido = (metodo == METODO_RLE)
+            ? descompresionRLEFlujo(data, size, cifrado, salida, totalFlujo)
+            : descompresionLZ78Paralela(data, size, cifrado, salida, totalFlujo, HilosDescompresion(), &contexto);
+    }
+    return esValido;
+}
+
+/**
+ * @brief Descomprime con los parametros dados y retorna el resultado solo si contiene la pista.
+ *
+ * Prueba primero RLE y luego LZ78, igual que la busqueda secuencial. No imprime
+ * nada ni escribe archivos, por lo que puede llamarse desde varios hilos a la vez.
+ *
+ * @param data Datos encriptados originales
+ * @param size Tamaño de los datos
+ * @param buscador Buscador ya preparado con la pista
+ * @param claveXOR Clave XOR a aplicar
+ * @param rotacionBits Bits de rotacion a aplicar
+ * @param total Tamaño del texto descomprimido retornado
+ * @param metodo Metodo con el que se encontro la pista (METODO_NINGUNO si no hubo coincidencia)
+ * @param metodos Mascara de metodos a probar (METODO_RLE | METODO_LZ78)
+ * @param contexto Memoria de trabajo reutilizable (opcional); su sumidero acumula el texto
+ * @return Texto descomprimido (liberar con delete[]) o nullptr si la pista no aparece
+ */
+unsigned char* DescomprimirConPista(const unsigned char* data, size_t size, const BuscadorPista& buscador,
+                                    unsigned char claveXOR, int rotacionBits, size_t& total, int& metodo,
+                                    int metodos, ContextoDescompresion* contexto) {
+    return DescomprimirConPista(data, size, buscador, ClaveCifrado(claveXOR, rotacionBits), total, metodo,
+                                metodos, contexto);
+}
+
+/**
+ * @brief Igual que con (clave, bits), para un candidato de cualquier esquema de cifrado.
+ */
+unsigned char* DescomprimirConPista(const unsigned char* data, size_t size, const BuscadorPista& buscador,
+                                    const ClaveCifrado& cifrado, size_t& total, int& metodo,
+                                    int metodos, ContextoDescompresion* contexto) {
+    total = 0;
+    metodo = METODO_NINGUNO;
+
+    if (data == nullptr || size == 0 || buscador.size() == 0) {
+        return nullptr;
+    }
+
+    metodos = ElegirMetodos(data, size, cifrado, metodos);
+
+    // Sin contexto se usa uno local (no reserva memoria hasta el primer uso)
+    ContextoDescompresion local;
+    if (contexto == nullptr) {
+        contexto = &local;
+    }
+
+    unsigned char* resultado = nullptr;
+    const int metodosOrden[2] = { METODO_RLE, METODO_LZ78 };
+    for (int actual : metodosOrden) {
+        size_t totalFlujo = 0;
+        if (!(metodos & actual)
+            || !ConstruirCandidato(data, size, cifrado, actual, *contexto, totalFlujo)) {
+            continue;
+        }
+
+        SumideroMemoria& salida = contexto->salida();
+        MedidorEtapa medidor(ETAPA_COINCIDENCIA);
+        if (buscador.contenidaEn(salida.datos(), totalFlujo)) {
+            total = totalFlujo;
+            metodo = actual;
+            resultado = salida.liberar();
+            break;
+        }
+        RegistrarRechazo(actual, RECHAZO_PISTA_AUSENTE);
+    }
+
+    return resultado;
+}
+
+/**
+ * @brief Verifica un candidato (clave, bits) sin efectos secundarios.
+ *
+ * Los descompresores entregan su salida directamente al automata de la pista, sin
+ * guardarla en memoria. Apenas la pista se completa se deja de producir salida y el
+ * resto de la entrada solo se valida, asi el veredicto es el mismo que el de la
+ * descompresion completa pero sin construir el texto.
+ *
+ * Con un contexto, el diccionario LZ78 se toma de su arena, que se reinicia antes de
+ * cada metodo, asi que verificar candidatos seguidos no reserva memoria.
+ *
+ * @return Metodo con el que aparece la pista, o METODO_NINGUNO.
+ */
+int VerificarCandidato(const unsigned char* data, size_t size, const BuscadorPista& buscador,
+                       unsigned char claveXOR, int rotacionBits, int metodos,
+                       ContextoDescompresion* contexto) {
+    return VerificarCandidato(data, size, buscador, ClaveCifrado(claveXOR, rotacionBits), metodos, contexto);
+}
+
+/**
+ * @brief Igual que con (clave, bits), para un candidato de cualquier esquema de cifrado.
+ */
+int VerificarCandidato(const unsigned char* data, size_t size, const BuscadorPista& buscador,
+                       const ClaveCifrado& cifrado, int metodos, ContextoDescompresion* contexto) {
+    if (data == nullptr || size == 0 || buscador.size() == 0) {
+        return METODO_NINGUNO;
+    }
+
+    MedidorEtapa medidor(ETAPA_VERIFICACION);
+
+    // Si se pidieron ambos formatos, solo se corre el que corresponde al comienzo de los datos
+    metodos = ElegirMetodos(data, size, cifrado, metodos);
+
+    if (metodos & METODO_RLE) {
+        SumideroCoincidencia coincidencia(buscador.automata());
+        size_t total = 0;
+        if (descompresionRLEFlujo(data, size, cifrado, coincidencia, total)) {
+            if (coincidencia.encontrada()) {
+                return METODO_RLE;
             }
+            RegistrarRechazo(METODO_RLE, RECHAZO_PISTA_AUSENTE);
         }
-        if (coincide) {
-            return true;
+    }
+
+    if (metodos & METODO_LZ78) {
+        if (contexto != nullptr) {
+            contexto->reiniciar();
+        }
+        SumideroCoincidencia coincidencia(buscador.automata());
+        size_t total = 0;
+        if (descompresionLZ78Flujo(data, size, cifrado, coincidencia, total, contexto)) {
+            if (coincidencia.encontrada()) {
+                return METODO_LZ78;
+            }
+            RegistrarRechazo(METODO_LZ78, RECHAZO_PISTA_AUSENTE);
         }
     }
-    return false;
+
+    return METODO_NINGUNO;
+}
+
+/**
+ * @brief Igual que la version con una pista, pero acepta segun el criterio de un conjunto de pistas.
+ *
+ * @param finales Salida de `conjunto.size()` posiciones: fin de la primera aparicion de cada
+ *                pista en el texto retornado (ver @ref ConjuntoPistas::buscarEn).
+ * @return Texto descomprimido (liberar con delete[]) o nullptr si no se cumple el criterio
+ */
+unsigned char* DescomprimirConPista(const unsigned char* data, size_t size, const ConjuntoPistas& conjunto,
+                                    unsigned char claveXOR, int rotacionBits, size_t& total, int& metodo,
+                                    uint64_t* finales, int metodos, ContextoDescompresion* contexto) {
+    total = 0;
+    metodo = METODO_NINGUNO;
+
+    if (data == nullptr || size == 0 || conjunto.size() == 0 || !conjunto.preparado()) {
+        return nullptr;
+    }
+
+    ClaveCifrado cifrado(claveXOR, rotacionBits);
+    metodos = ElegirMetodos(data, size, cifrado, metodos);
+
+    ContextoDescompresion local;
+    if (contexto == nullptr) {
+        contexto = &local;
+    }
+
+    unsigned char* resultado = nullptr;
+    const int metodosOrden[2] = { METODO_RLE, METODO_LZ78 };
+    for (int actual : metodosOrden) {
+        size_t totalFlujo = 0;
+        if (!(metodos & actual)
+            || !ConstruirCandidato(data, size, cifrado, actual, *contexto, totalFlujo)) {
+            continue;
+        }
+
+        SumideroMemoria& salida = contexto->salida();
+        MedidorEtapa medidor(ETAPA_COINCIDENCIA);
+        if (conjunto.buscarEn(salida.datos(), totalFlujo, finales) >= conjunto.requeridas()) {
+            total = totalFlujo;
+            metodo = actual;
+            resultado = salida.liberar();
+            break;
+        }
+        RegistrarRechazo(actual, RECHAZO_PISTA_AUSENTE);
+    }
+
+    return resultado;
+}
+
+/**
+ * @brief Verifica un candidato contra un conjunto de pistas, en la misma pasada que la descompresion.
+ *
+ * Las posiciones de cada pista se anotan en la arena del contexto (o en un arreglo local
+ * sin contexto), asi que con contexto la verificacion tampoco reserva memoria.
+ *
+ * @return Metodo con el que se cumple el criterio del conjunto, o METODO_NINGUNO.
+ */
+int VerificarCandidato(const unsigned char* data, size_t size, const ConjuntoPistas& conjunto,
+                       unsigned char claveXOR, int rotacionBits, int metodos,
+                       ContextoDescompresion* contexto) {
+    if (data == nullptr || size == 0 || conjunto.size() == 0 || !conjunto.preparado()) {
+        return METODO_NINGUNO;
+    }
+
+    MedidorEtapa medidor(ETAPA_VERIFICACION);
+
+    metodos = ElegirMetodos(data, size, claveXOR, rotacionBits, metodos);
+
+    vector<uint64_t> local;
+    const int metodosOrden[2] = { METODO_RLE, METODO_LZ78 };
+    for (int actual : metodosOrden) {
+        if (!(metodos & actual)) {
+            continue;
+        }
+
+        uint64_t* finales;
+        if (contexto != nullptr) {
+            contexto->reiniciar();
+            finales = contexto->arena().reservarArreglo<uint64_t>(conjunto.size());
+        } else {
+            local.resize(conjunto.size());
+            finales = local.data();
+        }
+
+        SumideroPistas pistas(conjunto, finales);
+        size_t total = 0;
+        bool esValido = (actual == METODO_RLE)
+            ? descompresionRLEFlujo(data, size, claveXOR, rotacionBits, pistas, total)
+            : descompresionLZ78Flujo(data, size, claveXOR, rotacionBits, pistas, total, contexto);
+        if (esValido) {
+            if (pistas.cumplido()) {
+                return actual;
+            }
+            RegistrarRechazo(actual, RECHAZO_PISTA_AUSENTE);
+        }
+    }
+
+    return METODO_NINGUNO;
+}
+
+static const size_t COMIENZO_MOSTRADO = 100;  // Caracteres del texto ganador que se muestran
+
+/**
+ * @brief Sumidero del candidato ganador: reparte cada parte del texto entre el criterio que
+ *        confirma las pistas, el archivo de salida y el comienzo que se muestra.
+ *
+ * El criterio deja de pedir datos apenas se cumple, pero el archivo necesita el texto
+ * completo, asi que la respuesta del criterio no corta la descompresion. Finalizar no toca
+ * el archivo: quien llama lo finaliza o no segun el criterio.
+ */
+class SumideroGanador : public Sumidero {
+public:
+    SumideroGanador(Sumidero& criterio, Sumidero* destino)
+        : criterio(criterio), destino(destino), pideCriterio(true), pideDestino(destino != nullptr) {}
+
+    bool escribir(const unsigned char* bytes, size_t cantidad) override {
+        if (comienzo.size() < COMIENZO_MOSTRADO) {
+            size_t parte = COMIENZO_MOSTRADO - comienzo.size();
+            comienzo.append(reinterpret_cast<const char*>(bytes), (cantidad < parte) ? cantidad : parte);
+        }
+        if (pideCriterio) {
+            pideCriterio = criterio.escribir(bytes, cantidad);
+        }
+        if (pideDestino) {
+            pideDestino = destino->escribir(bytes, cantidad);
+        }
+        return pideCriterio || pideDestino || comienzo.size() < COMIENZO_MOSTRADO;
+    }
+
+    bool escribirRepeticion(unsigned char caracter, size_t cantidad) override {
+        if (comienzo.size() < COMIENZO_MOSTRADO) {
+            size_t parte = COMIENZO_MOSTRADO - comienzo.size();
+            comienzo.append((cantidad < parte) ? cantidad : parte, (char)caracter);
+        }
+        if (pideCriterio) {
+            pideCriterio = criterio.escribirRepeticion(caracter, cantidad);
+        }
+        if (pideDestino) {
+            pideDestino = destino->escribirRepeticion(caracter, cantidad);
+        }
+        return pideCriterio || pideDestino || comienzo.size() < COMIENZO_MOSTRADO;
+    }
+
+    void descartar() override {
+        criterio.descartar();
+        if (destino != nullptr) {
+            destino->descartar();
+        }
+        comienzo.clear();
+        pideCriterio = true;
+        pideDestino = (destino != nullptr);
+    }
+
+    /** @brief Primeros caracteres del texto recibido. */
+    const string& inicio() const { return comienzo; }
+
+private:
+    Sumidero& criterio;
+    Sumidero* destino;
+    bool pideCriterio;
+    bool pideDestino;
+    string comienzo;
+};
+
+/**
+ * @brief Descomprime una sola vez el candidato `indice` y reparte el texto a medida que sale.
+ *
+ * El texto no pasa por un buffer del tamaño del archivo: cada parte va al criterio de la
+ * variante, a `destino` y al comienzo que se muestra. Los metodos se prueban en el orden
+ * de la busqueda; LZ78 usa los hilos de @ref ConfigurarDescompresionParalela. El destino
+ * no se finaliza: si el candidato no cumple el criterio queda descartado.
+ *
+ * @return Metodo con el que se cumple el criterio, o METODO_NINGUNO.
+ */
+static int DescomprimirGanador(VarianteBusqueda& variante, const unsigned char* data, size_t size, int indice,
+                               int metodos, Sumidero* destino, ContextoDescompresion& contexto,
+                               string& comienzo) {
+    comienzo.clear();
+    if (data == nullptr || size == 0) {
+        return METODO_NINGUNO;
+    }
+
+    ClaveCifrado cifrado = variante.cifrado(indice);
+    metodos = ElegirMetodos(data, size, cifrado, metodos);
+    Sumidero& criterio = variante.criterio();
+    criterio.descartar();
+    SumideroGanador ganador(criterio, destino);
+
+    const int metodosOrden[2] = { METODO_RLE, METODO_LZ78 };
+    for (int actual : metodosOrden) {
+        if (!(metodos & actual)) {
+            continue;
+        }
+        contexto.reiniciar();
+        size_t total = 0;
+        bool esValido;
+        {
+            MedidorEtapa medidor(ETAPA_CONSTRUCCION);
+            esValido = (actual == METODO_RLE)
+                ? descompresionRLEFlujo(data, size, cifrado, ganador, total)
+                : descompresionLZ78Paralela(data, size, cifrado, ganador, total, HilosDescompresion(),
+                                            &contexto);
+        }
+        if (esValido && variante.cumplido()) {
+            comienzo = ganador.inicio();
+            return actual;
+        }
+        if (esValido) {
+            RegistrarRechazo(actual, RECHAZO_PISTA_AUSENTE);
+            ganador.descartar();
+        }
+    }
+    return METODO_NINGUNO;
+}
+
+/**
+ * @brief Descomprime el ganador y, si se acepta, finaliza el destino.
+ *
+ * @return true si el ganador cumple el criterio; `resultado.guardado` indica si ademas su
+ *         texto quedo completo en el destino.
+ */
+static bool ConfirmarGanador(VarianteBusqueda& variante, const unsigned char* data, size_t size, int indice,
+                             int metodos, Sumidero* destino, ContextoDescompresion& contexto,
+                             ResultadoBusqueda& resultado) {
+    resultado.indice = indice;
+    resultado.metodo = DescomprimirGanador(variante, data, size, indice, metodos, destino, contexto,
+                                           resultado.comienzo);
+    if (resultado.metodo == METODO_NINGUNO) {
+        return false;
+    }
+    resultado.encontrado = true;
+    resultado.guardado = (destino == nullptr || destino->finalizar());
+    return true;
+}
+
+bool BuscarGanador(VarianteBusqueda& variante, const unsigned char* data, size_t size, int numHilos,
+                   const char* rutaSalida, Sumidero* destino, ContextoDescompresion& contexto, bool informar,
+                   ResultadoBusqueda& resultado) {
+    resultado = ResultadoBusqueda();
+    int totalCandidatos = variante.totalCandidatos();
+
+    // Un archivo ya resuelto se comprueba con una sola descompresion, sin buscar
+    HuellaBusqueda huella = {};
+    bool conCache = CacheParametrosActiva();
+    if (conCache || PuntosControlActivos()) {
+        huella = variante.huella(data, size);
+    }
+    if (conCache) {
+        int indice = 0;
+        int metodo = METODO_NINGUNO;
+        if (ConsultarCacheParametros(huella, totalCandidatos, indice, metodo)) {
+            if (ConfirmarGanador(variante, data, size, indice, metodo, destino, contexto, resultado)) {
+                resultado.desdeCache = true;
+                resultado.intentos = 1;
+                return resultado.guardado;
+            }
+            OlvidarCacheParametros(huella);
+        }
+    }
+
+    if (informar) {
+        cout << "Iniciando busqueda de parametros..." << endl;
+    }
+
+    // El filtrado previo deja sin metodos a casi todos los candidatos, que se saltean sin descomprimir
+    vector<unsigned char> metodos((size_t)totalCandidatos);
+    variante.prepararMetodos(data, size, metodos.data());
+
+    // Con puntos de control se saltean los candidatos descartados antes de una interrupcion
+    ProgresoBusqueda avance;
+    avance.iniciar(rutaSalida, huella, totalCandidatos);
+
+    int intentos = avance.descartadosPrevios();
+    int indice = 0;
+    bool encontrado = false;
+
+    if (numHilos != 1) {
+        // Busqueda repartida entre varios hilos; el resultado es el mismo que el secuencial
+        int evaluados = 0;
+        encontrado = variante.buscarParalelo(data, size, metodos.data(), numHilos, indice, evaluados, &contexto,
+                                             avance.activo() ? &avance : nullptr);
+        intentos += evaluados;
+    } else {
+        // Busqueda exhaustiva en orden; el avance se informa a lo sumo una vez por segundo
+        ReporteProgreso progreso((uint64_t)totalCandidatos);
+        for (int i = 0; i < totalCandidatos && !encontrado; i++) {
+            if (avance.agotado(i)) {
+                continue;
+            }
+            intentos++;
+            if (informar) {
+                int clave = 0;
+                int bits = 0;
+                variante.posicion(i, clave, bits);
+                progreso.avanzar((uint64_t)intentos, clave, bits);
+            }
+            if (variante.verificar(data, size, i, metodos[i], &contexto) != METODO_NINGUNO) {
+                indice = i;
+                encontrado = true;
+            } else {
+                avance.marcar(i);
+            }
+        }
+    }
+    avance.terminar();
+    resultado.intentos = intentos;
+
+    // El ganador se repite desde un solo hilo para guardarlo
+    if (!encontrado
+        || !ConfirmarGanador(variante, data, size, indice, metodos[indice], destino, contexto, resultado)) {
+        return false;
+    }
+    if (conCache) {
+        GuardarCacheParametros(huella, indice, resultado.metodo);
+    }
+    return resultado.guardado;
+}
+
+/**
+ * @brief Muestra el comienzo del texto ganador y donde quedo guardado.
+ */
+static void MostrarComienzo(const string& comienzo, const char* rutaArchivoModificado) {
+    cout << "Contenido descomprimido (primeros " << COMIENZO_MOSTRADO << " caracteres):\n";
+    mostrarContenido(reinterpret_cast<const unsigned char*>(comienzo.data()), (int)comienzo.size());
+    if (rutaArchivoModificado != nullptr) {
+        cout << "Archivo descomprimido guardado en: " << rutaArchivoModificado << endl;
+    }
+}
+
+/**
+ * @brief Busca con @ref BuscarGanador, guarda el texto del ganador en `rutaArchivoModificado`
+ *        e informa el resultado en la consola.
+ */
+static bool BuscarEInformar(VarianteBusqueda& variante, const unsigned char* data, size_t size,
+                            const char* rutaArchivoModificado, int numHilos, ResultadoBusqueda& resultado) {
+    SumideroArchivo* archivo = nullptr;
+    if (rutaArchivoModificado != nullptr) {
+        archivo = new SumideroArchivo(rutaArchivoModificado);
+        if (!archivo->abierto()) {
+            cout << "Error: no se pudo crear el archivo " << rutaArchivoModificado << endl;
+            delete archivo;
+            return false;
+        }
+    }
+
+    // Memoria de trabajo compartida por todos los candidatos de este hilo
+    ContextoDescompresion contexto;
+    BuscarGanador(variante, data, size, numHilos, rutaArchivoModificado, archivo, contexto, true, resultado);
+    delete archivo;  // Sin finalizar, el temporal se borra y el destino queda como estaba
+
+    if (!resultado.encontrado) {
+        cout << "No se encontraron parametros validos despues de " << resultado.intentos << " intentos." << endl;
+        return false;
+    }
+    if (!resultado.guardado) {
+        cout << "Error al guardar el archivo descomprimido " << rutaArchivoModificado << endl;
+        return false;
+    }
+
+    variante.mostrarGanador(resultado.indice, resultado.metodo);
+    MostrarComienzo(resultado.comienzo, rutaArchivoModificado);
+    cout << (resultado.desdeCache ? "Parametros encontrados en la cache!" : "Parametros encontrados!") << endl;
+    cout << "Total de intentos realizados: " << resultado.intentos << endl;
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Variantes de busqueda
+// ---------------------------------------------------------------------------
+
+int VarianteBusqueda::totalCandidatos() const {
+    return TOTAL_CANDIDATOS;
+}
+
+ClaveCifrado VarianteBusqueda::cifrado(int indice) const {
+    return ClaveCifrado((unsigned char)(indice / 8), indice % 8);
+}
+
+void VarianteBusqueda::posicion(int indice, int& clave, int& bits) const {
+    clave = indice / 8;
+    bits = indice % 8;
 }
 
+/**
+ * @brief LZ78 solo se prueba en los pocos candidatos compatibles con la primera terna.
+ */
+void VarianteBusqueda::prepararMetodos(const unsigned char* data, size_t size, unsigned char* metodos) const {
+    PrepararMetodosCandidatos(data, size, metodos);
+}
+
+/**
+ * @brief Muestra la clave XOR y los bits de un candidato de la tabla original.
+ */
+static void MostrarClaveBits(int indice) {
+    cout << "Clave XOR: " << indice / 8 << " (0x" << hex << indice / 8 << dec << ")\n";
+    cout << "Bits de rotacion: " << indice % 8 << "\n";
+}
+
+// La pista se preprocesa una sola vez para todos los candidatos
+BusquedaPista::BusquedaPista(const unsigned char* pista, size_t sizePista)
+    : pista(pista), sizePista(sizePista), buscador(pista, sizePista), coincidencia(buscador.automata()) {}
+
+HuellaBusqueda BusquedaPista::huella(const unsigned char* data, size_t size) const {
+    return CalcularHuellaBusqueda(data, size, pista, sizePista);
+}
+
+int BusquedaPista::verificar(const unsigned char* data, size_t size, int indice, int metodos,
+                             ContextoDescompresion* contexto) const {
+    return VerificarCandidato(data, size, buscador, (unsigned char)(indice / 8), indice % 8, metodos, contexto);
+}
+
+bool BusquedaPista::buscarParalelo(const unsigned char* data, size_t size, unsigned char* metodos, int numHilos,
+                                   int& indice, int& intentos, ContextoDescompresion* contexto,
+                                   ProgresoBusqueda* progreso) const {
+    int clave = 0;
+    int bits = 0;
+    bool encontrado = BuscarParametrosParalelo(data, size, buscador, metodos, numHilos, bits, clave, intentos,
+                                               contexto, progreso);
+    indice = clave * 8 + bits;
+    return encontrado;
+}
+
+void BusquedaPista::mostrarGanador(int indice, int metodo) const {
+    cout << "Pista encontrada con " << (metodo == METODO_RLE ? "RLE" : "LZ78") << "!\n";
+    MostrarClaveBits(indice);
+}
+
+BusquedaEsquema::BusquedaEsquema(const unsigned char* pista, size_t sizePista, const EsquemaCifrado& esquema)
+    : BusquedaPista(pista, sizePista), esquema(esquema) {}
+
+int BusquedaEsquema::totalCandidatos() const {
+    return esquema.totalCandidatos();
+}
+
+ClaveCifrado BusquedaEsquema::cifrado(int indice) const {
+    return ClaveCifrado(esquema, indice);
+}
+
+/**
+ * @brief Con rotacion el indice es clave * 8 + bits; sin ella, solo la clave.
+ */
+void BusquedaEsquema::posicion(int indice, int& clave, int& bits) const {
+    int paso = esquema.rotacion ? 8 : 1;
+    clave = indice / paso;
+    bits = indice % paso;
+}
+
+void BusquedaEsquema::prepararMetodos(const unsigned char* data, size_t size, unsigned char* metodos) const {
+    PrepararMetodosEsquema(data, size, esquema, metodos);
+}
+
+HuellaBusqueda BusquedaEsquema::huella(const unsigned char* data, size_t size) const {
+    return CalcularHuellaBusqueda(data, size, pista, sizePista, esquema.nombre);
+}
+
+int BusquedaEsquema::verificar(const unsigned char* data, size_t size, int indice, int metodos,
+                               ContextoDescompresion* contexto) const {
+    return VerificarCandidato(data, size, buscador, ClaveCifrado(esquema, indice), metodos, contexto);
+}
+
+bool BusquedaEsquema::buscarParalelo(const unsigned char* data, size_t size, unsigned char* metodos, int numHilos,
+                                     int& indice, int& intentos, ContextoDescompresion* contexto,
+                                     ProgresoBusqueda* progreso) const {
+    return BuscarParametrosEsquema(data, size, buscador, esquema, metodos, numHilos, indice, intentos, contexto,
+                                   progreso);
+}
+
+void BusquedaEsquema::mostrarGanador(int indice, int metodo) const {
+    ParametrosCifrado encontrados = ClaveCifrado(esquema, indice).parametros();
+    cout << "Pista encontrada con " << (metodo == METODO_RLE ? "RLE" : "LZ78") << "!\n";
+    cout << "Clave:" << hex;
+    for (int i = 0; i < encontrados.longitudClave; i++) {
+        cout << " 0x" << (int)encontrados.clave[i];
+    }
+    cout << dec << "\n";
+    if (esquema.rotacion) {
+        cout << "Bits de rotacion: " << encontrados.bits << "\n";
+    }
+}
+
+BusquedaConjunto::BusquedaConjunto(const ConjuntoPistas& conjunto)
+    : conjunto(conjunto), finales(conjunto.size()), pistas(conjunto, finales.data(), true) {}
+
+HuellaBusqueda BusquedaConjunto::huella(const unsigned char* data, size_t size) const {
+    return CalcularHuellaBusqueda(data, size, conjunto);
+}
+
+int BusquedaConjunto::verificar(const unsigned char* data, size_t size, int indice, int metodos,
+                                ContextoDescompresion* contexto) const {
+    return VerificarCandidato(data, size, conjunto, (unsigned char)(indice / 8), indice % 8, metodos, contexto);
+}
+
+bool BusquedaConjunto::buscarParalelo(const unsigned char* data, size_t size, unsigned char* metodos, int numHilos,
+                                      int& indice, int& intentos, ContextoDescompresion* contexto,
+                                      ProgresoBusqueda* progreso) const {
+    int clave = 0;
+    int bits = 0;
+    bool encontrado = BuscarParametrosParalelo(data, size, conjunto, metodos, numHilos, bits, clave, intentos,
+                                               contexto, progreso);
+    indice = clave * 8 + bits;
+    return encontrado;
+}
+
+/**
+ * @brief Informa cada pista del conjunto con la posicion de su primera aparicion.
+ */
+void BusquedaConjunto::mostrarGanador(int indice, int metodo) const {
+    cout << "Pistas encontradas con " << (metodo == METODO_RLE ? "RLE" : "LZ78") << ": "
+         << pistas.encontradas() << "/" << conjunto.size() << endl;
+    MostrarPistasEncontradas(conjunto, finales.data());
+    MostrarClaveBits(indice);
+}
+
+// ---------------------------------------------------------------------------
+// Busquedas con salida en la consola
+// ---------------------------------------------------------------------------
+
 /**
  * @brief Funcion para probar descompresion con parametros integrados
  *
+ * El texto se descomprime una sola vez, directo al archivo (ver @ref BuscarGanador),
+ * asi que no hay limite de tamaño mas alla del disco.
+ *
  * @param data Datos encriptados originales
  * @param size Tamaño de los datos
  * @param pista Secuencia a buscar
@@ -35,77 +712,51 @@ bool buscarSecuencia(unsigned char* texto, int sizeTexto, unsigned char* pista,
  * @param claveXOR Clave XOR a aplicar
  * @param rotacionBits Bits de rotacion a aplicar
  * @param rutaArchivoModificado Ruta donde guardar el resultado exitoso
- * @return true si encuentra la pista, false en caso contrario
+ * @param metodos Mascara de metodos a probar (METODO_RLE | METODO_LZ78)
+ * @param contexto Memoria de trabajo reutilizable (opcional)
+ * @param metodoEncontrado Salida opcional: metodo con el que aparecio la pista
+ * @return true si encuentra la pista y el resultado quedo guardado, false en caso contrario
  */
-bool ProbarDescompresion(unsigned char* data, int size, unsigned char* pista, int sizePista,
-                         unsigned char claveXOR, int rotacionBits, const char* rutaArchivoModificado) {
-    if (data == nullptr || pista == nullptr || size <= 0 || sizePista <= 0) {
+bool ProbarDescompresion(const unsigned char* data, size_t size, const unsigned char* pista, size_t sizePista,
+                         unsigned char claveXOR, int rotacionBits, const char* rutaArchivoModificado,
+                         int metodos, ContextoDescompresion* contexto, int* metodoEncontrado) {
+    if (pista == nullptr || sizePista == 0) {
         return false;
     }
 
-    // Probar RLE con desencriptado integrado
-    int total_rle = 0;
-    bool esValido_rle = false;
-    unsigned char* descomprimido_rle = descompresionRLE(data, size, claveXOR, rotacionBits,
-                                                        total_rle, esValido_rle);
-
-    if (descomprimido_rle != nullptr && esValido_rle && total_rle > 0) {
-        if (buscarSecuencia(descomprimido_rle, total_rle, pista, sizePista)) {
-            cout << "Pista encontrada con RLE!" << endl;
-            cout << "Clave XOR: " << (int)claveXOR << " (0x" << hex << (int)claveXOR << dec << ")" << endl;
-            cout << "Bits de rotacion: " << rotacionBits << endl;
-            cout << "Contenido descomprimido (primeros 100 caracteres):" << endl;
-
-            int mostrar = (total_rle > 100) ? 100 : total_rle;
-            mostrarContenido(descomprimido_rle, mostrar);
-
-            // Guardar archivo descomprimido si se proporciona la ruta
-            if (rutaArchivoModificado != nullptr) {
-                if (crearArchivoConTexto(rutaArchivoModificado, descomprimido_rle, total_rle)) {
-                    cout << "Archivo descomprimido guardado en: " << rutaArchivoModificado << endl;
-                } else {
-                    cout << "Error al guardar el archivo descomprimido" << endl;
-                }
-            }
+    ContextoDescompresion local;
+    if (contexto == nullptr) {
+        contexto = &local;
+    }
 
-            delete[] descomprimido_rle;
-            return true;
+    SumideroArchivo* archivo = nullptr;
+    if (rutaArchivoModificado != nullptr) {
+        archivo = new SumideroArchivo(rutaArchivoModificado);
+        if (!archivo->abierto()) {
+            cout << "Error: no se pudo crear el archivo " << rutaArchivoModificado << endl;
+            delete archivo;
+            return false;
         }
-        delete[] descomprimido_rle;
     }
 
-    // Probar LZ78 con desencriptado integrado
-    int total_lz78 = 0;
-    bool esValido_lz78 = false;
-    unsigned char* descomprimido_lz78 = descompresionLZ78(data, size, claveXOR, rotacionBits,
-                                                          total_lz78, esValido_lz78);
-
-    if (descomprimido_lz78 != nullptr && esValido_lz78 && total_lz78 > 0) {
-        if (buscarSecuencia(descomprimido_lz78, total_lz78, pista, sizePista)) {
-            cout << "Pista encontrada con LZ78!" << endl;
-            cout << "Clave XOR: " << (int)claveXOR << " (0x" << hex << (int)claveXOR << dec << ")" << endl;
-            cout << "Bits de rotacion: " << rotacionBits << endl;
-            cout << "Contenido descomprimido (primeros 100 caracteres):" << endl;
-
-            int mostrar = (total_lz78 > 100) ? 100 : total_lz78;
-            mostrarContenido(descomprimido_lz78, mostrar);
-
-            // Guardar archivo descomprimido si se proporciona la ruta
-            if (rutaArchivoModificado != nullptr) {
-                if (crearArchivoConTexto(rutaArchivoModificado, descomprimido_lz78, total_lz78)) {
-                    cout << "Archivo descomprimido guardado en: " << rutaArchivoModificado << endl;
-                } else {
-                    cout << "Error al guardar el archivo descomprimido" << endl;
-                }
-            }
-
-            delete[] descomprimido_lz78;
-            return true;
-        }
-        delete[] descomprimido_lz78;
+    BusquedaPista variante(pista, sizePista);
+    ResultadoBusqueda resultado;
+    ConfirmarGanador(variante, data, size, claveXOR * 8 + rotacionBits, metodos, archivo, *contexto, resultado);
+    delete archivo;
+    if (!resultado.encontrado) {
+        return false;
+    }
+    if (!resultado.guardado) {
+        cout << "Error al guardar el archivo descomprimido " << rutaArchivoModificado << endl;
+        return false;
+    }
+    if (metodoEncontrado != nullptr) {
+        *metodoEncontrado = resultado.metodo;
     }
 
-    return false;
+    variante.mostrarGanador(resultado.indice, resultado.metodo);
+    MostrarComienzo(resultado.comienzo, rutaArchivoModificado);
+    return true;
 }
 
 /**
@@ -127,10 +778,12 @@ bool ProbarDescompresion(unsigned char* data, int size, unsigned char* pista, in
  * @param sizePista Tamaño en bytes de la pista.
  * @param pista Puntero a la secuencia de bytes a buscar.
  * @param rutaArchivoModificado Ruta donde guardar el archivo descomprimido (opcional, puede ser nullptr).
+ * @param numHilos Cantidad de hilos de busqueda (1 = secuencial, 0 = todos los nucleos).
  * @return true si encuentra los parametros, false en caso contrario.
  */
-bool BuscarParametros(unsigned char* data, int& nbits, int& claveK, int sizeEncriptado,
-                      int sizePista, unsigned char* pista, const char* rutaArchivoModificado) {
+bool BuscarParametros(const unsigned char* data, int& nbits, int& claveK, size_t sizeEncriptado,
+                      size_t sizePista, const unsigned char* pista, const char* rutaArchivoModificado,
+                      int numHilos) {
 
     // Validacion de entrada
     if (data == nullptr || pista == nullptr) {
@@ -145,43 +798,103 @@ bool BuscarParametros(unsigned char* data, int& nbits, int& claveK, int sizeEncr
 
     // Mostrar la pista que estamos buscando
     cout << "Pista a buscar: ";
-    mostrarContenido(pista, sizePista);
-    cout << "Iniciando busqueda de parametros..." << endl;
+    mostrarContenido(pista, (int)sizePista);
 
-    int intentos = 0;
+    BusquedaPista variante(pista, sizePista);
+    ResultadoBusqueda resultado;
+    if (BuscarEInformar(variante, data, sizeEncriptado, rutaArchivoModificado, numHilos, resultado)) {
+        claveK = resultado.indice / 8;
+        nbits = resultado.indice % 8;
+        return true;
+    }
 
-    // Busqueda exhaustiva con limites
-    for (int clave = 0; clave < 255 ; clave++) {
-        for (int bits = 0; bits <= 7 ; bits++) {
-            intentos++;
+    if (!resultado.encontrado) {
+        cout << "Posibles causas:" << endl;
+        cout << "- Los datos no estan en formato de ternas" << endl;
+        cout << "- La pista no existe en el texto descomprimido" << endl;
+        cout << "- Los algoritmos de descompresion necesitan ajustes" << endl;
+    }
+    return false;
+}
 
-            // Mostrar progreso cada 200 intentos para no saturar la consola
-            if (intentos % 100 == 0) {
-                cout << "Progreso: " << intentos << "/"
-                     << " (Clave: " << clave << ", Bits: " << bits << ")" << endl;
-            }
+/**
+ * @brief Busca los parametros de desencriptacion con un conjunto de pistas.
+ *
+ * Recorre los mismos candidatos y en el mismo orden que @ref BuscarParametros, pero cada
+ * candidato se acepta cuando aparecen `conjunto.requeridas()` pistas del conjunto.
+ *
+ * @param data Puntero a los datos encriptados.
+ * @param sizeEncriptado Tamaño de los datos.
+ * @param conjunto Conjunto de pistas ya preparado.
+ * @param rutaArchivoModificado Ruta donde guardar el archivo descomprimido (opcional).
+ * @param numHilos Cantidad de hilos de busqueda (1 = secuencial, 0 = todos los nucleos).
+ * @param nbits Salida: bits de rotacion encontrados.
+ * @param claveK Salida: clave XOR encontrada.
+ * @return true si encuentra los parametros, false en caso contrario.
+ */
+bool BuscarParametrosPistas(const unsigned char* data, size_t sizeEncriptado, const ConjuntoPistas& conjunto,
+                            const char* rutaArchivoModificado, int numHilos, int& nbits, int& claveK) {
+    if (data == nullptr || conjunto.size() == 0 || !conjunto.preparado()) {
+        cout << "Error: datos nulos o sin pistas" << endl;
+        return false;
+    }
 
-            // Probar descompresion directamente con los parametros actuales
-            // No necesitamos copiar ni modificar los datos originales
-            if (ProbarDescompresion(data, sizeEncriptado, pista, sizePista,
-                                    (unsigned char)clave, bits, rutaArchivoModificado)) {
-                cout << "Parametros encontrados!" << endl;
-                cout << "Total de intentos realizados: " << intentos << endl;
-
-                // Guardar los parametros encontrados
-                nbits = bits;
-                claveK = clave;
-                return true;
-            }
-        }
+    if (sizeEncriptado % 3 != 0) {
+        cout << "Advertencia: El tamaño no es multiplo de 3 (formato de terna)" << endl;
     }
 
-    // Si llegamos aqui, no se encontraron parametros validos
-    cout << "No se encontraron parametros validos despues de " << intentos << " intentos." << endl;
-    cout << "Posibles causas:" << endl;
-    cout << "- Los datos no estan en formato de ternas" << endl;
-    cout << "- La pista no existe en el texto descomprimido" << endl;
-    cout << "- Los algoritmos de descompresion necesitan ajustes" << endl;
+    cout << "Pistas a buscar: " << conjunto.size() << " (se aceptan con " << conjunto.requeridas()
+         << ")" << endl;
 
-    return false;
+    BusquedaConjunto variante(conjunto);
+    ResultadoBusqueda resultado;
+    if (!BuscarEInformar(variante, data, sizeEncriptado, rutaArchivoModificado, numHilos, resultado)) {
+        return false;
+    }
+    claveK = resultado.indice / 8;
+    nbits = resultado.indice % 8;
+    return true;
+}
+
+/**
+ * @brief Busca la clave de un archivo cifrado con cualquier esquema de cifrado.
+ *
+ * Los candidatos se recorren por indice del esquema (ver @ref EsquemaCifrado::parametros);
+ * el filtrado previo de @ref PrepararMetodosEsquema deja sin metodos a casi todos, que
+ * se saltean sin descomprimir.
+ *
+ * @param data Puntero a los datos encriptados.
+ * @param sizeEncriptado Tamaño de los datos.
+ * @param pista Secuencia a buscar.
+ * @param sizePista Tamaño de la pista.
+ * @param esquema Esquema de cifrado con el que se generaron los datos.
+ * @param rutaArchivoModificado Ruta donde guardar el archivo descomprimido (opcional).
+ * @param numHilos Cantidad de hilos de busqueda (1 = secuencial, 0 = todos los nucleos).
+ * @param encontrados Salida: parametros del candidato ganador.
+ * @return true si encuentra los parametros, false en caso contrario.
+ */
+bool BuscarParametrosCifrado(const unsigned char* data, size_t sizeEncriptado, const unsigned char* pista,
+                             size_t sizePista, const EsquemaCifrado& esquema, const char* rutaArchivoModificado,
+                             int numHilos, ParametrosCifrado& encontrados) {
+    if (data == nullptr || pista == nullptr || sizePista == 0) {
+        cout << "Error: datos nulos" << endl;
+        return false;
+    }
+
+    if (sizeEncriptado % 3 != 0) {
+        cout << "Advertencia: El tamaño no es multiplo de 3 (formato de terna)" << endl;
+    }
+
+    cout << "Esquema de cifrado: " << esquema.nombre << " (" << esquema.descripcion << ", "
+         << esquema.totalCandidatos() << " candidatos)" << endl;
+    cout << "Pista a buscar: ";
+    mostrarContenido(pista, (int)sizePista);
+
+    BusquedaEsquema variante(pista, sizePista, esquema);
+    ResultadoBusqueda resultado;
+    if (!BuscarEInformar(variante, data, sizeEncriptado, rutaArchivoModificado, numHilos, resultado)) {
+        return false;
+    }
+    encontrados = ClaveCifrado(esquema, resultado.indice).parametros();
+    return true;
 }
@@ -0,0 +1,386 @@
+#ifndef BUSQUEDAPARAMETROS_H
+#define BUSQUEDAPARAMETROS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "BuscadorPista.h"
+#include "CacheParametros.h"
+#include "ConjuntoPistas.h"
+#include "ContextoDescompresion.h"
+#include "EsquemasCifrado.h"
+#include "Metricas.h"
+#include "ProgresoBusqueda.h"
+#include "Sumideros.h"
+
+/**
+ * @brief Función para buscar una secuencia dentro de otra usando arreglos.
+ *
+ * Busca si la secuencia `pista` está contenida dentro de `texto` con un
+ * @ref BuscadorPista temporal. Para buscar la misma pista en muchos textos
+ * conviene crear el @ref BuscadorPista una sola vez.
+ *
+ * @param texto Puntero al arreglo donde buscar.
+ * @param sizeTexto Tamaño del arreglo de texto.
+ * @param pista Puntero a la secuencia a buscar.
+ * @param sizePista Tamaño de la secuencia a buscar.
+ * @return true si encuentra la secuencia, false en caso contrario.
+ */
+bool buscarSecuencia(unsigned char* texto, int sizeTexto, unsigned char* pista, int sizePista);
+
+/**
+ * @brief Descomprime con RLE y luego LZ78 y retorna el primer resultado que contiene la pista.
+ *
+ * No imprime ni escribe archivos, por lo que es segura de llamar desde varios hilos.
+ *
+ * @param data Puntero al arreglo de datos encriptados y comprimidos.
+ * @param size Tamaño en bytes del arreglo de datos.
+ * @param buscador Buscador preparado con la pista.
+ * @param claveXOR Clave XOR para desencriptar.
+ * @param rotacionBits Número de bits para rotar a la derecha (0-7).
+ * @param total Referencia donde se almacena el tamaño del texto retornado.
+ * @param metodo Referencia donde se almacena el @ref MetodoCompresion que contiene la pista.
+ * @param metodos Máscara de métodos a probar (combinación de METODO_RLE y METODO_LZ78).
+ * @param contexto Memoria de trabajo del hilo (opcional); se reinicia antes de cada método.
+ * @return Texto descomprimido (liberar con `delete[]`), o nullptr si la pista no aparece.
+ */
+unsigned char* DescomprimirConPista(const unsigned char* data, size_t size, const BuscadorPista& buscador,
+                                    unsigned char claveXOR, int rotacionBits, size_t& total, int& metodo,
+                                    int metodos = METODOS_TODOS, ContextoDescompresion* contexto = nullptr);
+
+/**
+ * @brief Verifica un candidato (clave, bits) sin imprimir ni guardar resultados.
+ *
+ * Con un @ref ContextoDescompresion la verificación no reserva memoria: el contexto
+ * se reinicia antes de cada método y se reutiliza.
+ *
+ * @return El @ref MetodoCompresion con el que aparece la pista, o METODO_NINGUNO.
+ */
+int VerificarCandidato(const unsigned char* data, size_t size, const BuscadorPista& buscador,
+                       unsigned char claveXOR, int rotacionBits, int metodos = METODOS_TODOS,
+                       ContextoDescompresion* contexto = nullptr);
+
+/**
+ * @brief Como @ref DescomprimirConPista, para un candidato de cualquier esquema de cifrado.
+ */
+unsigned char* DescomprimirConPista(const unsigned char* data, size_t size, const BuscadorPista& buscador,
+                                    const ClaveCifrado& cifrado, size_t& total, int& metodo,
+                                    int metodos = METODOS_TODOS, ContextoDescompresion* contexto = nullptr);
+
+/**
+ * @brief Como @ref VerificarCandidato, para un candidato de cualquier esquema de cifrado.
+ */
+int VerificarCandidato(const unsigned char* data, size_t size, const BuscadorPista& buscador,
+                       const ClaveCifrado& cifrado, int metodos = METODOS_TODOS,
+                       ContextoDescompresion* contexto = nullptr);
+
+/**
+ * @brief Como @ref DescomprimirConPista, pero acepta el texto según el criterio de un conjunto de pistas.
+ *
+ * @param finales Arreglo de `conjunto.size()` posiciones donde se anota el fin de la primera
+ *                aparición de cada pista en el texto retornado (ver @ref ConjuntoPistas::buscarEn).
+ * @return Texto descomprimido (liberar con `delete[]`), o nullptr si no se cumple el criterio.
+ */
+unsigned char* DescomprimirConPista(const unsigned char* data, size_t size, const ConjuntoPistas& conjunto,
+                                    unsigned char claveXOR, int rotacionBits, size_t& total, int& metodo,
+                                    uint64_t* finales, int metodos = METODOS_TODOS,
+                                    ContextoDescompresion* contexto = nullptr);
+
+/**
+ * @brief Verifica un candidato contra un conjunto de pistas en una sola pasada por su salida.
+ *
+ * La descompresión se corta apenas aparecen las pistas requeridas.
+ *
+ * @return El @ref MetodoCompresion con el que se cumple el criterio, o METODO_NINGUNO.
+ */
+int VerificarCandidato(const unsigned char* data, size_t size, const ConjuntoPistas& conjunto,
+                       unsigned char claveXOR, int rotacionBits, int metodos = METODOS_TODOS,
+                       ContextoDescompresion* contexto = nullptr);
+
+/**
+ * @brief Intenta descomprimir los datos usando diferentes algoritmos de compresión
+ *        con parámetros de desencriptación integrados y busca la pista en el resultado.
+ *
+ * Esta función aplica desencriptación (XOR + rotación) y descompresión de manera integrada,
+ * probando tanto RLE como LZ78. Si encuentra la pista en algún resultado,
+ * opcionalmente guarda el archivo descomprimido: el texto se escribe a medida que se
+ * descomprime en un @ref SumideroArchivo, sin pasar por un buffer del tamaño del texto.
+ *
+ * @param data Puntero al arreglo de datos encriptados y comprimidos.
+ * @param size Tamaño en bytes del arreglo de datos.
+ * @param pista Puntero al arreglo con la secuencia a buscar.
+ * @param sizePista Tamaño en bytes de la pista.
+ * @param claveXOR Clave XOR para desencriptar.
+ * @param rotacionBits Número de bits para rotar a la derecha (0-7).
+ * @param rutaArchivoModificado Ruta donde guardar el resultado exitoso (opcional, puede ser nullptr).
+ * @param metodos Máscara de métodos a probar (combinación de METODO_RLE y METODO_LZ78).
+ * @param contexto Memoria de trabajo reutilizable (opcional, ver @ref ContextoDescompresion).
+ * @param metodoEncontrado Salida opcional: método con el que apareció la pista.
+ * @return true si la pista es encontrada en alguna de las descompresiones y el archivo (si se
+ *         pidió) quedó guardado, false en caso contrario.
+ */
+bool ProbarDescompresion(const unsigned char* data, size_t size, const unsigned char* pista, size_t sizePista,
+                         unsigned char claveXOR, int rotacionBits, const char* rutaArchivoModificado,
+                         int metodos = METODOS_TODOS, ContextoDescompresion* contexto = nullptr,
+                         int* metodoEncontrado = nullptr);
+
+/**
+ * @brief Busca los parámetros correctos de desencriptación (clave XOR y bits de rotación).
+ *
+ * Esta función prueba todas las combinaciones posibles de:
+ * - Claves XOR (0 a 254)
+ * - Rotaciones de bits (0 a 7)
+ *
+ * Para cada combinación, intenta descomprimir directamente los datos con los parámetros
+ * integrados y busca la pista en el resultado. Utiliza las versiones optimizadas de
+ * las funciones de descompresión que incluyen validación temprana.
+ *
+ * Si encuentra coincidencia, guarda los parámetros en `nbits` y `claveK` y
+ * opcionalmente guarda el archivo descomprimido.
+ *
+ * @param data Puntero a los datos encriptados y comprimidos.
+ * @param nbits Variable de salida donde se almacenará la cantidad de bits de rotación encontrada.
+ * @param claveK Variable de salida donde se almacenará la clave XOR encontrada.
+ * @param sizeEncriptado Tamaño en bytes del arreglo de datos encriptados.
+ * @param sizePista Tamaño en bytes de la pista.
+ * @param pista Puntero a la secuencia de bytes a buscar.
+ * @param rutaArchivoModificado Ruta donde guardar el archivo descomprimido (opcional, puede ser nullptr).
+ * @param numHilos Cantidad de hilos de búsqueda: 1 recorre los candidatos en orden en el hilo actual,
+ *                 0 usa todos los núcleos disponibles (ver @ref BuscarParametrosParalelo).
+ * @return true si encuentra los parámetros correctos, false en caso contrario.
+ */
+bool BuscarParametros(const unsigned char* data, int& nbits, int& claveK, size_t sizeEncriptado,
+                      size_t sizePista, const unsigned char* pista, const char* rutaArchivoModificado,
+                      int numHilos = 1);
+
+/**
+ * @brief Busca en paralelo el menor candidato (clave, bits) cuya descompresión contiene la pista.
+ *
+ * Reparte los @ref TOTAL_CANDIDATOS en rangos contiguos, uno por hilo. Un hilo sin trabajo
+ * roba la mitad pendiente del rango más cargado. Al encontrar la pista se cancelan todos los
+ * candidatos de índice mayor, pero se terminan los menores, así el resultado es el mismo que
+ * el del recorrido secuencial.
+ *
+ * @param data Puntero a los datos encriptados y comprimidos.
+ * @param size Tamaño en bytes de los datos.
+ * @param buscador Buscador preparado con la pista, compartido por todos los hilos.
+ * @param metodos Máscara de métodos por candidato (@ref TOTAL_CANDIDATOS posiciones),
+ *                preparada con @ref PrepararMetodosCandidatos.
+ * @param numHilos Cantidad de hilos (0 o negativo usa los núcleos disponibles).
+ * @param nbits Variable de salida con los bits de rotación encontrados.
+ * @param claveK Variable de salida con la clave XOR encontrada.
+ * @param intentos Variable de salida con los candidatos evaluados hasta el ganador inclusive, igual que en
+ *                 la búsqueda secuencial.
+ * @param contexto Memoria de trabajo del hilo que llama (opcional); los demás hilos usan una propia.
+ * @param progreso Avance de la búsqueda (opcional): se saltean los candidatos ya descartados
+ *                 y se marcan los que se descartan (ver @ref ProgresoBusqueda).
+ * @return true si encuentra los parámetros, false en caso contrario.
+ */
+bool BuscarParametrosParalelo(const unsigned char* data, size_t size, const BuscadorPista& buscador,
+                              unsigned char* metodos, int numHilos, int& nbits, int& claveK, int& intentos,
+                              ContextoDescompresion* contexto = nullptr, ProgresoBusqueda* progreso = nullptr);
+
+/**
+ * @brief Como la búsqueda paralela con una pista, aceptando según el criterio del conjunto.
+ */
+bool BuscarParametrosParalelo(const unsigned char* data, size_t size, const ConjuntoPistas& conjunto,
+                              unsigned char* metodos, int numHilos, int& nbits, int& claveK, int& intentos,
+                              ContextoDescompresion* contexto = nullptr,
+                              ProgresoBusqueda* progreso = nullptr);
+
+/**
+ * @brief Busca los parámetros con un conjunto de pistas e informa cuáles aparecen y dónde.
+ *
+ * Recorre los candidatos en el mismo orden que @ref BuscarParametros. Del candidato ganador
+ * se imprime cada pista con la posición de su primera aparición (o que no aparece).
+ *
+ * @param data Puntero a los datos encriptados y comprimidos.
+ * @param sizeEncriptado Tamaño en bytes de los datos.
+ * @param conjunto Conjunto de pistas ya preparado con su criterio de aceptación.
+ * @param rutaArchivoModificado Ruta donde guardar el archivo descomprimido (opcional, puede ser nullptr).
+ * @param numHilos Cantidad de hilos de búsqueda (1 = secuencial, 0 = todos los núcleos).
+ * @param nbits Variable de salida con los bits de rotación encontrados.
+ * @param claveK Variable de salida con la clave XOR encontrada.
+ * @return true si encuentra los parámetros, false en caso contrario.
+ */
+bool BuscarParametrosPistas(const unsigned char* data, size_t sizeEncriptado, const ConjuntoPistas& conjunto,
+                            const char* rutaArchivoModificado, int numHilos, int& nbits, int& claveK);
+
+/**
+ * @brief Busca en paralelo el menor candidato de un @ref EsquemaCifrado cuya descompresión
+ *        contiene la pista.
+ *
+ * Mismo reparto y robo de rangos que @ref BuscarParametrosParalelo, sobre los
+ * `esquema.totalCandidatos()` índices del esquema.
+ *
+ * @param metodos Máscara por candidato preparada con @ref PrepararMetodosEsquema.
+ * @param indice Variable de salida con el índice del candidato (ver @ref EsquemaCifrado::parametros).
+ * @return true si algún candidato contiene la pista.
+ */
+bool BuscarParametrosEsquema(const unsigned char* data, size_t size, const BuscadorPista& buscador,
+                             const EsquemaCifrado& esquema, unsigned char* metodos, int numHilos,
+                             int& indice, int& intentos, ContextoDescompresion* contexto = nullptr,
+                             ProgresoBusqueda* progreso = nullptr);
+
+/**
+ * @brief Busca la clave de un archivo cifrado con cualquier @ref EsquemaCifrado.
+ *
+ * Recorre los candidatos del esquema en orden de índice (o en paralelo, con el mismo
+ * resultado), imprime la clave encontrada y guarda el texto descomprimido.
+ *
+ * @param encontrados Variable de salida con los parámetros del candidato ganador.
+ * @return true si encuentra los parámetros, false en caso contrario.
+ */
+bool BuscarParametrosCifrado(const unsigned char* data, size_t sizeEncriptado, const unsigned char* pista,
+                             size_t sizePista, const EsquemaCifrado& esquema, const char* rutaArchivoModificado,
+                             int numHilos, ParametrosCifrado& encontrados);
+
+/**
+ * @brief Lo que distingue a una búsqueda de parámetros: qué candidatos se recorren y con qué
+ *        criterio se acepta el texto de cada uno.
+ *
+ * El recorrido es común a todas (@ref BuscarGanador): caché de parámetros, puntos de control,
+ * búsqueda en serie o en paralelo y descompresión del ganador.
+ */
+class VarianteBusqueda {
+public:
+    virtual ~VarianteBusqueda() {}
+
+    /** @brief Cantidad de candidatos (índices 0 a totalCandidatos() - 1). */
+    virtual int totalCandidatos() const;
+    /** @brief Parámetros de cifrado del candidato `indice`. */
+    virtual ClaveCifrado cifrado(int indice) const;
+    /** @brief Clave y bits con los que se informa el avance en el candidato `indice`. */
+    virtual void posicion(int indice, int& clave, int& bits) const;
+    /** @brief Máscara de métodos de cada candidato (@ref PrepararMetodosCandidatos). */
+    virtual void prepararMetodos(const unsigned char* data, size_t size, unsigned char* metodos) const;
+
+    /** @brief Huella de los datos y del criterio, para la caché y los puntos de control. */
+    virtual HuellaBusqueda huella(const unsigned char* data, size_t size) const = 0;
+    /** @brief Verifica un candidato sin efectos secundarios (ver @ref VerificarCandidato). */
+    virtual int verificar(const unsigned char* data, size_t size, int indice, int metodos,
+                          ContextoDescompresion* contexto) const = 0;
+    /** @brief Búsqueda paralela, con el mismo ganador y los mismos intentos que la secuencial. */
+    virtual bool buscarParalelo(const unsigned char* data, size_t size, unsigned char* metodos, int numHilos,
+                                int& indice, int& intentos, ContextoDescompresion* contexto,
+                                ProgresoBusqueda* progreso) const = 0;
+    /** @brief Sumidero que recibe el texto del ganador para confirmarlo (se reinicia con `descartar`). */
+    virtual Sumidero& criterio() = 0;
+    /** @brief Indica si el texto que recibió @ref criterio se acepta. */
+    virtual bool cumplido() const = 0;
+    /** @brief Muestra los parámetros del ganador `indice`, encontrado con `metodo`. */
+    virtual void mostrarGanador(int indice, int metodo) const = 0;
+};
+
+/**
+ * @brief Búsqueda de (clave, bits) con una sola pista.
+ */
+class BusquedaPista : public VarianteBusqueda {
+public:
+    BusquedaPista(const unsigned char* pista, size_t sizePista);
+
+    HuellaBusqueda huella(const unsigned char* data, size_t size) const override;
+    int verificar(const unsigned char* data, size_t size, int indice, int metodos,
+                  ContextoDescompresion* contexto) const override;
+    bool buscarParalelo(const unsigned char* data, size_t size, unsigned char* metodos, int numHilos, int& indice,
+                        int& intentos, ContextoDescompresion* contexto, ProgresoBusqueda* progreso) const override;
+    Sumidero& criterio() override { return coincidencia; }
+    bool cumplido() const override { return coincidencia.encontrada(); }
+    void mostrarGanador(int indice, int metodo) const override;
+
+protected:
+    const unsigned char* pista;
+    size_t sizePista;
+    BuscadorPista buscador;
+    SumideroCoincidencia coincidencia;
+};
+
+/**
+ * @brief Búsqueda de la clave de cualquier @ref EsquemaCifrado con una sola pista.
+ */
+class BusquedaEsquema : public BusquedaPista {
+public:
+    BusquedaEsquema(const unsigned char* pista, size_t sizePista, const EsquemaCifrado& esquema);
+
+    int totalCandidatos() const override;
+    ClaveCifrado cifrado(int indice) const override;
+    void posicion(int indice, int& clave, int& bits) const override;
+    void prepararMetodos(const unsigned char* data, size_t size, unsigned char* metodos) const override;
+    HuellaBusqueda huella(const unsigned char* data, size_t size) const override;
+    int verificar(const unsigned char* data, size_t size, int indice, int metodos,
+                  ContextoDescompresion* contexto) const override;
+    bool buscarParalelo(const unsigned char* data, size_t size, unsigned char* metodos, int numHilos, int& indice,
+                        int& intentos, ContextoDescompresion* contexto, ProgresoBusqueda* progreso) const override;
+    void mostrarGanador(int indice, int metodo) const override;
+
+private:
+    const EsquemaCifrado& esquema;
+};
+
+/**
+ * @brief Búsqueda de (clave, bits) con un @ref ConjuntoPistas ya preparado.
+ *
+ * En el texto del ganador las pistas se buscan hasta el final, así que @ref encontradas
+ * cuenta todas las que aparecen y no solo las requeridas.
+ */
+class BusquedaConjunto : public VarianteBusqueda {
+public:
+    explicit BusquedaConjunto(const ConjuntoPistas& conjunto);
+
+    HuellaBusqueda huella(const unsigned char* data, size_t size) const override;
+    int verificar(const unsigned char* data, size_t size, int indice, int metodos,
+                  ContextoDescompresion* contexto) const override;
+    bool buscarParalelo(const unsigned char* data, size_t size, unsigned char* metodos, int numHilos, int& indice,
+                        int& intentos, ContextoDescompresion* contexto, ProgresoBusqueda* progreso) const override;
+    Sumidero& criterio() override { return pistas; }
+    bool cumplido() const override { return pistas.cumplido(); }
+    void mostrarGanador(int indice, int metodo) const override;
+
+    /** @brief Pistas distintas que aparecen en el texto del ganador. */
+    int encontradas() const { return pistas.encontradas(); }
+
+private:
+    const ConjuntoPistas& conjunto;
+    std::vector<uint64_t> finales;
+    SumideroPistas pistas;
+};
+
+/**
+ * @brief Resultado de @ref BuscarGanador.
+ */
+struct ResultadoBusqueda {
+    bool encontrado = false;      // Algún candidato cumple el criterio
+    bool guardado = false;        // El texto del ganador quedó completo en el destino
+    bool desdeCache = false;      // El ganador salió de la caché y se comprobó con una descompresión
+    int indice = 0;
+    int metodo = METODO_NINGUNO;
+    int intentos = 0;             // Candidatos evaluados hasta el ganador inclusive (1 desde la caché)
+    std::string comienzo;         // Primeros caracteres del texto del ganador
+};
+
+/**
+ * @brief Recorrido común a todas las búsquedas de parámetros.
+ *
+ * Primero comprueba el ganador de la caché (@ref ConsultarCacheParametros) con una sola
+ * descompresión. Si no hay, recorre los candidatos en orden (`numHilos` = 1) o en paralelo,
+ * salteando los ya descartados según los puntos de control (@ref ProgresoBusqueda). El
+ * ganador se descomprime una sola vez: el texto va a la vez al criterio de la variante, que
+ * lo confirma, y a `destino`, que se finaliza solo si el criterio se cumple (si no, se
+ * descarta). El ganador confirmado se guarda en la caché.
+ *
+ * @param variante Candidatos y criterio de aceptación.
+ * @param numHilos Hilos de búsqueda (1 = secuencial, 0 = todos los núcleos).
+ * @param rutaSalida Archivo de salida, junto al que se guardan los puntos de control (opcional).
+ * @param destino Sumidero del texto del ganador (opcional): un @ref SumideroArchivo o un
+ *                @ref SumideroMemoria.
+ * @param contexto Memoria de trabajo del hilo que llama.
+ * @param informar true para mostrar el comienzo de la búsqueda y su avance.
+ * @param resultado Salida con el ganador y los intentos.
+ * @return true si hubo ganador y su texto quedó en `destino`.
+ */
+bool BuscarGanador(VarianteBusqueda& variante, const unsigned char* data, size_t size, int numHilos,
+                   const char* rutaSalida, Sumidero* destino, ContextoDescompresion& contexto, bool informar,
+                   ResultadoBusqueda& resultado);
+
+#endif // BUSQUEDAPARAMETROS_H
@@ -0,0 +1,270 @@
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+#include "Alfabeto.h"
+#include "CacheParametros.h"
+#include "ConjuntoPistas.h"
+#include "Metricas.h"
+using namespace std;
+
+// ---------------------------------------------------------------------------
+// HuellaBytes (xxHash64)
+// ---------------------------------------------------------------------------
+
+static const uint64_t PRIMO1 = 0x9E3779B185EBCA87ULL;
+static const uint64_t PRIMO2 = 0xC2B2AE3D27D4EB4FULL;
+static const uint64_t PRIMO3 = 0x165667B19E3779F9ULL;
+static const uint64_t PRIMO4 = 0x85EBCA77C2B2AE63ULL;
+static const uint64_t PRIMO5 = 0x27D4EB2F165667C5ULL;
+
+static inline uint64_t Rotar64(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t Leer64(const unsigned char* p) {
+    uint64_t valor;
+    memcpy(&valor, p, sizeof(valor));
+    return valor;
+}
+
+static inline uint32_t Leer32(const unsigned char* p) {
+    uint32_t valor;
+    memcpy(&valor, p, sizeof(valor));
+    return valor;
+}
+
+static inline uint64_t Ronda(uint64_t acumulador, uint64_t entrada) {
+    acumulador += entrada * PRIMO2;
+    acumulador = Rotar64(acumulador, 31);
+    return acumulador * PRIMO1;
+}
+
+static inline uint64_t Combinar(uint64_t acumulador, uint64_t carril) {
+    acumulador ^= Ronda(0, carril);
+    return acumulador * PRIMO1 + PRIMO4;
+}
+
+uint64_t HuellaBytes(const unsigned char* datos, size_t size, uint64_t semilla) {
+    const unsigned char* p = datos;
+    const unsigned char* fin = datos + size;
+    uint64_t h;
+
+    if (size >= 32) {
+        // Cuatro carriles independientes: el procesador los avanza en paralelo
+        uint64_t v1 = semilla + PRIMO1 + PRIMO2;
+        uint64_t v2 = semilla + PRIMO2;
+        uint64_t v3 = semilla;
+        uint64_t v4 = semilla - PRIMO1;
+        const unsigned char* limite = fin - 32;
+        do {
+            v1 = Ronda(v1, Leer64(p));
+            v2 = Ronda(v2, Leer64(p + 8));
+            v3 = Ronda(v3, Leer64(p + 16));
+            v4 = Ronda(v4, Leer64(p + 24));
+            p += 32;
+        } while (p <= limite);
+
+        h = Rotar64(v1, 1) + Rotar64(v2, 7) + Rotar64(v3, 12) + Rotar64(v4, 18);
+        h = Combinar(h, v1);
+        h = Combinar(h, v2);
+        h = Combinar(h, v3);
+        h = Combinar(h, v4);
+    } else {
+        h = semilla + PRIMO5;
+    }
+    h += (uint64_t)size;
+
+    for (; p + 8 <= fin; p += 8) {
+        h ^= Ronda(0, Leer64(p));
+        h = Rotar64(h, 27) * PRIMO1 + PRIMO4;
+    }
+    if (p + 4 <= fin) {
+        h ^= (uint64_t)Leer32(p) * PRIMO1;
+        h = Rotar64(h, 23) * PRIMO2 + PRIMO3;
+        p += 4;
+    }
+    for (; p < fin; p++) {
+        h ^= (*p) * PRIMO5;
+        h = Rotar64(h, 11) * PRIMO1;
+    }
+
+    h ^= h >> 33;
+    h *= PRIMO2;
+    h ^= h >> 29;
+    h *= PRIMO3;
+    h ^= h >> 32;
+    return h;
+}
+
+// ---------------------------------------------------------------------------
+// Huellas de búsqueda
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Semilla común: esquema de cifrado y alfabeto activo, que también deciden el ganador.
+ */
+static uint64_t SemillaBusqueda(const char* esquema) {
+    const Alfabeto& alfabeto = AlfabetoActivo();
+    uint64_t semilla = HuellaBytes(reinterpret_cast<const unsigned char*>(esquema), strlen(esquema));
+    semilla = HuellaBytes(alfabeto.fila(0), 16, semilla);
+    return HuellaBytes(alfabeto.fila(1), 16, semilla);
+}
+
+HuellaBusqueda CalcularHuellaBusqueda(const unsigned char* data, size_t size, const unsigned char* pista,
+                                      size_t sizePista, const char* esquema) {
+    HuellaBusqueda huella;
+    huella.datos = HuellaBytes(data, size);
+    huella.tamaño = size;
+    huella.pistas = HuellaBytes(pista, sizePista, SemillaBusqueda(esquema));
+    return huella;
+}
+
+HuellaBusqueda CalcularHuellaBusqueda(const unsigned char* data, size_t size, const ConjuntoPistas& conjunto) {
+    HuellaBusqueda huella;
+    huella.datos = HuellaBytes(data, size);
+    huella.tamaño = size;
+
+    // Se distingue de la búsqueda con una sola pista aunque el conjunto tenga una
+    static const unsigned char MARCA_CONJUNTO[] = "conjunto";
+    uint64_t h = HuellaBytes(MARCA_CONJUNTO, sizeof(MARCA_CONJUNTO) - 1, SemillaBusqueda("xor-rotr"));
+    for (size_t i = 0; i < conjunto.size(); i++) {
+        const vector<unsigned char>& pista = conjunto.pista(i);
+        h = HuellaBytes(pista.data(), pista.size(), h);
+    }
+    int requeridas = conjunto.requeridas();
+    huella.pistas = HuellaBytes(reinterpret_cast<const unsigned char*>(&requeridas), sizeof(requeridas), h);
+    return huella;
+}
+
+// ---------------------------------------------------------------------------
+// Caché persistente
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Ganador guardado para una huella.
+ */
+struct EntradaCache {
+    int indice;
+    int metodo;
+};
+
+struct IgualHuella {
+    bool operator()(const HuellaBusqueda& a, const HuellaBusqueda& b) const {
+        return a.datos == b.datos && a.tamaño == b.tamaño && a.pistas == b.pistas;
+    }
+};
+
+struct DispersarHuella {
+    size_t operator()(const HuellaBusqueda& h) const {
+        return (size_t)(h.datos ^ Rotar64(h.pistas, 17) ^ (h.tamaño * PRIMO3));
+    }
+};
+
+static mutex cerrojoCache;
+static bool cacheActiva = false;
+static string rutaCache;
+static unordered_map<HuellaBusqueda, EntradaCache, DispersarHuella, IgualHuella> entradasCache;
+
+static const char* NombreMetodo(int metodo) {
+    return (metodo == METODO_RLE) ? "rle" : (metodo == METODO_LZ78) ? "lz78" : "-";
+}
+
+/**
+ * @brief Agrega una línea al final del archivo de la caché, con una sola escritura.
+ */
+static void AgregarLinea(const HuellaBusqueda& huella, int indice, int metodo) {
+    char linea[96];
+    int largo = snprintf(linea, sizeof(linea), "%016llx %llu %016llx %d %s\n",
+                         (unsigned long long)huella.datos, (unsigned long long)huella.tamaño,
+                         (unsigned long long)huella.pistas, indice, NombreMetodo(metodo));
+    ofstream archivo(rutaCache, ios::binary | ios::app);
+    if (archivo.is_open() && largo > 0) {
+        archivo.write(linea, largo);
+    }
+}
+
+bool AbrirCacheParametros(const char* ruta) {
+    lock_guard<mutex> lock(cerrojoCache);
+    entradasCache.clear();
+    cacheActiva = false;
+
+    ifstream entrada(ruta);
+    if (entrada.is_open()) {
+        string linea;
+        while (getline(entrada, linea)) {
+            if (linea.empty() || linea[0] == '#') {
+                continue;
+            }
+            istringstream campos(linea);
+            HuellaBusqueda huella;
+            int indice = 0;
+            string metodo;
+            if (!(campos >> hex >> huella.datos >> dec >> huella.tamaño >> hex >> huella.pistas
+                         >> dec >> indice >> metodo)) {
+                continue;  // Línea cortada por una escritura interrumpida
+            }
+            if (metodo == "rle" || metodo == "lz78") {
+                entradasCache[huella] = { indice, (metodo == "rle") ? METODO_RLE : METODO_LZ78 };
+            } else {
+                entradasCache.erase(huella);
+            }
+        }
+    } else {
+        ofstream nuevo(ruta, ios::binary | ios::app);
+        if (!nuevo.is_open()) {
+            cout << "No se pudo abrir ni crear la cache " << ruta << endl;
+            return false;
+        }
+        nuevo << "# Cache de parametros: huella tamano pistas indice metodo\n";
+    }
+
+    rutaCache = ruta;
+    cacheActiva = true;
+    return true;
+}
+
+bool CacheParametrosActiva() {
+    lock_guard<mutex> lock(cerrojoCache);
+    return cacheActiva;
+}
+
+bool ConsultarCacheParametros(const HuellaBusqueda& huella, int totalCandidatos, int& indice, int& metodo) {
+    lock_guard<mutex> lock(cerrojoCache);
+    if (!cacheActiva) {
+        return false;
+    }
+    auto it = entradasCache.find(huella);
+    if (it == entradasCache.end() || it->second.indice < 0 || it->second.indice >= totalCandidatos) {
+        return false;
+    }
+    indice = it->second.indice;
+    metodo = it->second.metodo;
+    return true;
+}
+
+void GuardarCacheParametros(const HuellaBusqueda& huella, int indice, int metodo) {
+    if (metodo != METODO_RLE && metodo != METODO_LZ78) {
+        return;
+    }
+    lock_guard<mutex> lock(cerrojoCache);
+    if (!cacheActiva) {
+        return;
+    }
+    auto it = entradasCache.find(huella);
+    if (it != entradasCache.end() && it->second.indice == indice && it->second.metodo == metodo) {
+        return;  // Ya está en el archivo
+    }
+    entradasCache[huella] = { indice, metodo };
+    AgregarLinea(huella, indice, metodo);
+}
+
+void OlvidarCacheParametros(const HuellaBusqueda& huella) {
+    lock_guard<mutex> lock(cerrojoCache);
+    if (cacheActiva && entradasCache.erase(huella) > 0) {
+        AgregarLinea(huella, -1, METODO_NINGUNO);
+    }
+}
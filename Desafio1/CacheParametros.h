@@ -0,0 +1,67 @@
+#ifndef CACHEPARAMETROS_H
+#define CACHEPARAMETROS_H
+
+#include <cstddef>
+#include <cstdint>
+#include "ConjuntoPistas.h"
+
+/**
+ * @brief Huella de 64 bits de un bloque de bytes (el algoritmo de xxHash64).
+ *
+ * Procesa 32 bytes por paso en cuatro acumuladores independientes, así que recorrer
+ * un encriptado grande cuesta mucho menos que descomprimir un solo candidato.
+ */
+uint64_t HuellaBytes(const unsigned char* datos, size_t size, uint64_t semilla = 0);
+
+/**
+ * @brief Identifica una búsqueda por su contenido: el encriptado y todo lo que decide el ganador.
+ *
+ * Dos búsquedas con la misma huella eligen el mismo candidato, sin importar la ruta
+ * de los archivos.
+ */
+struct HuellaBusqueda {
+    uint64_t datos;     // Huella del encriptado
+    uint64_t tamaño;    // Tamaño del encriptado
+    uint64_t pistas;    // Huella de las pistas, el criterio, el esquema y el alfabeto activo
+};
+
+/** @brief Huella de una búsqueda con una sola pista y el esquema dado (por nombre). */
+HuellaBusqueda CalcularHuellaBusqueda(const unsigned char* data, size_t size, const unsigned char* pista,
+                                      size_t sizePista, const char* esquema = "xor-rotr");
+
+/** @brief Huella de una búsqueda con un conjunto de pistas (incluye el orden y @ref ConjuntoPistas::requeridas). */
+HuellaBusqueda CalcularHuellaBusqueda(const unsigned char* data, size_t size, const ConjuntoPistas& conjunto);
+
+/**
+ * @brief Activa la caché de parámetros guardada en `ruta` y carga sus entradas.
+ *
+ * El archivo tiene una línea por búsqueda resuelta: las tres partes de la huella en
+ * hexadecimal, el índice del candidato (clave * 8 + bits en el esquema original) y el
+ * método ganador. Las líneas nuevas se agregan al final y, si una huella se repite,
+ * vale la última. Si el archivo no existe se crea.
+ *
+ * @return false si el archivo no se pudo leer ni crear.
+ */
+bool AbrirCacheParametros(const char* ruta);
+
+/** @brief Indica si hay una caché activa; sin ella no se calcula ninguna huella. */
+bool CacheParametrosActiva();
+
+/**
+ * @brief Busca el ganador guardado para una huella.
+ *
+ * Quien consulta debe comprobarlo con una descompresión antes de usarlo y llamar a
+ * @ref OlvidarCacheParametros si la pista no aparece.
+ *
+ * @param totalCandidatos Candidatos del esquema; una entrada fuera de rango se ignora.
+ * @return true si hay una entrada válida para la huella.
+ */
+bool ConsultarCacheParametros(const HuellaBusqueda& huella, int totalCandidatos, int& indice, int& metodo);
+
+/** @brief Guarda el ganador de una búsqueda en memoria y al final del archivo. */
+void GuardarCacheParametros(const HuellaBusqueda& huella, int indice, int metodo);
+
+/** @brief Descarta una entrada que no pasó la comprobación. */
+void OlvidarCacheParametros(const HuellaBusqueda& huella);
+
+#endif // CACHEPARAMETROS_H
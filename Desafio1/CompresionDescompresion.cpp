@@ -1,3 +1,21 @@
+#include <cstring>
+#include "Alfabeto.h"
+#include "CompresionDescompresion.h"
+#include "ContextoDescompresion.h"
+#include "EsquemasCifrado.h"
+#include "Metricas.h"
+#include "Sumideros.h"
+#include "TablasCifrado.h"
+
+/**
+ * @brief Libera el bloque del diccionario si no pertenece a la arena de un contexto.
+ */
+static void LiberarBloque(unsigned char* bloque, ContextoDescompresion* contexto) {
+    if (contexto == nullptr) {
+        delete[] bloque;
+    }
+}
+
 /**
  * @brief Descomprime una secuencia codificada con el algoritmo LZ78 con desencriptado integrado.
  *
@@ -10,162 +28,121 @@
  * los dos primeros bytes forman un número que referencia una entrada del diccionario
  * y el tercer byte es el carácter a concatenar.
  *
+ * El diccionario no guarda las cadenas: cada entrada es solo (padre, último carácter,
+ * longitud) en tres arreglos planos que comparten un único bloque de memoria. La
+ * primera pasada desencripta y llena esos arreglos; la segunda escribe cada frase
+ * directamente en el resultado, de atrás hacia adelante, siguiendo los padres.
+ *
  * @param data Puntero al arreglo de datos encriptados y comprimidos.
  * @param size Cantidad de bytes en el arreglo data.
  * @param claveXOR Clave XOR para desencriptar los datos.
  * @param rotacionBits Número de bits para rotar a la derecha (0-7).
  * @param total Referencia donde se almacena el tamaño total del texto descomprimido.
  * @param esValido Referencia donde se indica si la descompresión fue válida.
+ * @param contexto Si no es nullptr, el diccionario se toma de su arena en lugar del asignador global.
  * @return Puntero a un arreglo dinámico de caracteres terminado en '\0'.
  *         El llamador es responsable de liberar esta memoria con delete[].
  */
 unsigned char* descompresionLZ78(unsigned char* data, int size, unsigned char claveXOR,
-                                 int rotacionBits, int& total, bool& esValido) {
+                                 int rotacionBits, int& total, bool& esValido,
+                                 ContextoDescompresion* contexto) {
     esValido = false;
     total = 0;
 
     if (size % 3 != 0) {
+        RegistrarRechazo(METODO_LZ78, RECHAZO_TAMAÑO);
+        RegistrarDescompresion(METODO_LZ78, 0);
         return nullptr;
     }
 
     int numTernas = size / 3;
 
-    // Crear diccionario dinámico
-    unsigned char** diccionario = new unsigned char*[numTernas + 1];
-    int* longitudes = new int[numTernas + 1];
+    // Diccionario plano: padres y longitudes (int) seguidos de los caracteres, en un solo bloque
+    int entradas = numTernas + 1;
+    size_t bytesBloque = (size_t)entradas * (2 * sizeof(int) + 1);
+    unsigned char* bloque = (contexto != nullptr)
+        ? static_cast<unsigned char*>(contexto->arena().reservar(bytesBloque, alignof(int)))
+        : new unsigned char[bytesBloque];
+    int* padres = reinterpret_cast<int*>(bloque);
+    int* longitudes = padres + entradas;
+    unsigned char* caracteres = reinterpret_cast<unsigned char*>(longitudes + entradas);
 
     // Entrada vacía
-    diccionario[0] = new unsigned char[1];
-    diccionario[0][0] = '\0';
+    padres[0] = 0;
     longitudes[0] = 0;
+    caracteres[0] = '\0';
 
     int posDic = 0;
-    total = 0;
 
-    // Ajustar rotación para que esté en rango válido
-    rotacionBits %= 8;
+    // Tabla de descifrado (XOR + rotación) de este candidato: un acceso por byte
+    const unsigned char* tabla = TablaDescifrado(claveXOR, rotacionBits);
+    const Alfabeto& alfabeto = AlfabetoActivo();
 
-    // Primera pasada: validación con terminación temprana
+    // Primera pasada: desencriptar, validar y llenar el diccionario
     for (int i = 0; i < numTernas; i++) {
         int pos = i * 3;
 
-        // Desencriptar al vuelo con XOR
-        unsigned char byte1 = data[pos] ^ claveXOR;
-        unsigned char byte2 = data[pos + 1] ^ claveXOR;
-        unsigned char byte3 = data[pos + 2] ^ claveXOR;
-
-        // Aplicar rotación a la derecha
-        byte1 = (byte1 >> rotacionBits) | (byte1 << (8 - rotacionBits));
-        byte2 = (byte2 >> rotacionBits) | (byte2 << (8 - rotacionBits));
-        byte3 = (byte3 >> rotacionBits) | (byte3 << (8 - rotacionBits));
+        // Desencriptar al vuelo (XOR + rotación) con la tabla
+        unsigned char byte1 = tabla[data[pos]];
+        unsigned char byte2 = tabla[data[pos + 1]];
+        unsigned char byte3 = tabla[data[pos + 2]];
 
         int numero = (int(byte1) << 8) | int(byte2);
         unsigned char caracter = byte3;
 
-        // Validación de carácter alfabético
-        if (caracter < 'a' || caracter > 'z') {
-            // Limpieza de memoria
-            for (int j = 0; j <= posDic; j++) {
-                delete[] diccionario[j];
-            }
-            delete[] diccionario;
-            delete[] longitudes;
-            return nullptr;
-        }
-
-        // Validación de referencia del diccionario
-        if (numero > posDic) {
-            // Limpieza de memoria
-            for (int j = 0; j <= posDic; j++) {
-                delete[] diccionario[j];
-            }
-            delete[] diccionario;
-            delete[] longitudes;
+        // Validación del carácter y de la referencia del diccionario
+        if (!alfabeto.contiene(caracter) || numero > posDic) {
+            LiberarBloque(bloque, contexto);
+            RegistrarRechazo(METODO_LZ78, (numero > posDic) ? RECHAZO_REFERENCIA : RECHAZO_CARACTER);
+            RegistrarDescompresion(METODO_LZ78, (uint64_t)total);
+            total = 0;
             return nullptr;
         }
 
         // Si llegamos aquí, la terna es válida
         posDic++;
-        int len = (numero == 0) ? 1 : longitudes[numero] + 1;
-        longitudes[posDic] = len;
-        total += len;
+        padres[posDic] = numero;
+        caracteres[posDic] = caracter;
+        longitudes[posDic] = longitudes[numero] + 1;
+        total += longitudes[posDic];
 
         // Prevención de overflow de memoria
         if (total > 1000000) {
-            for (int j = 0; j <= posDic; j++) {
-                delete[] diccionario[j];
-            }
-            delete[] diccionario;
-            delete[] longitudes;
+            LiberarBloque(bloque, contexto);
+            RegistrarRechazo(METODO_LZ78, RECHAZO_TAMAÑO);
+            RegistrarDescompresion(METODO_LZ78, (uint64_t)total);
+            total = 0;
             return nullptr;
         }
     }
 
     // Validación de resultado final
     if (total == 0) {
-        delete[] diccionario[0];
-        delete[] diccionario;
-        delete[] longitudes;
+        LiberarBloque(bloque, contexto);
+        RegistrarRechazo(METODO_LZ78, RECHAZO_TAMAÑO);
+        RegistrarDescompresion(METODO_LZ78, 0);
         return nullptr;
     }
 
-    // Segunda pasada: construir resultado
+    // Segunda pasada: escribir cada frase en su lugar recorriendo los padres hacia atrás
     unsigned char* descomprimido = new unsigned char[total + 1];
-    int pos_resultado = 0;
-    posDic = 0;
-
-    for (int i = 0; i < numTernas; i++) {
-        int pos = i * 3;
-
-        // Desencriptar nuevamente
-        unsigned char byte1 = data[pos] ^ claveXOR;
-        unsigned char byte2 = data[pos + 1] ^ claveXOR;
-        unsigned char byte3 = data[pos + 2] ^ claveXOR;
-
-        byte1 = (byte1 >> rotacionBits) | (byte1 << (8 - rotacionBits));
-        byte2 = (byte2 >> rotacionBits) | (byte2 << (8 - rotacionBits));
-        byte3 = (byte3 >> rotacionBits) | (byte3 << (8 - rotacionBits));
-
-        int numero = (int(byte1) << 8) | int(byte2);
-        unsigned char caracter = byte3;
-
-        // En la segunda pasada, todas las ternas han sido validadas
-        posDic++;
-        int len;
-
-        if (numero == 0) {
-            len = 1;
-            diccionario[posDic] = new unsigned char[len + 1];
-            diccionario[posDic][0] = caracter;
-            diccionario[posDic][len] = '\0';
-        } else {
-            len = longitudes[numero] + 1;
-            diccionario[posDic] = new unsigned char[len + 1];
-
-            for (int j = 0; j < longitudes[numero]; j++) {
-                diccionario[posDic][j] = diccionario[numero][j];
-            }
-            diccionario[posDic][len - 1] = caracter;
-            diccionario[posDic][len] = '\0';
-        }
-
-        longitudes[posDic] = len;
-
-        for (int j = 0; j < len && pos_resultado < total; j++) {
-            descomprimido[pos_resultado] = diccionario[posDic][j];
-            pos_resultado++;
+    int offset = 0;
+
+    for (int entrada = 1; entrada <= posDic; entrada++) {
+        int len = longitudes[entrada];
+        int nodo = entrada;
+        for (int j = offset + len - 1; j >= offset; j--) {
+            descomprimido[j] = caracteres[nodo];
+            nodo = padres[nodo];
         }
+        offset += len;
     }
 
-    // Limpieza final
-    for (int i = 0; i <= posDic; i++) {
-        delete[] diccionario[i];
-    }
-    delete[] diccionario;
-    delete[] longitudes;
+    LiberarBloque(bloque, contexto);
 
     descomprimido[total] = '\0';
     esValido = true;
+    RegistrarDescompresion(METODO_LZ78, (uint64_t)total);
     return descomprimido;
 }
 
@@ -196,33 +173,33 @@ unsigned char* descompresionRLE(unsigned char* data, int size, unsigned char cla
     total = 0;
 
     if (size % 3 != 0) {
+        RegistrarRechazo(METODO_RLE, RECHAZO_TAMAÑO);
+        RegistrarDescompresion(METODO_RLE, 0);
         return nullptr;
     }
 
     int numTernas = size / 3;
 
-    // Ajustar rotación para que esté en rango válido
-    rotacionBits %= 8;
+    // Tabla de descifrado (XOR + rotación) de este candidato: un acceso por byte
+    const unsigned char* tabla = TablaDescifrado(claveXOR, rotacionBits);
+    const Alfabeto& alfabeto = AlfabetoActivo();
 
     // Primera pasada: validación con terminación temprana
     for (int i = 0; i < numTernas; i++) {
         int pos = i * 3;
 
-        // Desencriptar con XOR
-        unsigned char byte1 = data[pos] ^ claveXOR;
-        unsigned char byte2 = data[pos + 1] ^ claveXOR;  // repeticiones
-        unsigned char byte3 = data[pos + 2] ^ claveXOR;  // caracter
-
-        // Aplicar rotación a la derecha
-        byte1 = (byte1 >> rotacionBits) | (byte1 << (8 - rotacionBits));
-        byte2 = (byte2 >> rotacionBits) | (byte2 << (8 - rotacionBits));
-        byte3 = (byte3 >> rotacionBits) | (byte3 << (8 - rotacionBits));
+        // Desencriptar (XOR + rotación) con la tabla
+        // El primer byte de la terna no se usa en RLE
+        unsigned char byte2 = tabla[data[pos + 1]];  // repeticiones
+        unsigned char byte3 = tabla[data[pos + 2]];  // caracter
 
         int repeticiones = int(byte2);
         unsigned char caracter = byte3;
 
         // Validación de formato de terna
-        if (caracter < 'a' || caracter > 'z' || repeticiones <= 0 || repeticiones >= 256) {
+        if (!alfabeto.contiene(caracter) || repeticiones <= 0 || repeticiones >= 256) {
+            RegistrarRechazo(METODO_RLE, (repeticiones <= 0) ? RECHAZO_REPETICION_CERO : RECHAZO_CARACTER);
+            RegistrarDescompresion(METODO_RLE, (uint64_t)total);
             return nullptr;
         }
 
@@ -230,12 +207,16 @@ unsigned char* descompresionRLE(unsigned char* data, int size, unsigned char cla
 
         // Prevención de overflow de memoria
         if (total > 1000000) {
+            RegistrarRechazo(METODO_RLE, RECHAZO_TAMAÑO);
+            RegistrarDescompresion(METODO_RLE, (uint64_t)total);
             return nullptr;
         }
     }
 
     // Validación de resultado final
     if (total == 0) {
+        RegistrarRechazo(METODO_RLE, RECHAZO_TAMAÑO);
+        RegistrarDescompresion(METODO_RLE, 0);
         return nullptr;
     }
 
@@ -247,13 +228,8 @@ unsigned char* descompresionRLE(unsigned char* data, int size, unsigned char cla
         int pos = i * 3;
 
         // Desencriptar nuevamente
-        unsigned char byte1 = data[pos] ^ claveXOR;
-        unsigned char byte2 = data[pos + 1] ^ claveXOR;
-        unsigned char byte3 = data[pos + 2] ^ claveXOR;
-
-        byte1 = (byte1 >> rotacionBits) | (byte1 << (8 - rotacionBits));
-        byte2 = (byte2 >> rotacionBits) | (byte2 << (8 - rotacionBits));
-        byte3 = (byte3 >> rotacionBits) | (byte3 << (8 - rotacionBits));
+        unsigned char byte2 = tabla[data[pos + 1]];
+        unsigned char byte3 = tabla[data[pos + 2]];
 
         int repeticiones = int(byte2);
         unsigned char caracter = byte3;
@@ -267,5 +243,729 @@ unsigned char* descompresionRLE(unsigned char* data, int size, unsigned char cla
 
     descomprimido[total] = '\0';
     esValido = true;
+    RegistrarDescompresion(METODO_RLE, (uint64_t)total);
     return descomprimido;
 }
+
+/**
+ * @brief Descomprime RLE en una sola pasada, entregando las repeticiones a un sumidero.
+ *
+ * Cada terna se desencripta una sola vez: se valida y enseguida se entrega su
+ * repetición al sumidero, sin calcular antes el tamaño total y sin límite de
+ * tamaño de salida. Ante la primera terna inválida se detiene y llama a
+ * `sumidero.descartar()`, de modo que el llamador no debe usar lo ya recibido.
+ * Si el sumidero indica que no necesita más datos, el resto de la entrada solo
+ * se valida, sin producir salida.
+ *
+ * @param data Puntero al arreglo de datos encriptados y comprimidos.
+ * @param size Cantidad de bytes del arreglo de entrada.
+ * @param claveXOR Clave XOR para desencriptar los datos.
+ * @param rotacionBits Número de bits para rotar a la derecha (0-7).
+ * @param sumidero Destino de los bytes descomprimidos.
+ * @param total Referencia donde se almacena el tamaño total descomprimido.
+ * @return true si todas las ternas son válidas, false en caso contrario.
+ */
+bool descompresionRLEFlujo(const unsigned char* data, size_t size, unsigned char claveXOR,
+                           int rotacionBits, Sumidero& sumidero, size_t& total) {
+    return descompresionRLEFlujo(data, size, ClaveCifrado(claveXOR, rotacionBits), sumidero, total);
+}
+
+/**
+ * @brief Descomprime RLE con cualquier esquema de cifrado, descifrando por bloques.
+ *
+ * Cada bloque se descifra entero (con las instrucciones vectoriales en el esquema
+ * original) y sus caracteres se validan contra el alfabeto activo de a 16 o 32 bytes
+ * con @ref Alfabeto::primeraTernaInvalida; el recorrido de las ternas solo mira la
+ * cuenta. El primer bloque es corto porque casi todos los candidatos equivocados
+ * fallan en las primeras ternas. Los bloques son múltiplos de 3, así que las ternas
+ * nunca quedan partidas.
+ */
+bool descompresionRLEFlujo(const unsigned char* data, size_t size, const ClaveCifrado& cifrado,
+                           Sumidero& sumidero, size_t& total) {
+    total = 0;
+
+    if (data == nullptr || size == 0 || size % 3 != 0) {
+        RegistrarRechazo(METODO_RLE, RECHAZO_TAMAÑO);
+        RegistrarDescompresion(METODO_RLE, 0);
+        return false;
+    }
+
+    const Alfabeto& alfabeto = AlfabetoActivo();
+    unsigned char descifrado[3 * 1365];
+    size_t tamañoBloque = 3 * 16;
+    bool produciendo = true;
+
+    for (size_t inicio = 0; inicio < size; inicio += tamañoBloque, tamañoBloque = sizeof(descifrado)) {
+        size_t parte = (size - inicio < tamañoBloque) ? size - inicio : tamañoBloque;
+        cifrado.descifrar(descifrado, data + inicio, parte, inicio);
+
+        // Las ternas anteriores a la primera con un carácter inválido se procesan igual
+        size_t numTernas = parte / 3;
+        size_t validas = alfabeto.primeraTernaInvalida(descifrado, numTernas);
+
+        for (size_t t = 0; t < validas; t++) {
+            unsigned char repeticiones = descifrado[3 * t + 1];
+            unsigned char caracter = descifrado[3 * t + 2];
+
+            if (repeticiones == 0) {
+                sumidero.descartar();
+                RegistrarRechazo(METODO_RLE, RECHAZO_REPETICION_CERO);
+                RegistrarDescompresion(METODO_RLE, total);
+                total = 0;
+                return false;
+            }
+
+            // Si el sumidero ya no necesita datos se sigue validando sin producir salida
+            if (produciendo && !sumidero.escribirRepeticion(caracter, repeticiones)) {
+                produciendo = false;
+            }
+            total += repeticiones;
+        }
+
+        if (validas < numTernas) {
+            sumidero.descartar();
+            RegistrarRechazo(METODO_RLE, (descifrado[3 * validas + 1] == 0) ? RECHAZO_REPETICION_CERO
+                                                                           : RECHAZO_CARACTER);
+            RegistrarDescompresion(METODO_RLE, total);
+            total = 0;
+            return false;
+        }
+    }
+
+    RegistrarDescompresion(METODO_RLE, total);
+    if (!sumidero.finalizar()) {
+        sumidero.descartar();
+        RegistrarRechazo(METODO_RLE, RECHAZO_SALIDA);
+        total = 0;
+        return false;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// LZ78 por flujo
+// ---------------------------------------------------------------------------
+
+/*
+ * Las referencias LZ78 ocupan 16 bits, así que solo las entradas 0 a 65535 del
+ * diccionario pueden ser referenciadas. Las demás se cuentan (para validar las
+ * referencias) pero no se guardan: la memoria queda acotada por el diccionario,
+ * sin importar el tamaño de la entrada. Por lo mismo ninguna frase supera
+ * MAX_ENTRADAS_LZ78 bytes.
+ */
+
+/**
+ * @brief Prepara el descompresor. Con un contexto, el diccionario y el buffer de salida
+ *        se toman de su arena y no se reservan ni liberan aquí.
+ */
+DescompresorLZ78::DescompresorLZ78(unsigned char claveXOR, int rotacionBits, Sumidero& sumidero,
+                                   ContextoDescompresion* contexto)
+    : DescompresorLZ78(ClaveCifrado(claveXOR, rotacionBits), sumidero, contexto) {}
+
+DescompresorLZ78::DescompresorLZ78(const ClaveCifrado& cifrado, Sumidero& sumidero,
+                                   ContextoDescompresion* contexto)
+    : cifrado(cifrado), posicion(0), alfabeto(AlfabetoActivo()), sumidero(sumidero),
+      usadoSalida(0), numPendientes(0), entradas(0), totalSalida(0), invalido(false), produciendo(true),
+      propios(contexto == nullptr) {
+    if (contexto != nullptr) {
+        ArenaMonotona& arena = contexto->arena();
+        padres = arena.reservarArreglo<unsigned short>(MAX_ENTRADAS_LZ78);
+        longitudes = arena.reservarArreglo<unsigned int>(MAX_ENTRADAS_LZ78);
+        caracteres = arena.reservarArreglo<unsigned char>(MAX_ENTRADAS_LZ78);
+        salida = arena.reservarArreglo<unsigned char>(CAPACIDAD_SALIDA);
+    } else {
+        padres = new unsigned short[MAX_ENTRADAS_LZ78];
+        longitudes = new unsigned int[MAX_ENTRADAS_LZ78];
+        caracteres = new unsigned char[MAX_ENTRADAS_LZ78];
+        salida = new unsigned char[CAPACIDAD_SALIDA];
+    }
+    padres[0] = 0;
+    longitudes[0] = 0;
+    caracteres[0] = '\0';
+}
+
+DescompresorLZ78::~DescompresorLZ78() {
+    RegistrarDescompresion(METODO_LZ78, totalSalida);
+    if (!propios) {
+        return;
+    }
+    delete[] padres;
+    delete[] longitudes;
+    delete[] caracteres;
+    delete[] salida;
+}
+
+/**
+ * @brief Marca la entrada como inválida y descarta lo entregado al sumidero.
+ */
+bool DescompresorLZ78::rechazar(MotivoRechazo motivo) {
+    RegistrarRechazo(METODO_LZ78, motivo);
+    invalido = true;
+    usadoSalida = 0;
+    sumidero.descartar();
+    return false;
+}
+
+/**
+ * @brief Entrega al sumidero lo acumulado en el buffer de salida.
+ *
+ * Si el sumidero responde que no necesita más datos, se deja de producir salida
+ * pero se sigue validando el resto de la entrada.
+ */
+void DescompresorLZ78::vaciarSalida() {
+    size_t cantidad = usadoSalida;
+    usadoSalida = 0;
+    if (produciendo && cantidad > 0 && !sumidero.escribir(salida, cantidad)) {
+        produciendo = false;
+    }
+}
+
+/**
+ * @brief Valida la referencia de una terna ya desencriptada y escribe su frase en el buffer de salida.
+ *
+ * El carácter ya fue validado contra el alfabeto por quien llama.
+ */
+bool DescompresorLZ78::procesarTerna(unsigned char byte1, unsigned char byte2, unsigned char byte3) {
+    unsigned int numero = ((unsigned int)byte1 << 8) | byte2;
+
+    if (numero > entradas) {
+        return rechazar(RECHAZO_REFERENCIA);
+    }
+
+    entradas++;
+    unsigned int len = longitudes[numero] + 1;
+
+    // Solo se guardan las entradas que una referencia de 16 bits puede alcanzar
+    if (entradas < MAX_ENTRADAS_LZ78) {
+        padres[entradas] = (unsigned short)numero;
+        longitudes[entradas] = len;
+        caracteres[entradas] = byte3;
+    }
+
+    totalSalida += len;
+    if (!produciendo) {
+        return true;  // Solo validación: el sumidero ya no necesita la salida
+    }
+
+    if (CAPACIDAD_SALIDA - usadoSalida < len) {
+        vaciarSalida();
+        if (!produciendo) {
+            return true;
+        }
+    }
+
+    // Escribir la frase de atrás hacia adelante siguiendo los padres
+    unsigned char* destino = salida + usadoSalida;
+    destino[len - 1] = byte3;
+    unsigned int nodo = numero;
+    for (int j = (int)len - 2; j >= 0; j--) {
+        destino[j] = caracteres[nodo];
+        nodo = padres[nodo];
+    }
+    usadoSalida += len;
+    return true;
+}
+
+/**
+ * @brief Procesa el siguiente bloque de bytes encriptados.
+ *
+ * Los bloques pueden tener cualquier tamaño; una terna puede quedar repartida
+ * entre dos bloques consecutivos. Los caracteres de las ternas completas de cada
+ * bloque descifrado se validan juntos con @ref Alfabeto::primeraTernaInvalida.
+ *
+ * @return false si la entrada resultó inválida.
+ */
+bool DescompresorLZ78::procesar(const unsigned char* datos, size_t cantidad) {
+    if (invalido) {
+        return false;
+    }
+
+    unsigned char descifrado[4096];
+    while (cantidad > 0) {
+        size_t parte = (cantidad < sizeof(descifrado)) ? cantidad : sizeof(descifrado);
+        cifrado.descifrar(descifrado, datos, parte, posicion);
+        posicion += parte;
+        datos += parte;
+        cantidad -= parte;
+
+        size_t i = 0;
+
+        // Completar la terna que quedó partida en el bloque anterior
+        while (numPendientes > 0 && numPendientes < 3 && i < parte) {
+            pendientes[numPendientes++] = descifrado[i++];
+        }
+        if (numPendientes == 3) {
+            numPendientes = 0;
+            if (!alfabeto.contiene(pendientes[2])) {
+                return rechazar(RECHAZO_CARACTER);
+            }
+            if (!procesarTerna(pendientes[0], pendientes[1], pendientes[2])) {
+                return false;
+            }
+        }
+
+        // Las ternas anteriores a la primera con un carácter inválido se procesan igual
+        size_t completas = (parte - i) / 3;
+        size_t validas = alfabeto.primeraTernaInvalida(descifrado + i, completas);
+        for (size_t t = 0; t < validas; t++, i += 3) {
+            if (!procesarTerna(descifrado[i], descifrado[i + 1], descifrado[i + 2])) {
+                return false;
+            }
+        }
+        if (validas < completas) {
+            return rechazar(RECHAZO_CARACTER);
+        }
+
+        // Guardar los bytes sobrantes para el siguiente bloque
+        while (i < parte) {
+            pendientes[numPendientes++] = descifrado[i++];
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Termina la descompresión: la entrada debe cerrar en una terna completa y no estar vacía.
+ */
+bool DescompresorLZ78::finalizar() {
+    if (invalido) {
+        return false;
+    }
+    if (numPendientes != 0 || totalSalida == 0) {
+        return rechazar(RECHAZO_TAMAÑO);
+    }
+    vaciarSalida();
+    if (!sumidero.finalizar()) {
+        return rechazar(RECHAZO_SALIDA);
+    }
+    return true;
+}
+
+/**
+ * @brief Descomprime LZ78 de un arreglo en memoria hacia un sumidero, sin límite de tamaño.
+ *
+ * @param data Puntero al arreglo de datos encriptados y comprimidos.
+ * @param size Cantidad de bytes del arreglo.
+ * @param claveXOR Clave XOR para desencriptar los datos.
+ * @param rotacionBits Número de bits para rotar a la derecha (0-7).
+ * @param sumidero Destino de los bytes descomprimidos.
+ * @param total Referencia donde se almacena el tamaño total descomprimido.
+ * @param contexto Contexto del que se toma la memoria de trabajo (opcional).
+ * @return true si la descompresión fue válida, false en caso contrario.
+ */
+bool descompresionLZ78Flujo(const unsigned char* data, size_t size, unsigned char claveXOR,
+                            int rotacionBits, Sumidero& sumidero, size_t& total,
+                            ContextoDescompresion* contexto) {
+    return descompresionLZ78Flujo(data, size, ClaveCifrado(claveXOR, rotacionBits), sumidero, total, contexto);
+}
+
+bool descompresionLZ78Flujo(const unsigned char* data, size_t size, const ClaveCifrado& cifrado,
+                            Sumidero& sumidero, size_t& total, ContextoDescompresion* contexto) {
+    total = 0;
+
+    if (data == nullptr || size == 0 || size % 3 != 0) {
+        RegistrarRechazo(METODO_LZ78, RECHAZO_TAMAÑO);
+        RegistrarDescompresion(METODO_LZ78, 0);
+        return false;
+    }
+
+    DescompresorLZ78 descompresor(cifrado, sumidero, contexto);
+    if (!descompresor.procesar(data, size) || !descompresor.finalizar()) {
+        return false;
+    }
+    total = (size_t)descompresor.total();
+    return true;
+}
+
+/**
+ * @brief Descomprime LZ78 leyendo la entrada encriptada por bloques desde un flujo.
+ *
+ * La memoria usada es la del diccionario más un bloque de entrada, sin importar
+ * el tamaño del archivo, y los tamaños se cuentan con 64 bits.
+ *
+ * @param entrada Flujo binario con los datos encriptados y comprimidos.
+ * @param claveXOR Clave XOR para desencriptar los datos.
+ * @param rotacionBits Número de bits para rotar a la derecha (0-7).
+ * @param sumidero Destino de los bytes descomprimidos.
+ * @param total Referencia donde se almacena el tamaño total descomprimido.
+ * @param tamañoBloque Cantidad de bytes que se leen en cada bloque.
+ * @return true si la descompresión fue válida, false en caso contrario.
+ */
+bool descompresionLZ78Flujo(std::istream& entrada, unsigned char claveXOR, int rotacionBits,
+                            Sumidero& sumidero, uint64_t& total, size_t tamañoBloque) {
+    return descompresionLZ78Flujo(entrada, ClaveCifrado(claveXOR, rotacionBits), sumidero, total, tamañoBloque);
+}
+
+bool descompresionLZ78Flujo(std::istream& entrada, const ClaveCifrado& cifrado, Sumidero& sumidero,
+                            uint64_t& total, size_t tamañoBloque) {
+    total = 0;
+    if (tamañoBloque == 0) {
+        tamañoBloque = 1 << 20;
+    }
+
+    DescompresorLZ78 descompresor(cifrado, sumidero);
+    unsigned char* bloque = new unsigned char[tamañoBloque];
+
+    bool valido = true;
+    while (valido && entrada) {
+        entrada.read(reinterpret_cast<char*>(bloque), (std::streamsize)tamañoBloque);
+        size_t leidos = (size_t)entrada.gcount();
+        if (leidos == 0) {
+            break;
+        }
+        valido = descompresor.procesar(bloque, leidos);
+    }
+    delete[] bloque;
+
+    if (valido && entrada.bad()) {
+        sumidero.descartar();
+        return false;
+    }
+    if (!valido || !descompresor.finalizar()) {
+        return false;
+    }
+    total = descompresor.total();
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Compresión
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Cantidad de bits en cero a la derecha del primer bit prendido (`x` distinto de 0).
+ */
+static inline unsigned int ContarCerosFinales(uint64_t x) {
+#if defined(__GNUC__)
+    return (unsigned int)__builtin_ctzll(x);
+#else
+    unsigned int n = 0;
+    while ((x & 1) == 0) {
+        x >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+// El recorrido por palabras deduce la posición de cada byte suponiendo little-endian
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+static const bool RECORRIDO_POR_PALABRAS = false;
+#else
+static const bool RECORRIDO_POR_PALABRAS = true;
+#endif
+
+CompresorTernas::CompresorTernas(const ClaveCifrado& cifrado, Sumidero& sumidero)
+    : invalido(false), cifrado(cifrado), sumidero(sumidero),
+      salida(new unsigned char[CAPACIDAD_SALIDA]), usadoSalida(0), totalSalida(0) {}
+
+CompresorTernas::~CompresorTernas() {
+    delete[] salida;
+}
+
+/**
+ * @brief Encripta el bloque acumulado en el lugar y lo entrega al sumidero.
+ *
+ * Si el sumidero lo rechaza, la compresión queda marcada como inválida.
+ */
+void CompresorTernas::vaciarSalida() {
+    size_t cantidad = usadoSalida;
+    usadoSalida = 0;
+    if (invalido || cantidad == 0) {
+        return;
+    }
+    cifrado.cifrar(salida, salida, cantidad, totalSalida);
+    if (!sumidero.escribir(salida, cantidad)) {
+        invalido = true;
+        return;
+    }
+    totalSalida += cantidad;
+}
+
+/**
+ * @brief Marca la compresión como inválida y descarta lo entregado al sumidero.
+ */
+bool CompresorTernas::rechazar() {
+    invalido = true;
+    usadoSalida = 0;
+    sumidero.descartar();
+    return false;
+}
+
+/**
+ * @brief Entrega el último bloque y finaliza el sumidero.
+ */
+bool CompresorTernas::terminar() {
+    vaciarSalida();
+    if (invalido || totalSalida == 0 || !sumidero.finalizar()) {
+        return rechazar();
+    }
+    return true;
+}
+
+CompresorRLE::CompresorRLE(unsigned char claveXOR, int rotacionBits, Sumidero& sumidero)
+    : CompresorRLE(ClaveCifrado(claveXOR, rotacionBits), sumidero) {}
+
+CompresorRLE::CompresorRLE(const ClaveCifrado& cifrado, Sumidero& sumidero)
+    : CompresorTernas(cifrado, sumidero), caracter(0), cuenta(0) {}
+
+/**
+ * @brief Emite una corrida completa, partida en ternas de hasta 255 caracteres.
+ */
+void CompresorRLE::emitirCorrida(unsigned char letra, uint64_t largo) {
+    while (largo > 255) {
+        agregarTerna(0, 255, letra);
+        largo -= 255;
+    }
+    if (largo > 0) {
+        agregarTerna(0, (unsigned char)largo, letra);
+    }
+}
+
+/**
+ * @brief Comprime el siguiente bloque de texto.
+ *
+ * Primero se valida el bloque entero contra el alfabeto activo (de a 16 o 32 bytes).
+ * Luego el texto se recorre de a 8 bytes: comparando cada palabra con la misma
+ * desplazada un byte se obtienen a la vez todos los comienzos de corrida, así que el
+ * costo depende de la cantidad de corridas y no de bifurcaciones por carácter. La
+ * cola se recorre byte a byte.
+ *
+ * @return false si el texto tiene caracteres fuera del alfabeto activo o el sumidero falló.
+ */
+bool CompresorRLE::procesar(const unsigned char* texto, size_t cantidad) {
+    if (invalido) {
+        return false;
+    }
+    if (cantidad == 0) {
+        return true;
+    }
+    if (AlfabetoActivo().primerFuera(texto, cantidad) != cantidad) {
+        return rechazar();
+    }
+
+    const uint64_t altos = 0x8080808080808080ULL;
+
+    // La corrida en curso tiene `largo` caracteres antes de `inicio` más los que siguen desde `inicio`
+    unsigned char letra = caracter;
+    uint64_t largo = cuenta;
+    size_t inicio = 0;
+    size_t i = 0;
+
+    if (largo == 0) {
+        letra = texto[0];
+        i = 1;
+    }
+
+    while (i < cantidad) {
+        if (RECORRIDO_POR_PALABRAS && i > 0 && i + 8 <= cantidad) {
+            uint64_t palabra, anterior;
+            memcpy(&palabra, texto + i, 8);
+            memcpy(&anterior, texto + i - 1, 8);
+
+            uint64_t distintos = palabra ^ anterior;
+            uint64_t comienzos = (((distintos & ~altos) + ~altos) | distintos) & altos;
+            while (comienzos != 0) {
+                size_t posicion = i + (size_t)(ContarCerosFinales(comienzos) >> 3);
+                emitirCorrida(letra, largo + (posicion - inicio));
+                letra = texto[posicion];
+                largo = 0;
+                inicio = posicion;
+                comienzos &= comienzos - 1;
+            }
+            i += 8;
+            continue;
+        }
+
+        // Byte a byte: cola del bloque
+        size_t fin = (i + 8 < cantidad) ? i + 8 : cantidad;
+        for (; i < fin; i++) {
+            unsigned char c = texto[i];
+            if (c != letra) {
+                emitirCorrida(letra, largo + (i - inicio));
+                letra = c;
+                largo = 0;
+                inicio = i;
+            }
+        }
+    }
+
+    caracter = letra;
+    cuenta = largo + (cantidad - inicio);
+    return !invalido;
+}
+
+bool CompresorRLE::finalizar() {
+    if (invalido) {
+        return false;
+    }
+    emitirCorrida(caracter, cuenta);
+    cuenta = 0;
+    return terminar();
+}
+
+CompresorLZ78::CompresorLZ78(unsigned char claveXOR, int rotacionBits, Sumidero& sumidero)
+    : CompresorLZ78(ClaveCifrado(claveXOR, rotacionBits), sumidero) {}
+
+CompresorLZ78::CompresorLZ78(const ClaveCifrado& cifrado, Sumidero& sumidero)
+    : CompresorTernas(cifrado, sumidero),
+      hijosDirectos(new unsigned short[NODOS_DIRECTOS * 26]),
+      tabla(new uint64_t[1u << BITS_TABLA]),
+      padres(new unsigned short[MAX_ENTRADAS_LZ78]),
+      ultimos(new unsigned char[MAX_ENTRADAS_LZ78]),
+      entradas(1), nodo(0) {
+    memset(hijosDirectos, 0, sizeof(unsigned short) * NODOS_DIRECTOS * 26);
+    memset(tabla, 0, sizeof(uint64_t) << BITS_TABLA);
+    padres[0] = 0;
+    ultimos[0] = '\0';
+}
+
+CompresorLZ78::~CompresorLZ78() {
+    delete[] hijosDirectos;
+    delete[] tabla;
+    delete[] padres;
+    delete[] ultimos;
+}
+
+/**
+ * @brief Comprime el siguiente bloque de texto.
+ *
+ * La frase en curso se extiende mientras el trie tenga el hijo; al fallar se emite
+ * la terna (frase, carácter) y, si queda lugar en el diccionario, el hijo se inserta
+ * donde terminó la búsqueda. El estado se copia a variables locales para que las
+ * escrituras de bytes no obliguen a releerlo. Los hijos directos cubren solo las
+ * minúsculas; los demás caracteres del alfabeto van siempre a la tabla hash.
+ *
+ * @return false si el texto tiene caracteres fuera del alfabeto activo o el sumidero falló.
+ */
+bool CompresorLZ78::procesar(const unsigned char* texto, size_t cantidad) {
+    if (invalido) {
+        return false;
+    }
+    if (AlfabetoActivo().primerFuera(texto, cantidad) != cantidad) {
+        return rechazar();
+    }
+
+    const uint32_t mascara = (1u << BITS_TABLA) - 1;
+    unsigned short* const directos = hijosDirectos;
+    uint64_t* const t = tabla;
+    unsigned int actual = nodo;
+    unsigned int siguiente = entradas;
+
+    for (size_t i = 0; i < cantidad; i++) {
+        unsigned char c = texto[i];
+
+        if (actual < NODOS_DIRECTOS && (unsigned char)(c - 'a') < 26) {
+            unsigned short& hijo = directos[actual * 26 + (c - 'a')];
+            if (hijo != 0) {
+                actual = hijo;
+                continue;
+            }
+            agregarTerna((unsigned char)(actual >> 8), (unsigned char)(actual & 0xFF), c);
+            if (siguiente < MAX_ENTRADAS_LZ78) {
+                hijo = (unsigned short)siguiente;
+                padres[siguiente] = (unsigned short)actual;
+                ultimos[siguiente] = c;
+                siguiente++;
+            }
+            actual = 0;
+            continue;
+        }
+
+        // Sondeo lineal: con el nodo desplazado en uno la llave nunca es 0, ni desde la raíz
+        uint64_t llave = ((uint64_t)(actual + 1) << 8) | c;
+        uint32_t posicion = ((uint32_t)llave * 0x9E3779B1u) >> (32 - BITS_TABLA);
+        uint64_t celda = t[posicion];
+        while (celda != 0 && (celda >> 16) != llave) {
+            posicion = (posicion + 1) & mascara;
+            celda = t[posicion];
+        }
+        if (celda != 0) {
+            actual = (unsigned int)(celda & 0xFFFF);
+            continue;
+        }
+
+        agregarTerna((unsigned char)(actual >> 8), (unsigned char)(actual & 0xFF), c);
+        if (siguiente < MAX_ENTRADAS_LZ78) {
+            t[posicion] = (llave << 16) | siguiente;
+            padres[siguiente] = (unsigned short)actual;
+            ultimos[siguiente] = c;
+            siguiente++;
+        }
+        actual = 0;
+    }
+
+    nodo = actual;
+    entradas = siguiente;
+    return !invalido;
+}
+
+/**
+ * @brief Emite la frase pendiente y finaliza el sumidero.
+ *
+ * La frase pendiente ya está en el diccionario, así que se emite como su padre más
+ * su último carácter (el descompresor la agrega como una entrada repetida).
+ */
+bool CompresorLZ78::finalizar() {
+    if (invalido) {
+        return false;
+    }
+    if (nodo != 0) {
+        agregarTerna((unsigned char)(padres[nodo] >> 8), (unsigned char)(padres[nodo] & 0xFF), ultimos[nodo]);
+        nodo = 0;
+    }
+    return terminar();
+}
+
+/**
+ * @brief Comprime un texto completo con RLE y lo encripta.
+ *
+ * @param texto Texto a comprimir (solo caracteres del alfabeto activo).
+ * @param size Tamaño del texto.
+ * @param claveXOR Clave XOR.
+ * @param rotacionBits Bits de rotación a la izquierda (0-7).
+ * @param total Referencia donde se almacena el tamaño del resultado.
+ * @return Ternas encriptadas (liberar con delete[]) o nullptr si el texto no es válido.
+ */
+unsigned char* compresionRLE(const unsigned char* texto, size_t size, unsigned char claveXOR,
+                             int rotacionBits, size_t& total) {
+    total = 0;
+    if (texto == nullptr || size == 0) {
+        return nullptr;
+    }
+
+    // Reserva del peor caso (una terna por carácter): solo se tocan las páginas que se escriben
+    SumideroMemoria salida(3 * size);
+    CompresorRLE compresor(claveXOR, rotacionBits, salida);
+    if (!compresor.procesar(texto, size) || !compresor.finalizar()) {
+        return nullptr;
+    }
+    total = salida.tamaño();
+    return salida.liberar();
+}
+
+/**
+ * @brief Comprime un texto completo con LZ78 y lo encripta.
+ *
+ * @param texto Texto a comprimir (solo caracteres del alfabeto activo).
+ * @param size Tamaño del texto.
+ * @param claveXOR Clave XOR.
+ * @param rotacionBits Bits de rotación a la izquierda (0-7).
+ * @param total Referencia donde se almacena el tamaño del resultado.
+ * @return Ternas encriptadas (liberar con delete[]) o nullptr si el texto no es válido.
+ */
+unsigned char* compresionLZ78(const unsigned char* texto, size_t size, unsigned char claveXOR,
+                              int rotacionBits, size_t& total) {
+    total = 0;
+    if (texto == nullptr || size == 0) {
+        return nullptr;
+    }
+
+    SumideroMemoria salida(3 * size);
+    CompresorLZ78 compresor(claveXOR, rotacionBits, salida);
+    if (!compresor.procesar(texto, size) || !compresor.finalizar()) {
+        return nullptr;
+    }
+    total = salida.tamaño();
+    return salida.liberar();
+}
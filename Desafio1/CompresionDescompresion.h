@@ -0,0 +1,385 @@
+#ifndef COMPRESIONDESCOMPRESION_H
+#define COMPRESIONDESCOMPRESION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include "Alfabeto.h"
+#include "ContextoDescompresion.h"
+#include "EsquemasCifrado.h"
+#include "Metricas.h"
+#include "Sumideros.h"
+
+/**
+ * @brief Descomprime una secuencia codificada con el algoritmo LZ78 con desencriptado integrado.
+ *
+ * Esta función recibe un arreglo de bytes encriptados, aplica la desencriptación
+ * (XOR + rotación de bits) y luego descomprime usando el algoritmo LZ78.
+ *
+ * El formato esperado después del desencriptado es una secuencia de ternas (número, número, letra),
+ * donde los dos primeros bytes forman un número que referencia a una entrada previa del diccionario
+ * y el tercer byte es el nuevo carácter a concatenar. La numeración empieza en 1
+ * (entrada 0 indica que el carácter no depende de ninguna cadena previa).
+ *
+ * El algoritmo realiza dos pasadas:
+ *  - **Primera pasada:** Desencripta, valida datos y llena el diccionario, guardado como tres
+ *    arreglos planos (padre, último carácter, longitud) en un solo bloque de memoria.
+ *  - **Segunda pasada:** Escribe cada frase directamente en el resultado, desde su última
+ *    posición hacia atrás, siguiendo los enlaces a los padres. No reserva memoria por entrada.
+ *
+ * @param data Puntero al arreglo de datos encriptados y comprimidos.
+ * @param size Cantidad de bytes en el arreglo `data`.
+ * @param claveXOR Clave XOR para desencriptar.
+ * @param rotacionBits Número de bits para rotar a la derecha (0-7).
+ * @param total Referencia donde se almacena el tamaño total del texto descomprimido.
+ * @param esValido Referencia donde se indica si la descompresión fue válida.
+ * @param contexto Contexto del que se toma el diccionario (opcional); sin él se reserva y libera aquí.
+ * @return Un puntero a un arreglo dinámico de caracteres (unsigned char*)
+ *         que contiene el texto descomprimido terminado en `\0`.
+ *         El llamador es responsable de liberar esta memoria con `delete[]`.
+ * @note
+ * - Incluye validación temprana para detectar combinaciones incorrectas de parámetros.
+ * - Si las referencias del diccionario están muy fuera de rango, retorna nullptr.
+ * - Los tamaños son int, como en el resto de las funciones originales; la búsqueda usa
+ *   @ref descompresionLZ78Flujo, que cuenta con size_t.
+ */
+unsigned char* descompresionLZ78(unsigned char* data, int size, unsigned char claveXOR,
+                                 int rotacionBits, int& total, bool& esValido,
+                                 ContextoDescompresion* contexto = nullptr);
+
+/**
+ * @brief Descomprime un arreglo previamente comprimido usando el algoritmo RLE con desencriptado integrado.
+ *
+ * Esta función recibe un arreglo de bytes encriptados, aplica la desencriptación
+ * (XOR + rotación de bits) y luego descomprime usando Run-Length Encoding.
+ *
+ * El algoritmo interpreta el formato de ternas después del desencriptado:
+ * - Primer byte: no utilizado en RLE
+ * - Segundo byte: número de repeticiones
+ * - Tercer byte: carácter a repetir
+ *
+ * Ejemplo después del desencriptado: ternas que representan "4A3B2C1D2A" -> "AAAABBBCCDAA".
+ *
+ * @param entrada Puntero al arreglo de datos encriptados y comprimidos.
+ * @param size Cantidad de caracteres del arreglo de entrada.
+ * @param claveXOR Clave XOR para desencriptar.
+ * @param rotacionBits Número de bits para rotar a la derecha (0-7).
+ * @param total Referencia donde se almacena el tamaño total del arreglo descomprimido.
+ * @param esValido Referencia donde se indica si la descompresión fue válida.
+ * @return Puntero al texto descomprimido (dinámico, debe liberarse con `delete[]`).
+ * @note
+ * - Cada terna debe repetir entre 1 y 255 veces un carácter del alfabeto activo
+ *   (@ref AlfabetoActivo); ante la primera terna inválida retorna nullptr.
+ * - Rechaza los textos de más de 1000000 bytes; @ref descompresionRLEFlujo no tiene ese límite.
+ */
+unsigned char* descompresionRLE(unsigned char* entrada, int size, unsigned char claveXOR,
+                                int rotacionBits, int& total, bool& esValido);
+
+/**
+ * @brief Descomprime RLE en una sola pasada con desencriptado integrado, escribiendo en un sumidero.
+ *
+ * A diferencia de @ref descompresionRLE, cada terna se desencripta una sola vez: se valida y
+ * su repetición se entrega de inmediato al sumidero. No hay límite de tamaño de salida.
+ * Ante la primera terna inválida se detiene y llama a `sumidero.descartar()`.
+ * Si el sumidero no necesita más datos, el resto de la entrada solo se valida.
+ *
+ * @param data Puntero al arreglo de datos encriptados y comprimidos.
+ * @param size Cantidad de bytes del arreglo de entrada.
+ * @param claveXOR Clave XOR para desencriptar.
+ * @param rotacionBits Número de bits para rotar a la derecha (0-7).
+ * @param sumidero Destino de los bytes descomprimidos.
+ * @param total Referencia donde se almacena el tamaño total descomprimido.
+ * @return true si la descompresión fue válida, false en caso contrario.
+ */
+bool descompresionRLEFlujo(const unsigned char* data, size_t size, unsigned char claveXOR,
+                           int rotacionBits, Sumidero& sumidero, size_t& total);
+
+/**
+ * @brief Como @ref descompresionRLEFlujo, con datos cifrados con cualquier esquema.
+ *
+ * Los datos se descifran por bloques con `cifrado` y luego se validan las ternas, así
+ * que la única llamada indirecta es una por bloque.
+ */
+bool descompresionRLEFlujo(const unsigned char* data, size_t size, const ClaveCifrado& cifrado,
+                           Sumidero& sumidero, size_t& total);
+
+/**
+ * @brief Cantidad de entradas del diccionario LZ78 alcanzables con referencias de 16 bits.
+ */
+const unsigned int MAX_ENTRADAS_LZ78 = 65536;
+
+/**
+ * @brief Descompresor LZ78 incremental que recibe la entrada encriptada por bloques.
+ *
+ * Solo guarda las entradas del diccionario que una referencia de 16 bits puede alcanzar
+ * (como arreglos planos de padre, carácter y longitud), así que la memoria queda acotada
+ * sin importar el tamaño de la entrada. Las frases se acumulan en un buffer interno y se
+ * entregan al sumidero por partes. Los tamaños se cuentan con 64 bits.
+ *
+ * Uso: llamar a `procesar` con cada bloque (una terna puede quedar partida entre dos
+ * bloques) y al final a `finalizar`. Si algún paso retorna false la entrada fue inválida.
+ */
+class DescompresorLZ78 {
+public:
+    DescompresorLZ78(unsigned char claveXOR, int rotacionBits, Sumidero& sumidero,
+                     ContextoDescompresion* contexto = nullptr);
+    /** @brief Descompresor para datos cifrados con cualquier esquema (ver @ref ClaveCifrado). */
+    DescompresorLZ78(const ClaveCifrado& cifrado, Sumidero& sumidero, ContextoDescompresion* contexto = nullptr);
+    ~DescompresorLZ78();
+    DescompresorLZ78(const DescompresorLZ78&) = delete;
+    DescompresorLZ78& operator=(const DescompresorLZ78&) = delete;
+
+    /** @brief Procesa el siguiente bloque de bytes encriptados. */
+    bool procesar(const unsigned char* datos, size_t cantidad);
+    /** @brief Termina la descompresión y entrega lo que quede en el buffer. */
+    bool finalizar();
+    /** @brief Bytes descomprimidos hasta ahora. */
+    uint64_t total() const { return totalSalida; }
+
+    /** @brief Bytes del buffer donde se acumulan las frases antes de entregarlas al sumidero. */
+    static const size_t CAPACIDAD_SALIDA = 4 * MAX_ENTRADAS_LZ78;
+    /** @brief Memoria de trabajo de un descompresor (diccionario, salida y relleno de alineación). */
+    static const size_t BYTES_TRABAJO =
+        MAX_ENTRADAS_LZ78 * (sizeof(unsigned short) + sizeof(unsigned int) + 1) + CAPACIDAD_SALIDA + 64;
+
+private:
+
+    bool procesarTerna(unsigned char byte1, unsigned char byte2, unsigned char byte3);
+    void vaciarSalida();
+    bool rechazar(MotivoRechazo motivo);
+
+    ClaveCifrado cifrado;
+    uint64_t posicion;  // Bytes cifrados ya procesados (fase de las claves repetidas)
+    const Alfabeto& alfabeto;
+    Sumidero& sumidero;
+    unsigned short* padres;
+    unsigned int* longitudes;
+    unsigned char* caracteres;
+    unsigned char* salida;
+    size_t usadoSalida;
+    unsigned char pendientes[3];
+    int numPendientes;
+    uint64_t entradas;
+    uint64_t totalSalida;
+    bool invalido;
+    bool produciendo;
+    bool propios;    // true si los arreglos se reservaron aquí y no en un contexto
+};
+
+/**
+ * @brief Descomprime LZ78 de un arreglo en memoria hacia un sumidero, sin límite de tamaño de salida.
+ *
+ * @param data Puntero al arreglo de datos encriptados y comprimidos.
+ * @param size Cantidad de bytes del arreglo.
+ * @param claveXOR Clave XOR para desencriptar.
+ * @param rotacionBits Número de bits para rotar a la derecha (0-7).
+ * @param sumidero Destino de los bytes descomprimidos.
+ * @param total Referencia donde se almacena el tamaño total descomprimido.
+ * @param contexto Contexto del que se toma la memoria de trabajo (opcional).
+ * @return true si la descompresión fue válida, false en caso contrario.
+ */
+bool descompresionLZ78Flujo(const unsigned char* data, size_t size, unsigned char claveXOR,
+                            int rotacionBits, Sumidero& sumidero, size_t& total,
+                            ContextoDescompresion* contexto = nullptr);
+
+/**
+ * @brief Como @ref descompresionLZ78Flujo, con datos cifrados con cualquier esquema.
+ */
+bool descompresionLZ78Flujo(const unsigned char* data, size_t size, const ClaveCifrado& cifrado,
+                            Sumidero& sumidero, size_t& total, ContextoDescompresion* contexto = nullptr);
+
+/**
+ * @brief Descomprime LZ78 leyendo la entrada encriptada por bloques desde un flujo.
+ *
+ * Permite procesar archivos más grandes que la memoria disponible: solo se mantienen
+ * el diccionario y un bloque de entrada, y los tamaños se cuentan con 64 bits.
+ *
+ * @param entrada Flujo binario con los datos encriptados y comprimidos.
+ * @param claveXOR Clave XOR para desencriptar.
+ * @param rotacionBits Número de bits para rotar a la derecha (0-7).
+ * @param sumidero Destino de los bytes descomprimidos (por ejemplo un @ref SumideroArchivo).
+ * @param total Referencia donde se almacena el tamaño total descomprimido.
+ * @param tamañoBloque Bytes que se leen por bloque (1 MiB por defecto).
+ * @return true si la descompresión fue válida, false en caso contrario.
+ */
+bool descompresionLZ78Flujo(std::istream& entrada, unsigned char claveXOR, int rotacionBits,
+                            Sumidero& sumidero, uint64_t& total, size_t tamañoBloque = 1 << 20);
+
+/**
+ * @brief Como la versión por bloques, con datos cifrados con cualquier esquema.
+ */
+bool descompresionLZ78Flujo(std::istream& entrada, const ClaveCifrado& cifrado, Sumidero& sumidero,
+                            uint64_t& total, size_t tamañoBloque = 1 << 20);
+
+/**
+ * @brief Fija los hilos de @ref descompresionLZ78Paralela al construir el texto de un ganador
+ *        (1 por defecto; 0 usa todos los núcleos).
+ */
+void ConfigurarDescompresionParalela(int numHilos);
+
+/** @brief Hilos configurados con @ref ConfigurarDescompresionParalela. */
+int HilosDescompresion();
+
+/**
+ * @brief Descomprime LZ78 repartiendo las ternas entre varios hilos.
+ *
+ * Arma en serie el diccionario referenciable, calcula en paralelo la longitud del texto de
+ * cada tramo de ternas, obtiene la posición de cada tramo con una suma de prefijos y escribe
+ * los tramos en paralelo en el buffer de `salida`. Acepta y rechaza exactamente las mismas
+ * entradas que @ref descompresionLZ78Flujo, que se usa con un hilo o con entradas chicas.
+ *
+ * @param salida Sumidero donde queda el texto completo.
+ * @param total Referencia donde se almacena el tamaño total descomprimido.
+ * @param numHilos Cantidad de hilos (0 usa todos los núcleos).
+ * @param contexto Contexto del que se toma el diccionario (opcional).
+ * @return true si la descompresión fue válida, false en caso contrario.
+ */
+bool descompresionLZ78Paralela(const unsigned char* data, size_t size, const ClaveCifrado& cifrado,
+                               SumideroMemoria& salida, size_t& total, int numHilos,
+                               ContextoDescompresion* contexto = nullptr);
+
+/**
+ * @brief Igual, para un sumidero cualquiera (por ejemplo un @ref SumideroArchivo).
+ *
+ * La segunda pasada arma el texto de a ventanas de hasta 64 MiB de tramos consecutivos y
+ * entrega cada ventana en orden, así que la memoria no crece con el tamaño del texto.
+ */
+bool descompresionLZ78Paralela(const unsigned char* data, size_t size, const ClaveCifrado& cifrado,
+                               Sumidero& salida, size_t& total, int numHilos,
+                               ContextoDescompresion* contexto = nullptr);
+
+/**
+ * @brief Base de los compresores: acumula ternas, las encripta por bloques y las entrega a un sumidero.
+ *
+ * Cada bloque se encripta en el lugar con @ref Cifrar justo antes de entregarlo,
+ * mientras todavía está en caché. Si el sumidero rechaza un bloque la compresión falla.
+ */
+class CompresorTernas {
+public:
+    CompresorTernas(const CompresorTernas&) = delete;
+    CompresorTernas& operator=(const CompresorTernas&) = delete;
+
+    /** @brief Bytes comprimidos y encriptados producidos hasta ahora. */
+    uint64_t total() const { return totalSalida + usadoSalida; }
+
+protected:
+    CompresorTernas(const ClaveCifrado& cifrado, Sumidero& sumidero);
+    ~CompresorTernas();
+
+    /** @brief Agrega una terna sin encriptar al bloque de salida. */
+    void agregarTerna(unsigned char byte1, unsigned char byte2, unsigned char byte3) {
+        salida[usadoSalida] = byte1;
+        salida[usadoSalida + 1] = byte2;
+        salida[usadoSalida + 2] = byte3;
+        usadoSalida += 3;
+        if (usadoSalida == CAPACIDAD_SALIDA) {
+            vaciarSalida();
+        }
+    }
+
+    void vaciarSalida();
+    bool rechazar();
+    bool terminar();
+
+    bool invalido;
+
+private:
+    static const size_t CAPACIDAD_SALIDA = 3 * MAX_ENTRADAS_LZ78;
+
+    ClaveCifrado cifrado;
+    Sumidero& sumidero;
+    unsigned char* salida;
+    size_t usadoSalida;
+    uint64_t totalSalida;
+};
+
+/**
+ * @brief Compresor RLE incremental: corridas de 1 a 255 caracteres iguales por terna.
+ *
+ * El texto puede llegar en bloques de cualquier tamaño; una corrida puede continuar
+ * en el bloque siguiente. Solo acepta caracteres del alfabeto activo, como el descompresor.
+ */
+class CompresorRLE : public CompresorTernas {
+public:
+    CompresorRLE(unsigned char claveXOR, int rotacionBits, Sumidero& sumidero);
+    CompresorRLE(const ClaveCifrado& cifrado, Sumidero& sumidero);
+
+    /** @brief Comprime el siguiente bloque de texto. */
+    bool procesar(const unsigned char* texto, size_t cantidad);
+    /** @brief Emite la última corrida y finaliza el sumidero. */
+    bool finalizar();
+
+private:
+    void emitirCorrida(unsigned char letra, uint64_t largo);
+
+    unsigned char caracter;
+    uint64_t cuenta;        // Largo de la corrida en curso (puede pasar de 255)
+};
+
+/**
+ * @brief Compresor LZ78 incremental con un trie de dos niveles de memoria.
+ *
+ * Cada nodo del trie es el índice de su entrada del diccionario. Los primeros
+ * @ref NODOS_DIRECTOS nodos (la raíz y las frases cortas, que son las que más se
+ * recorren) guardan sus 26 hijos en un arreglo directo, juntos en una o dos líneas de
+ * caché. Los hijos de los demás nodos van en una tabla hash con sondeo lineal de 2^17
+ * posiciones de 64 bits que guardan juntos la llave (`padre << 8 | carácter`) y el hijo.
+ *
+ * Las referencias ocupan 16 bits y el descompresor solo guarda las entradas menores a
+ * @ref MAX_ENTRADAS_LZ78, así que al llenarse el diccionario se congela: se siguen
+ * emitiendo frases con las entradas existentes, sin agregar nuevas.
+ */
+class CompresorLZ78 : public CompresorTernas {
+public:
+    CompresorLZ78(unsigned char claveXOR, int rotacionBits, Sumidero& sumidero);
+    CompresorLZ78(const ClaveCifrado& cifrado, Sumidero& sumidero);
+    ~CompresorLZ78();
+
+    /** @brief Comprime el siguiente bloque de texto. */
+    bool procesar(const unsigned char* texto, size_t cantidad);
+    /** @brief Emite la frase pendiente y finaliza el sumidero. */
+    bool finalizar();
+
+private:
+    static const unsigned int BITS_TABLA = 17;
+    static const unsigned int NODOS_DIRECTOS = 4096;
+
+    unsigned short* hijosDirectos;  // NODOS_DIRECTOS x 26 hijos ('a' a 'z'); 0 = sin hijo
+    uint64_t* tabla;                // (llave << 16) | hijo; 0 = posición libre
+    unsigned short* padres;
+    unsigned char* ultimos;
+    unsigned int entradas;      // Índice de la próxima entrada del diccionario
+    unsigned int nodo;          // Frase en curso (0 = vacía)
+};
+
+/**
+ * @brief Comprime un texto con RLE y lo encripta (rotación a la izquierda y luego XOR).
+ *
+ * Produce exactamente las ternas que espera @ref descompresionRLE.
+ *
+ * @param texto Texto a comprimir (solo caracteres del alfabeto activo).
+ * @param size Tamaño del texto.
+ * @param claveXOR Clave XOR.
+ * @param rotacionBits Bits de rotación a la izquierda (0-7).
+ * @param total Referencia donde se almacena el tamaño del resultado.
+ * @return Ternas encriptadas (liberar con delete[]) o nullptr si el texto está vacío o no es válido.
+ */
+unsigned char* compresionRLE(const unsigned char* texto, size_t size, unsigned char claveXOR,
+                             int rotacionBits, size_t& total);
+
+/**
+ * @brief Comprime un texto con LZ78 y lo encripta (rotación a la izquierda y luego XOR).
+ *
+ * Produce exactamente las ternas que espera @ref descompresionLZ78 (ver @ref CompresorLZ78).
+ *
+ * @param texto Texto a comprimir (solo caracteres del alfabeto activo).
+ * @param size Tamaño del texto.
+ * @param claveXOR Clave XOR.
+ * @param rotacionBits Bits de rotación a la izquierda (0-7).
+ * @param total Referencia donde se almacena el tamaño del resultado.
+ * @return Ternas encriptadas (liberar con delete[]) o nullptr si el texto está vacío o no es válido.
+ */
+unsigned char* compresionLZ78(const unsigned char* texto, size_t size, unsigned char claveXOR,
+                              int rotacionBits, size_t& total);
+
+#endif // COMPRESIONDESCOMPRESION_H
@@ -0,0 +1,190 @@
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include "ConjuntoPistas.h"
+using namespace std;
+
+static const unsigned int SIN_TRANSICION = (unsigned int)-1;
+
+ConjuntoPistas::ConjuntoPistas() : numClases(1), minimo(0) {
+    memset(clases, 0, sizeof(clases));
+}
+
+/**
+ * @brief Agrega una pista al conjunto. Hay que volver a llamar a `preparar` antes de buscar.
+ *
+ * @return false si la pista está vacía (no se agrega).
+ */
+bool ConjuntoPistas::agregar(const unsigned char* pista, size_t sizePista) {
+    if (pista == nullptr || sizePista == 0) {
+        return false;
+    }
+    pistas.emplace_back(pista, pista + sizePista);
+    transiciones.clear();
+    return true;
+}
+
+/**
+ * @brief Construye el autómata de Aho–Corasick de todas las pistas.
+ *
+ * Primero se arma el trie de las pistas y luego, recorriéndolo por niveles, se calcula
+ * el enlace de fallo de cada estado y se completan las transiciones faltantes con las
+ * del estado de fallo, así buscar es una sola consulta a la tabla por byte.
+ *
+ * Las columnas de la tabla no son los 256 bytes sino las clases: cada byte que aparece
+ * en alguna pista tiene la suya y todos los demás comparten la clase 0, que siempre
+ * vuelve al estado inicial. Con pistas de texto la tabla ocupa unas 27 columnas por estado.
+ *
+ * @param requeridas Pistas que deben aparecer para aceptar un candidato:
+ *                   1 = cualquiera, @ref PISTAS_TODAS (o más que el total) = todas.
+ */
+void ConjuntoPistas::preparar(int requeridas) {
+    int n = (int)pistas.size();
+    minimo = (requeridas <= 0 || requeridas > n) ? n : requeridas;
+
+    memset(clases, 0, sizeof(clases));
+    numClases = 1;
+    for (const vector<unsigned char>& pista : pistas) {
+        for (unsigned char c : pista) {
+            if (clases[c] == 0) {
+                clases[c] = (unsigned short)numClases++;
+            }
+        }
+    }
+
+    // Trie: el estado 0 es la raíz; las pistas idénticas terminan en el mismo estado
+    transiciones.assign(numClases, SIN_TRANSICION);
+    terminal.assign(1, -1);
+    repetida.assign(n, -1);
+    for (int i = 0; i < n; i++) {
+        unsigned int estado = 0;
+        for (unsigned char c : pistas[i]) {
+            size_t celda = (size_t)estado * numClases + clases[c];
+            if (transiciones[celda] == SIN_TRANSICION) {
+                transiciones[celda] = (unsigned int)terminal.size();
+                transiciones.resize(transiciones.size() + numClases, SIN_TRANSICION);
+                terminal.push_back(-1);
+            }
+            estado = transiciones[celda];
+        }
+        repetida[i] = terminal[estado];
+        terminal[estado] = i;
+    }
+
+    // Enlaces de fallo por niveles: el fallo de un estado siempre está en un nivel anterior
+    size_t numEstados = terminal.size();
+    vector<unsigned int> fallo(numEstados, 0);
+    vector<unsigned int> cola;
+    cola.reserve(numEstados);
+    salida.assign(numEstados, -1);
+    siguienteSalida.assign(numEstados, -1);
+
+    for (unsigned int k = 0; k < numClases; k++) {
+        unsigned int hijo = transiciones[k];
+        if (hijo == SIN_TRANSICION) {
+            transiciones[k] = 0;
+        } else {
+            cola.push_back(hijo);
+        }
+    }
+    for (size_t i = 0; i < cola.size(); i++) {
+        unsigned int estado = cola[i];
+        siguienteSalida[estado] = salida[fallo[estado]];
+        salida[estado] = (terminal[estado] >= 0) ? (int)estado : siguienteSalida[estado];
+
+        size_t fila = (size_t)estado * numClases;
+        size_t filaFallo = (size_t)fallo[estado] * numClases;
+        for (unsigned int k = 0; k < numClases; k++) {
+            unsigned int hijo = transiciones[fila + k];
+            if (hijo == SIN_TRANSICION) {
+                transiciones[fila + k] = transiciones[filaFallo + k];
+            } else {
+                fallo[hijo] = transiciones[filaFallo + k];
+                cola.push_back(hijo);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Anota en `finales` las pistas que terminan en `estado` y todavía no habían aparecido.
+ *
+ * Recorre la cadena de salidas: el propio estado (si alguna pista termina en él) y
+ * los estados de fallo donde termina otra pista que es sufijo de lo leído.
+ *
+ * @return Cantidad de pistas nuevas.
+ */
+int ConjuntoPistas::marcar(unsigned int estado, uint64_t fin, uint64_t* finales) const {
+    int nuevas = 0;
+    for (int s = salida[estado]; s >= 0; s = siguienteSalida[s]) {
+        for (int p = terminal[s]; p >= 0; p = repetida[p]) {
+            if (finales[p] == NO_ENCONTRADA) {
+                finales[p] = fin;
+                nuevas++;
+            }
+        }
+    }
+    return nuevas;
+}
+
+/**
+ * @brief Busca todas las pistas en un texto completo, en una sola pasada.
+ *
+ * A diferencia de la verificación, no se detiene al alcanzar las requeridas: sigue
+ * hasta encontrar todas o terminar el texto, para informar cada pista.
+ *
+ * @param finales Arreglo de `size()` posiciones: fin de la primera aparición de cada
+ *                pista (posición siguiente a su último byte) o @ref NO_ENCONTRADA.
+ * @return Cantidad de pistas encontradas.
+ */
+int ConjuntoPistas::buscarEn(const unsigned char* texto, size_t sizeTexto, uint64_t* finales) const {
+    int n = (int)pistas.size();
+    for (int i = 0; i < n; i++) {
+        finales[i] = NO_ENCONTRADA;
+    }
+    if (!preparado()) {
+        return 0;
+    }
+
+    int encontradas = 0;
+    unsigned int estado = 0;
+    for (size_t i = 0; i < sizeTexto && encontradas < n; i++) {
+        estado = avanzar(estado, texto[i]);
+        if (tieneSalida(estado)) {
+            encontradas += marcar(estado, i + 1, finales);
+        }
+    }
+    return encontradas;
+}
+
+bool LeerDiccionarioPistas(const char* ruta, ConjuntoPistas& conjunto) {
+    ifstream archivo(ruta, ios::binary);
+    if (!archivo.is_open()) {
+        cout << "No se pudo abrir el diccionario de pistas " << ruta << endl;
+        return false;
+    }
+
+    string linea;
+    while (getline(archivo, linea)) {
+        if (!linea.empty() && linea.back() == '\r') {
+            linea.pop_back();
+        }
+        conjunto.agregar((const unsigned char*)linea.data(), linea.size());
+    }
+    return true;
+}
+
+void MostrarPistasEncontradas(const ConjuntoPistas& conjunto, const uint64_t* finales) {
+    for (size_t i = 0; i < conjunto.size(); i++) {
+        const vector<unsigned char>& pista = conjunto.pista(i);
+        size_t mostrar = (pista.size() > 40) ? 40 : pista.size();
+        cout << "  [" << i + 1 << "] \"";
+        cout.write((const char*)pista.data(), (streamsize)mostrar);
+        cout << (mostrar < pista.size() ? "...\"" : "\"");
+        if (finales[i] == ConjuntoPistas::NO_ENCONTRADA) {
+            cout << ": no aparece" << endl;
+        } else {
+            cout << ": posicion " << finales[i] - pista.size() << endl;
+        }
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef CONJUNTOPISTAS_H
+#define CONJUNTOPISTAS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/** @brief Valor de `requeridas` que exige que aparezcan todas las pistas del conjunto. */
+const int PISTAS_TODAS = 0;
+
+/**
+ * @brief Varias pistas compiladas en un solo autómata de Aho–Corasick.
+ *
+ * Una sola pasada por el texto encuentra todas las pistas, sin importar cuántas sean. El
+ * criterio de aceptación es la cantidad de pistas `requeridas()`: 1 acepta con cualquiera,
+ * el total exige todas y un valor intermedio k acepta con k de las n. Como @ref AutomataPista,
+ * una vez preparado es de solo lectura y puede compartirse entre hilos.
+ */
+class ConjuntoPistas {
+public:
+    /** @brief Posición que indica que una pista no apareció. */
+    static const uint64_t NO_ENCONTRADA = (uint64_t)-1;
+
+    ConjuntoPistas();
+
+    /** @brief Agrega una pista (se copia); las vacías se ignoran. */
+    bool agregar(const unsigned char* pista, size_t sizePista);
+    /** @brief Construye el autómata con el criterio dado (1, k o @ref PISTAS_TODAS). */
+    void preparar(int requeridas = 1);
+    /** @brief Indica si el autómata está construido con todas las pistas agregadas. */
+    bool preparado() const { return !transiciones.empty(); }
+
+    /** @brief Cantidad de pistas. */
+    size_t size() const { return pistas.size(); }
+    /** @brief Pistas que deben aparecer para aceptar (entre 1 y `size()`). */
+    int requeridas() const { return minimo; }
+    /** @brief Bytes de la pista `i`. */
+    const std::vector<unsigned char>& pista(size_t i) const { return pistas[i]; }
+
+    /** @brief Estado siguiente tras leer `c`. */
+    unsigned int avanzar(unsigned int estado, unsigned char c) const {
+        return transiciones[(size_t)estado * numClases + clases[c]];
+    }
+    /** @brief Indica si en `estado` termina alguna pista. */
+    bool tieneSalida(unsigned int estado) const { return salida[estado] >= 0; }
+    /** @brief Anota con `fin` las pistas nuevas que terminan en `estado`; retorna cuántas. */
+    int marcar(unsigned int estado, uint64_t fin, uint64_t* finales) const;
+
+    /** @brief Busca todas las pistas en un texto y anota el fin de la primera aparición de cada una. */
+    int buscarEn(const unsigned char* texto, size_t sizeTexto, uint64_t* finales) const;
+
+private:
+    std::vector<std::vector<unsigned char>> pistas;
+    unsigned short clases[256];           // Columna de la tabla para cada byte
+    unsigned int numClases;
+    std::vector<unsigned int> transiciones; // Estados x clases
+    std::vector<int> salida;                // Estado más cercano (él o por fallo) donde termina una pista
+    std::vector<int> siguienteSalida;       // Siguiente estado de la cadena de salidas
+    std::vector<int> terminal;              // Primera pista que termina en cada estado
+    std::vector<int> repetida;              // Siguiente pista idéntica a cada pista
+    int minimo;
+};
+
+/**
+ * @brief Agrega al conjunto una pista por línea del archivo (las líneas vacías se ignoran).
+ *
+ * @return true si el archivo se pudo leer.
+ */
+bool LeerDiccionarioPistas(const char* ruta, ConjuntoPistas& conjunto);
+
+/**
+ * @brief Imprime cada pista del conjunto y la posición donde empieza su primera aparición.
+ *
+ * @param finales Resultado de @ref ConjuntoPistas::buscarEn.
+ */
+void MostrarPistasEncontradas(const ConjuntoPistas& conjunto, const uint64_t* finales);
+
+#endif // CONJUNTOPISTAS_H
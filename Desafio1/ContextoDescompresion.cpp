@@ -0,0 +1,95 @@
+#include <cstdint>
+#include "CompresionDescompresion.h"
+#include "ContextoDescompresion.h"
+using namespace std;
+
+// ---------------------------------------------------------------------------
+// ArenaMonotona
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Crea una arena vacía; el primer bloque se reserva en el primer uso.
+ *
+ * @param tamañoBloque Tamaño mínimo de cada bloque nuevo.
+ */
+ArenaMonotona::ArenaMonotona(size_t tamañoBloque)
+    : bloque(nullptr), capacidadBloque(0), usadoBloque(0),
+      tamañoMinimo(tamañoBloque > 0 ? tamañoBloque : 1), capacidadAnteriores(0), usadoAnteriores(0) {}
+
+ArenaMonotona::~ArenaMonotona() {
+    for (unsigned char* anterior : anteriores) {
+        delete[] anterior;
+    }
+    delete[] bloque;
+}
+
+/**
+ * @brief Reserva `bytes` dentro del bloque actual, o en uno nuevo si no caben.
+ *
+ * Los bloques nuevos duplican al anterior, así la cantidad de bloques crece
+ * con el logaritmo de lo reservado.
+ *
+ * @return Puntero alineado a `alineacion`, válido hasta el próximo `reiniciar`.
+ */
+void* ArenaMonotona::reservar(size_t bytes, size_t alineacion) {
+    if (bloque != nullptr) {
+        uintptr_t actual = (uintptr_t)(bloque + usadoBloque);
+        size_t relleno = (size_t)((alineacion - (actual & (alineacion - 1))) & (alineacion - 1));
+        if (relleno + bytes <= capacidadBloque - usadoBloque) {
+            void* resultado = bloque + usadoBloque + relleno;
+            usadoBloque += relleno + bytes;
+            return resultado;
+        }
+
+        anteriores.push_back(bloque);
+        capacidadAnteriores += capacidadBloque;
+        usadoAnteriores += usadoBloque;
+    }
+
+    // El bloque nuevo alcanza para la reserva incluso en el peor relleno
+    size_t nuevo = (capacidadBloque > 0) ? 2 * capacidadBloque : tamañoMinimo;
+    while (nuevo < bytes + alineacion) {
+        nuevo *= 2;
+    }
+    bloque = new unsigned char[nuevo];
+    capacidadBloque = nuevo;
+    usadoBloque = 0;
+    return reservar(bytes, alineacion);
+}
+
+/**
+ * @brief Invalida todo lo reservado. Si se usó más de un bloque, los junta en uno solo.
+ */
+void ArenaMonotona::reiniciar() {
+    if (!anteriores.empty()) {
+        size_t total = capacidadAnteriores + capacidadBloque;
+        for (unsigned char* anterior : anteriores) {
+            delete[] anterior;
+        }
+        anteriores.clear();
+        delete[] bloque;
+        bloque = new unsigned char[total];
+        capacidadBloque = total;
+        capacidadAnteriores = 0;
+    }
+    usadoBloque = 0;
+    usadoAnteriores = 0;
+}
+
+// ---------------------------------------------------------------------------
+// ContextoDescompresion
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief El primer bloque de la arena alcanza para un @ref DescompresorLZ78 completo.
+ *
+ * El diccionario del descompresor clásico depende del tamaño de la entrada; si no
+ * cabe, la arena crece en el primer candidato y conserva ese tamaño.
+ */
+ContextoDescompresion::ContextoDescompresion()
+    : memoria(DescompresorLZ78::BYTES_TRABAJO) {}
+
+void ContextoDescompresion::reiniciar() {
+    memoria.reiniciar();
+    texto.descartar();
+}
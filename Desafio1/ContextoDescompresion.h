@@ -0,0 +1,71 @@
+#ifndef CONTEXTODESCOMPRESION_H
+#define CONTEXTODESCOMPRESION_H
+
+#include <cstddef>
+#include <vector>
+#include "Sumideros.h"
+
+/**
+ * @brief Memoria de trabajo que se reparte por desplazamiento y se libera toda junta.
+ *
+ * `reservar` solo avanza un índice dentro del bloque actual; si no alcanza, se agrega
+ * un bloque nuevo. `reiniciar` invalida todo lo reservado y, si hubo más de un bloque,
+ * los reemplaza por uno solo del tamaño máximo alcanzado, así a partir del segundo uso
+ * ya no se vuelve al asignador global. Los destructores de lo reservado no se llaman.
+ */
+class ArenaMonotona {
+public:
+    explicit ArenaMonotona(size_t tamañoBloque = 1 << 20);
+    ~ArenaMonotona();
+    ArenaMonotona(const ArenaMonotona&) = delete;
+    ArenaMonotona& operator=(const ArenaMonotona&) = delete;
+
+    /** @brief Reserva `bytes` alineados a `alineacion` (potencia de 2); vale hasta el próximo `reiniciar`. */
+    void* reservar(size_t bytes, size_t alineacion = alignof(std::max_align_t));
+    /** @brief Reserva un arreglo de `cantidad` elementos de tipo `T` sin inicializar. */
+    template <typename T>
+    T* reservarArreglo(size_t cantidad) {
+        return static_cast<T*>(reservar(cantidad * sizeof(T), alignof(T)));
+    }
+    /** @brief Libera de una vez todo lo reservado, conservando la memoria para el siguiente uso. */
+    void reiniciar();
+    /** @brief Bytes reservados desde el último `reiniciar`. */
+    size_t usado() const { return usadoAnteriores + usadoBloque; }
+    /** @brief Bytes que ocupan los bloques. */
+    size_t capacidad() const { return capacidadAnteriores + capacidadBloque; }
+
+private:
+    unsigned char* bloque;
+    size_t capacidadBloque;
+    size_t usadoBloque;
+    size_t tamañoMinimo;
+    std::vector<unsigned char*> anteriores; // Bloques llenos desde el último reinicio
+    size_t capacidadAnteriores;
+    size_t usadoAnteriores;
+};
+
+/**
+ * @brief Memoria reutilizable para descomprimir muchos candidatos seguidos en un mismo hilo.
+ *
+ * Los descompresores toman de la arena el diccionario y el buffer de salida, y
+ * @ref DescomprimirConPista acumula el texto en `salida()`. Entre candidatos se llama a
+ * `reiniciar`, que no devuelve nada al asignador global: tras el primer candidato la
+ * búsqueda ya no reserva memoria. No debe reiniciarse mientras un @ref DescompresorLZ78
+ * creado con este contexto siga vivo. Cada hilo necesita su propio contexto.
+ */
+class ContextoDescompresion {
+public:
+    ContextoDescompresion();
+
+    ArenaMonotona& arena() { return memoria; }
+    /** @brief Sumidero en memoria cuya capacidad se conserva entre candidatos. */
+    SumideroMemoria& salida() { return texto; }
+    /** @brief Deja la arena y el sumidero vacíos para el siguiente candidato. */
+    void reiniciar();
+
+private:
+    ArenaMonotona memoria;
+    SumideroMemoria texto;
+};
+
+#endif // CONTEXTODESCOMPRESION_H
@@ -1,13 +1,50 @@
 TEMPLATE = app
-CONFIG += console c++17
+CONFIG += console c++17 thread
 CONFIG -= app_bundle
 CONFIG -= qt
 
 SOURCES += \
+        Alfabeto.cpp \
+        ArchivoMapeado.cpp \
+        BuscadorPista.cpp \
+        BusquedaParalela.cpp \
         BusquedaParametros.cpp \
+        CacheParametros.cpp \
         CompresionDescompresion.cpp \
+        ConjuntoPistas.cpp \
+        ContextoDescompresion.cpp \
+        DescompresionParalela.cpp \
+        EscritorResultados.cpp \
+        EsquemasCifrado.cpp \
+        FiltrosCandidatos.cpp \
+        IndiceDescompresion.cpp \
         ManipulacionTexto.cpp \
+        Metricas.cpp \
+        OperacionesDeBits.cpp \
+        ProcesamientoLotes.cpp \
+        ProgresoBusqueda.cpp \
+        Sumideros.cpp \
+        TablasCifrado.cpp \
         main.cpp
 
 HEADERS += \
-    Funciones.h
+    Alfabeto.h \
+    ArchivoMapeado.h \
+    BuscadorPista.h \
+    BusquedaParametros.h \
+    CacheParametros.h \
+    CompresionDescompresion.h \
+    ConjuntoPistas.h \
+    ContextoDescompresion.h \
+    EscritorResultados.h \
+    EsquemasCifrado.h \
+    FiltrosCandidatos.h \
+    Funciones.h \
+    IndiceDescompresion.h \
+    ManipulacionTexto.h \
+    Metricas.h \
+    OperacionesDeBits.h \
+    ProcesamientoLotes.h \
+    ProgresoBusqueda.h \
+    Sumideros.h \
+    TablasCifrado.h
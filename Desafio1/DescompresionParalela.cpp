@@ -0,0 +1,367 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "Alfabeto.h"
+#include "CompresionDescompresion.h"
+#include "ContextoDescompresion.h"
+#include "EsquemasCifrado.h"
+#include "Metricas.h"
+#include "Sumideros.h"
+using namespace std;
+
+static const size_t MINIMO_LZ78_PARALELO = (size_t)1 << 20;  // Bytes de entrada; menos no compensa los hilos
+static const size_t TRAMOS_POR_HILO = 8;                      // Tramos chicos reparten mejor frases desparejas
+static const size_t TERNAS_BLOQUE = 1365;                     // Ternas descifradas por bloque
+static const size_t TERNAS_TRAMO = 16 * TERNAS_BLOQUE;        // Tramos más largos no caben varios por ventana
+static const size_t VENTANA_SALIDA = (size_t)64 << 20;        // Texto armado por vez para un sumidero cualquiera
+static const uint64_t SIN_RECHAZO = UINT64_MAX;
+
+static atomic<int> hilosDescompresion(1);
+
+void ConfigurarDescompresionParalela(int numHilos) {
+    if (numHilos <= 0) {
+        numHilos = (int)thread::hardware_concurrency();
+    }
+    hilosDescompresion = (numHilos > 0) ? numHilos : 1;
+}
+
+int HilosDescompresion() {
+    return hilosDescompresion.load();
+}
+
+/**
+ * @brief Diccionario y reparto compartidos por los hilos; solo se leen durante las pasadas paralelas.
+ */
+struct EstadoLZ78Paralelo {
+    const unsigned char* data;
+    const ClaveCifrado* cifrado;
+    uint64_t numTernas;
+    const unsigned short* padres;
+    const unsigned int* longitudes;
+    const unsigned char* caracteres;
+    vector<uint64_t> inicioTramo;    // numTramos + 1 límites en ternas
+    vector<uint64_t> salidaTramo;    // Longitud del texto de cada tramo; luego, su posición
+    unsigned char* destino = nullptr;
+    uint64_t inicioDestino = 0;      // Posición en el texto del primer byte de `destino`
+    atomic<size_t> siguiente;
+    atomic<uint64_t> rechazo;        // Terna inválida de menor índice << 8 | MotivoRechazo, o SIN_RECHAZO
+
+    EstadoLZ78Paralelo() : siguiente(0), rechazo(SIN_RECHAZO) {}
+};
+
+/**
+ * @brief Anota el rechazo de la terna `terna` si es anterior a todos los anotados.
+ *
+ * Así queda el de la primera terna inválida, el mismo que encuentra el recorrido en serie,
+ * sin importar qué hilo llegue antes.
+ */
+static void AnotarRechazo(EstadoLZ78Paralelo& estado, uint64_t terna, MotivoRechazo motivo) {
+    uint64_t nuevo = (terna << 8) | (uint64_t)motivo;
+    uint64_t actual = estado.rechazo.load();
+    while (nuevo < actual && !estado.rechazo.compare_exchange_weak(actual, nuevo)) {
+    }
+}
+
+/**
+ * @brief Primera pasada de un tramo: valida sus ternas y suma las longitudes de sus frases.
+ *
+ * Si el tramo tiene una terna inválida, la suma llega hasta la terna anterior. Un tramo
+ * posterior a un rechazo ya anotado se abandona: su suma no se va a usar.
+ */
+static void MedirTramo(EstadoLZ78Paralelo& estado, size_t tramo) {
+    const Alfabeto& alfabeto = AlfabetoActivo();
+    unsigned char descifrado[3 * TERNAS_BLOQUE];
+    uint64_t suma = 0;
+
+    for (uint64_t terna = estado.inicioTramo[tramo]; terna < estado.inicioTramo[tramo + 1];
+         terna += TERNAS_BLOQUE) {
+        if ((estado.rechazo.load(memory_order_relaxed) >> 8) < terna) {
+            return;
+        }
+        uint64_t resto = estado.inicioTramo[tramo + 1] - terna;
+        size_t cantidad = (resto < TERNAS_BLOQUE) ? (size_t)resto : TERNAS_BLOQUE;
+        estado.cifrado->descifrar(descifrado, estado.data + terna * 3, cantidad * 3, terna * 3);
+
+        size_t validas = alfabeto.primeraTernaInvalida(descifrado, cantidad);
+        for (size_t t = 0; t < cantidad; t++) {
+            // La terna `i` puede referirse a las entradas 0 a i, igual que en el recorrido en serie
+            unsigned int numero = ((unsigned int)descifrado[3 * t] << 8) | descifrado[3 * t + 1];
+            if (t == validas || numero > terna + t) {
+                AnotarRechazo(estado, terna + t, (t == validas) ? RECHAZO_CARACTER : RECHAZO_REFERENCIA);
+                estado.salidaTramo[tramo] = suma;
+                return;
+            }
+            suma += estado.longitudes[numero] + 1;
+        }
+    }
+    estado.salidaTramo[tramo] = suma;
+}
+
+/**
+ * @brief Segunda pasada de un tramo: escribe cada frase en su posición siguiendo los padres.
+ */
+static void EscribirTramo(EstadoLZ78Paralelo& estado, size_t tramo) {
+    unsigned char descifrado[3 * TERNAS_BLOQUE];
+    unsigned char* destino = estado.destino + (estado.salidaTramo[tramo] - estado.inicioDestino);
+
+    for (uint64_t terna = estado.inicioTramo[tramo]; terna < estado.inicioTramo[tramo + 1];
+         terna += TERNAS_BLOQUE) {
+        uint64_t resto = estado.inicioTramo[tramo + 1] - terna;
+        size_t cantidad = (resto < TERNAS_BLOQUE) ? (size_t)resto : TERNAS_BLOQUE;
+        estado.cifrado->descifrar(descifrado, estado.data + terna * 3, cantidad * 3, terna * 3);
+
+        for (size_t t = 0; t < cantidad; t++) {
+            unsigned int numero = ((unsigned int)descifrado[3 * t] << 8) | descifrado[3 * t + 1];
+            unsigned int len = estado.longitudes[numero] + 1;
+            destino[len - 1] = descifrado[3 * t + 2];
+            unsigned int nodo = numero;
+            for (int j = (int)len - 2; j >= 0; j--) {
+                destino[j] = estado.caracteres[nodo];
+                nodo = estado.padres[nodo];
+            }
+            destino += len;
+        }
+    }
+}
+
+/**
+ * @brief Reparte los tramos [desde, hasta) entre los hilos: cada uno toma el siguiente libre.
+ */
+static void RecorrerTramos(EstadoLZ78Paralelo& estado, int numHilos, void (*pasada)(EstadoLZ78Paralelo&, size_t),
+                           size_t desde, size_t hasta) {
+    estado.siguiente = desde;
+    auto trabajador = [&estado, hasta, pasada]() {
+        for (size_t tramo = estado.siguiente++; tramo < hasta; tramo = estado.siguiente++) {
+            pasada(estado, tramo);
+        }
+    };
+
+    vector<thread> hilos;
+    for (int i = 1; i < numHilos; i++) {
+        hilos.emplace_back(trabajador);
+    }
+    trabajador();
+    for (thread& h : hilos) {
+        h.join();
+    }
+}
+
+/**
+ * @brief Segunda pasada para un sumidero cualquiera: arma el texto de a ventanas de tramos
+ *        consecutivos y entrega cada una en orden.
+ *
+ * Cada ventana ocupa a lo sumo VENTANA_SALIDA bytes (o el tramo más largo, si es mayor), así
+ * que la memoria no depende del tamaño del texto. Si el sumidero deja de pedir datos no se
+ * arman más ventanas: las ternas ya se validaron en la primera pasada.
+ */
+static void EscribirVentanas(EstadoLZ78Paralelo& estado, int numHilos, uint64_t total, Sumidero& salida) {
+    size_t numTramos = estado.salidaTramo.size();
+    auto finTramo = [&estado, numTramos, total](size_t tramo) {
+        return (tramo + 1 < numTramos) ? estado.salidaTramo[tramo + 1] : total;
+    };
+
+    uint64_t capacidad = VENTANA_SALIDA;
+    for (size_t tramo = 0; tramo < numTramos; tramo++) {
+        uint64_t largo = finTramo(tramo) - estado.salidaTramo[tramo];
+        capacidad = (largo > capacidad) ? largo : capacidad;
+    }
+    capacidad = (total < capacidad) ? total : capacidad;
+    unsigned char* ventana = new unsigned char[(size_t)capacidad];
+
+    size_t desde = 0;
+    bool produciendo = true;
+    while (produciendo && desde < numTramos) {
+        uint64_t inicio = estado.salidaTramo[desde];
+        size_t hasta = desde + 1;
+        while (hasta < numTramos && finTramo(hasta) - inicio <= capacidad) {
+            hasta++;
+        }
+        estado.destino = ventana;
+        estado.inicioDestino = inicio;
+        RecorrerTramos(estado, numHilos, EscribirTramo, desde, hasta);
+        produciendo = salida.escribir(ventana, (size_t)(finTramo(hasta - 1) - inicio));
+        desde = hasta;
+    }
+    delete[] ventana;
+}
+
+/**
+ * @brief Construye en serie el diccionario referenciable (las primeras 65535 ternas).
+ *
+ * @param parcial Salida: longitud del texto de las ternas anteriores a la inválida.
+ * @return -1 si las ternas son válidas, o el motivo del rechazo.
+ */
+static int ConstruirDiccionario(const unsigned char* data, uint64_t numTernas, const ClaveCifrado& cifrado,
+                                unsigned short* padres, unsigned int* longitudes, unsigned char* caracteres,
+                                uint64_t& parcial) {
+    const Alfabeto& alfabeto = AlfabetoActivo();
+    unsigned char descifrado[3 * TERNAS_BLOQUE];
+    uint64_t entradas = (numTernas < MAX_ENTRADAS_LZ78 - 1) ? numTernas : MAX_ENTRADAS_LZ78 - 1;
+    padres[0] = 0;
+    longitudes[0] = 0;
+    caracteres[0] = '\0';
+    parcial = 0;
+
+    for (uint64_t terna = 0; terna < entradas; terna += TERNAS_BLOQUE) {
+        size_t cantidad = (entradas - terna < TERNAS_BLOQUE) ? (size_t)(entradas - terna) : TERNAS_BLOQUE;
+        cifrado.descifrar(descifrado, data + terna * 3, cantidad * 3, terna * 3);
+        size_t validas = alfabeto.primeraTernaInvalida(descifrado, cantidad);
+        for (size_t t = 0; t < cantidad; t++) {
+            unsigned int numero = ((unsigned int)descifrado[3 * t] << 8) | descifrado[3 * t + 1];
+            if (t == validas) {
+                return RECHAZO_CARACTER;
+            }
+            if (numero > terna + t) {
+                return RECHAZO_REFERENCIA;
+            }
+            size_t entrada = (size_t)(terna + t + 1);
+            padres[entrada] = (unsigned short)numero;
+            longitudes[entrada] = longitudes[numero] + 1;
+            caracteres[entrada] = descifrado[3 * t + 2];
+            parcial += longitudes[entrada];
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Descomprime LZ78 con varios hilos en `salida`.
+ *
+ * Las referencias son de 16 bits, así que solo las primeras 65535 ternas agregan entradas
+ * referenciables: ese diccionario se arma en serie y es chico. Con él, la longitud de la
+ * frase de cada terna se conoce sin descomprimir las anteriores. Las ternas se reparten
+ * en tramos contiguos; una primera pasada en paralelo valida cada tramo y suma las
+ * longitudes de sus frases, una suma de prefijos da la posición de cada tramo en el texto
+ * y una segunda pasada en paralelo escribe las frases directamente en su lugar del buffer
+ * compartido. Los tramos no se superponen, así que los hilos no se sincronizan al escribir.
+ * Con `memoria` el buffer compartido es el texto completo dentro de ese sumidero; si no, la
+ * segunda pasada se hace de a ventanas (@ref EscribirVentanas).
+ *
+ * El resultado, el motivo del rechazo y los bytes que se registran en las métricas son los
+ * mismos que los de @ref descompresionLZ78Flujo: de las ternas inválidas se informa la de
+ * menor índice. Con un solo hilo o con entradas de menos de 1 MiB se usa directamente
+ * @ref descompresionLZ78Flujo.
+ */
+static bool DescomprimirLZ78Paralelo(const unsigned char* data, size_t size, const ClaveCifrado& cifrado,
+                                     Sumidero& salida, SumideroMemoria* memoria, size_t& total, int numHilos,
+                                     ContextoDescompresion* contexto) {
+    if (numHilos <= 0) {
+        numHilos = (int)thread::hardware_concurrency();
+    }
+    if (numHilos <= 1 || size < MINIMO_LZ78_PARALELO) {
+        return descompresionLZ78Flujo(data, size, cifrado, salida, total, contexto);
+    }
+
+    total = 0;
+    if (data == nullptr || size % 3 != 0) {
+        RegistrarRechazo(METODO_LZ78, RECHAZO_TAMAÑO);
+        RegistrarDescompresion(METODO_LZ78, 0);
+        return false;
+    }
+    uint64_t numTernas = size / 3;
+
+    // Diccionario desde la arena del contexto, como en DescompresorLZ78
+    unsigned short* padres;
+    unsigned int* longitudes;
+    unsigned char* caracteres;
+    if (contexto != nullptr) {
+        ArenaMonotona& arena = contexto->arena();
+        padres = arena.reservarArreglo<unsigned short>(MAX_ENTRADAS_LZ78);
+        longitudes = arena.reservarArreglo<unsigned int>(MAX_ENTRADAS_LZ78);
+        caracteres = arena.reservarArreglo<unsigned char>(MAX_ENTRADAS_LZ78);
+    } else {
+        padres = new unsigned short[MAX_ENTRADAS_LZ78];
+        longitudes = new unsigned int[MAX_ENTRADAS_LZ78];
+        caracteres = new unsigned char[MAX_ENTRADAS_LZ78];
+    }
+
+    EstadoLZ78Paralelo estado;
+    uint64_t parcial = 0;  // Bytes que produjo el recorrido hasta la primera terna inválida
+    int rechazo = ConstruirDiccionario(data, numTernas, cifrado, padres, longitudes, caracteres, parcial);
+
+    if (rechazo < 0) {
+        estado.data = data;
+        estado.cifrado = &cifrado;
+        estado.numTernas = numTernas;
+        estado.padres = padres;
+        estado.longitudes = longitudes;
+        estado.caracteres = caracteres;
+
+        size_t numTramos = (size_t)numHilos * TRAMOS_POR_HILO;
+        if (numTramos < (numTernas + TERNAS_TRAMO - 1) / TERNAS_TRAMO) {
+            numTramos = (size_t)((numTernas + TERNAS_TRAMO - 1) / TERNAS_TRAMO);
+        }
+        if (numTramos > numTernas) {
+            numTramos = (size_t)numTernas;
+        }
+        estado.inicioTramo.resize(numTramos + 1);
+        for (size_t i = 0; i <= numTramos; i++) {
+            estado.inicioTramo[i] = numTernas * i / numTramos;
+        }
+        estado.salidaTramo.assign(numTramos, 0);
+
+        // Primera pasada: validar y medir; luego la suma de prefijos da la posición de cada tramo
+        RecorrerTramos(estado, numHilos, MedirTramo, 0, numTramos);
+        uint64_t primerRechazo = estado.rechazo.load();
+        if (primerRechazo != SIN_RECHAZO) {
+            // Los tramos anteriores al de la terna inválida están completos; ese, hasta la terna
+            rechazo = (int)(primerRechazo & 0xFF);
+            uint64_t terna = primerRechazo >> 8;
+            parcial = 0;
+            for (size_t i = 0; i < numTramos && estado.inicioTramo[i] <= terna; i++) {
+                parcial += estado.salidaTramo[i];
+            }
+        } else {
+            uint64_t posicion = 0;
+            for (uint64_t& longitud : estado.salidaTramo) {
+                uint64_t tramo = longitud;
+                longitud = posicion;
+                posicion += tramo;
+            }
+            total = (size_t)posicion;
+
+            // Segunda pasada: cada tramo escribe sus frases en su parte del buffer
+            if (memoria != nullptr) {
+                estado.destino = memoria->extender(total);
+                RecorrerTramos(estado, numHilos, EscribirTramo, 0, numTramos);
+            } else if (total > 0) {
+                EscribirVentanas(estado, numHilos, posicion, salida);
+            }
+        }
+    }
+
+    if (contexto == nullptr) {
+        delete[] padres;
+        delete[] longitudes;
+        delete[] caracteres;
+    }
+
+    if (rechazo < 0 && total == 0) {
+        rechazo = RECHAZO_TAMAÑO;
+    }
+    RegistrarDescompresion(METODO_LZ78, (rechazo >= 0) ? parcial : (uint64_t)total);
+    if (rechazo >= 0) {
+        salida.descartar();
+        RegistrarRechazo(METODO_LZ78, (MotivoRechazo)rechazo);
+        total = 0;
+        return false;
+    }
+    if (!salida.finalizar()) {
+        salida.descartar();
+        RegistrarRechazo(METODO_LZ78, RECHAZO_SALIDA);
+        total = 0;
+        return false;
+    }
+    return true;
+}
+
+bool descompresionLZ78Paralela(const unsigned char* data, size_t size, const ClaveCifrado& cifrado,
+                               SumideroMemoria& salida, size_t& total, int numHilos,
+                               ContextoDescompresion* contexto) {
+    return DescomprimirLZ78Paralelo(data, size, cifrado, salida, &salida, total, numHilos, contexto);
+}
+
+bool descompresionLZ78Paralela(const unsigned char* data, size_t size, const ClaveCifrado& cifrado,
+                               Sumidero& salida, size_t& total, int numHilos, ContextoDescompresion* contexto) {
+    return DescomprimirLZ78Paralelo(data, size, cifrado, salida, nullptr, total, numHilos, contexto);
+}
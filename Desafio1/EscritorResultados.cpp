@@ -0,0 +1,496 @@
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include "EscritorResultados.h"
+#include "Metricas.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#define DESAFIO_POSIX 1
+#endif
+
+using namespace std;
+namespace fs = std::filesystem;
+
+static const size_t BLOQUE_ESCRITURA = (size_t)1 << 20;  // Bytes por llamada a write
+static const size_t ALINEACION_DIRECTA = 4096;          // Alineación de buffer y tamaño para O_DIRECT
+static const size_t MINIMO_DIRECTA = (size_t)8 << 20;    // Los archivos chicos no se benefician
+static const size_t CONSOLA_MAXIMA = (size_t)64 << 10;   // Mensajes acumulados antes de escribir
+
+static atomic<bool> escrituraDirecta(false);
+static atomic<unsigned> contadorTemporales(0);
+
+void ConfigurarEscrituraDirecta(bool activar) {
+    escrituraDirecta = activar;
+}
+
+/**
+ * @brief Nombre del temporal: junto al destino, para que el rename no cambie de sistema de archivos.
+ */
+static string RutaTemporal(const char* rutaArchivo) {
+    string temporal = rutaArchivo;
+    temporal += ".tmp.";
+#ifdef DESAFIO_POSIX
+    temporal += to_string((long)getpid());
+    temporal += ".";
+#endif
+    temporal += to_string(contadorTemporales++);
+    return temporal;
+}
+
+#ifdef DESAFIO_POSIX
+
+/**
+ * @brief Escribe `cantidad` bytes completos, reintentando escrituras parciales e interrumpidas.
+ */
+static bool EscribirTodo(int fd, const unsigned char* datos, size_t cantidad) {
+    while (cantidad > 0) {
+        ssize_t escritos = write(fd, datos, cantidad);
+        if (escritos < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        datos += escritos;
+        cantidad -= (size_t)escritos;
+    }
+    return true;
+}
+
+/**
+ * @brief Escribe con la caché de páginas, de a bloques de BLOQUE_ESCRITURA.
+ */
+static bool EscribirBloques(int fd, const unsigned char* datos, size_t size) {
+    for (size_t escrito = 0; escrito < size; escrito += BLOQUE_ESCRITURA) {
+        size_t cantidad = (size - escrito < BLOQUE_ESCRITURA) ? size - escrito : BLOQUE_ESCRITURA;
+        if (!EscribirTodo(fd, datos + escrito, cantidad)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#ifdef O_DIRECT
+
+/**
+ * @brief Escribe la parte alineada con O_DIRECT a través de un buffer alineado y el resto normal.
+ *
+ * Si el kernel rechaza O_DIRECT a mitad de camino (EINVAL), se quita la bandera y se
+ * sigue con la escritura normal desde la misma posición.
+ */
+static bool EscribirDirecto(int fd, const unsigned char* datos, size_t size) {
+    unsigned char* alineado = static_cast<unsigned char*>(aligned_alloc(ALINEACION_DIRECTA, BLOQUE_ESCRITURA));
+    size_t alineados = size - size % ALINEACION_DIRECTA;
+    size_t escrito = 0;
+    bool directo = (alineado != nullptr);
+
+    while (directo && escrito < alineados) {
+        size_t cantidad = (alineados - escrito < BLOQUE_ESCRITURA) ? alineados - escrito : BLOQUE_ESCRITURA;
+        memcpy(alineado, datos + escrito, cantidad);
+        ssize_t escritos = write(fd, alineado, cantidad);
+        if (escritos < 0 && errno == EINTR) {
+            continue;
+        }
+        if (escritos <= 0 || (size_t)escritos % ALINEACION_DIRECTA != 0) {
+            if (escritos > 0) {
+                escrito += (size_t)escritos;
+            }
+            directo = false;
+            break;
+        }
+        escrito += (size_t)escritos;
+    }
+    free(alineado);
+
+    // La cola que no completa un bloque alineado va por la escritura normal
+    int banderas = fcntl(fd, F_GETFL);
+    if (banderas < 0 || fcntl(fd, F_SETFL, banderas & ~O_DIRECT) < 0) {
+        return false;
+    }
+    return EscribirBloques(fd, datos + escrito, size - escrito);
+}
+
+#endif // O_DIRECT
+
+/**
+ * @brief Lleva a disco la entrada del directorio que contiene `rutaArchivo`, para que el
+ *        rename sobreviva a una caída.
+ *
+ * Algunos sistemas de archivos no admiten fsync sobre directorios (EINVAL); ahí no hay
+ * nada más que hacer y no se considera un error.
+ */
+static bool SincronizarDirectorio(const char* rutaArchivo) {
+    fs::path directorio = fs::path(rutaArchivo).parent_path();
+    if (directorio.empty()) {
+        directorio = ".";
+    }
+    int fd = open(directorio.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd < 0) {
+        return false;
+    }
+    bool sincronizado = (fsync(fd) == 0 || errno == EINVAL);
+    close(fd);
+    return sincronizado;
+}
+
+/**
+ * @brief Lleva el temporal a disco, lo cierra y lo renombra sobre el destino.
+ *
+ * Siempre cierra `fd`; si algo falla (o `escrito` es false) borra el temporal.
+ */
+static bool ConfirmarTemporal(int fd, bool escrito, const string& temporal, const char* rutaArchivo) {
+    // Sin fsync antes del rename, una caída puede dejar el destino vacío o a medias
+    if (escrito && fsync(fd) != 0) {
+        escrito = false;
+    }
+    if (close(fd) != 0) {
+        escrito = false;
+    }
+    if (!escrito || rename(temporal.c_str(), rutaArchivo) != 0) {
+        unlink(temporal.c_str());
+        return false;
+    }
+    return SincronizarDirectorio(rutaArchivo);
+}
+
+#else
+
+/**
+ * @brief Cierra el temporal y lo renombra sobre el destino; si algo falla lo borra.
+ */
+static bool ConfirmarTemporal(ofstream& archivo, bool escrito, const string& temporal, const char* rutaArchivo) {
+    archivo.close();
+    if (!escrito || !archivo) {
+        remove(temporal.c_str());
+        return false;
+    }
+    error_code error;
+    fs::rename(temporal, rutaArchivo, error);
+    if (error) {
+        remove(temporal.c_str());
+        return false;
+    }
+    return true;
+}
+
+#endif // DESAFIO_POSIX
+
+bool EscribirArchivoAtomico(const char* rutaArchivo, const unsigned char* datos, size_t size, bool directa) {
+    MedidorEtapa medidor(ETAPA_ESCRITURA);
+    if (rutaArchivo == nullptr || (datos == nullptr && size > 0)) {
+        return false;
+    }
+    string temporal = RutaTemporal(rutaArchivo);
+
+#ifdef DESAFIO_POSIX
+    int fd = -1;
+    bool abiertoDirecto = false;
+#ifdef O_DIRECT
+    if (directa && size >= MINIMO_DIRECTA) {
+        fd = open(temporal.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_DIRECT, 0666);
+        abiertoDirecto = (fd >= 0);
+    }
+#else
+    (void)directa;
+#endif
+    if (fd < 0) {
+        // tmpfs y otros sistemas rechazan O_DIRECT al abrir: se abre de nuevo sin él
+        fd = open(temporal.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0666);
+    }
+    if (fd < 0) {
+        return false;
+    }
+
+#ifdef O_DIRECT
+    bool escrito = abiertoDirecto ? EscribirDirecto(fd, datos, size) : EscribirBloques(fd, datos, size);
+#else
+    bool escrito = EscribirBloques(fd, datos, size);
+#endif
+    return ConfirmarTemporal(fd, escrito, temporal, rutaArchivo);
+#else
+    (void)directa;
+    ofstream archivo(temporal, ios::binary | ios::trunc);
+    if (!archivo.is_open()) {
+        return false;
+    }
+    archivo.write(reinterpret_cast<const char*>(datos), (streamsize)size);
+    return ConfirmarTemporal(archivo, archivo.good(), temporal, rutaArchivo);
+#endif
+}
+
+// ---------------------------------------------------------------------------
+// ArchivoAtomico
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Temporal abierto de un @ref ArchivoAtomico, fuera de la cabecera.
+ */
+struct EstadoArchivoAtomico {
+    string ruta;
+    string temporal;
+#ifdef DESAFIO_POSIX
+    int fd = -1;
+#else
+    ofstream archivo;
+#endif
+    bool escrito = true;
+};
+
+ArchivoAtomico::ArchivoAtomico(const char* rutaArchivo) : estado(new EstadoArchivoAtomico) {
+    estado->ruta = rutaArchivo;
+    estado->temporal = RutaTemporal(rutaArchivo);
+#ifdef DESAFIO_POSIX
+    estado->fd = open(estado->temporal.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0666);
+    if (estado->fd < 0) {
+        delete estado;
+        estado = nullptr;
+    }
+#else
+    estado->archivo.open(estado->temporal, ios::binary | ios::trunc);
+    if (!estado->archivo.is_open()) {
+        delete estado;
+        estado = nullptr;
+    }
+#endif
+}
+
+ArchivoAtomico::~ArchivoAtomico() {
+    descartar();
+}
+
+bool ArchivoAtomico::abierto() const {
+    return estado != nullptr;
+}
+
+bool ArchivoAtomico::escribir(const unsigned char* datos, size_t size) {
+    if (estado == nullptr || !estado->escrito) {
+        return false;
+    }
+#ifdef DESAFIO_POSIX
+    estado->escrito = EscribirBloques(estado->fd, datos, size);
+#else
+    estado->archivo.write(reinterpret_cast<const char*>(datos), (streamsize)size);
+    estado->escrito = estado->archivo.good();
+#endif
+    return estado->escrito;
+}
+
+bool ArchivoAtomico::confirmar() {
+    if (estado == nullptr) {
+        return false;
+    }
+    MedidorEtapa medidor(ETAPA_ESCRITURA);
+#ifdef DESAFIO_POSIX
+    bool confirmado = ConfirmarTemporal(estado->fd, estado->escrito, estado->temporal, estado->ruta.c_str());
+#else
+    bool confirmado = ConfirmarTemporal(estado->archivo, estado->escrito, estado->temporal, estado->ruta.c_str());
+#endif
+    delete estado;
+    estado = nullptr;
+    return confirmado;
+}
+
+/**
+ * @brief Deja el temporal vacío, como recién creado.
+ */
+bool ArchivoAtomico::reiniciar() {
+    if (estado == nullptr) {
+        return false;
+    }
+#ifdef DESAFIO_POSIX
+    estado->escrito = (ftruncate(estado->fd, 0) == 0 && lseek(estado->fd, 0, SEEK_SET) == 0);
+#else
+    estado->archivo.close();
+    estado->archivo.open(estado->temporal, ios::binary | ios::trunc);
+    estado->escrito = estado->archivo.is_open();
+#endif
+    return estado->escrito;
+}
+
+void ArchivoAtomico::descartar() {
+    if (estado == nullptr) {
+        return;
+    }
+#ifdef DESAFIO_POSIX
+    close(estado->fd);
+#else
+    estado->archivo.close();
+#endif
+    remove(estado->temporal.c_str());
+    delete estado;
+    estado = nullptr;
+}
+
+// ---------------------------------------------------------------------------
+// EscritorResultados
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Un pedido al escritor: un archivo para guardar o borrar, o solo un mensaje.
+ */
+struct PedidoEscritura {
+    string ruta;                     // Vacía = solo mensaje
+    bool borrar = false;
+    unsigned char* datos = nullptr;
+    size_t size = 0;
+    EscritorResultados::LineaGuardado linea;
+    string texto;
+};
+
+/**
+ * @brief Cola y sincronización del escritor, fuera de la cabecera.
+ */
+struct EstadoEscritor {
+    mutex cerrojo;
+    condition_variable hayEspacio;
+    condition_variable hayPedidos;
+    deque<PedidoEscritura> pedidos;
+    size_t limitePendiente;
+    size_t pendiente = 0;   // Bytes encolados y aún no guardados
+    bool cerrado = false;
+    atomic<int> errores;
+    thread hilo;
+
+    explicit EstadoEscritor(size_t limite) : limitePendiente(limite), errores(0) {}
+};
+
+/**
+ * @brief Escribe los mensajes acumulados con una sola llamada.
+ */
+static void VaciarConsola(string& consola) {
+    if (!consola.empty()) {
+        cout.write(consola.data(), (streamsize)consola.size());
+        cout.flush();
+        consola.clear();
+    }
+}
+
+/**
+ * @brief Ciclo del hilo escritor: guarda en orden de llegada y vacía la consola cuando no hay más pedidos.
+ */
+static void TrabajadorEscritor(EstadoEscritor* estado) {
+    string consola;
+    while (true) {
+        PedidoEscritura pedido;
+        {
+            unique_lock<mutex> lock(estado->cerrojo);
+            if (estado->pedidos.empty()) {
+                // Sin trabajo a la vista: es el momento de mostrar lo acumulado
+                lock.unlock();
+                VaciarConsola(consola);
+                lock.lock();
+            }
+            estado->hayPedidos.wait(lock, [estado] { return estado->cerrado || !estado->pedidos.empty(); });
+            if (estado->pedidos.empty()) {
+                break;
+            }
+            pedido = std::move(estado->pedidos.front());
+            estado->pedidos.pop_front();
+        }
+
+        if (pedido.borrar) {
+            remove(pedido.ruta.c_str());
+        } else if (!pedido.ruta.empty()) {
+            bool guardado = EscribirArchivoAtomico(pedido.ruta.c_str(), pedido.datos, pedido.size,
+                                                   escrituraDirecta.load());
+            delete[] pedido.datos;
+            if (!guardado) {
+                estado->errores++;
+            }
+            {
+                lock_guard<mutex> lock(estado->cerrojo);
+                estado->pendiente -= pedido.size;
+            }
+            estado->hayEspacio.notify_all();
+
+            if (pedido.linea) {
+                consola += pedido.linea(guardado);
+            } else if (!guardado) {
+                consola += "Error al guardar el archivo " + pedido.ruta + "\n";
+            }
+        } else {
+            consola += pedido.texto;
+        }
+
+        if (consola.size() >= CONSOLA_MAXIMA) {
+            VaciarConsola(consola);
+        }
+    }
+    VaciarConsola(consola);
+}
+
+EscritorResultados::EscritorResultados(size_t limitePendiente)
+    : estado(new EstadoEscritor(limitePendiente > 0 ? limitePendiente : 1)) {
+    estado->hilo = thread(TrabajadorEscritor, estado);
+}
+
+EscritorResultados::~EscritorResultados() {
+    terminar();
+    delete estado;
+}
+
+void EscritorResultados::guardar(const string& ruta, unsigned char* datos, size_t size, LineaGuardado linea) {
+    PedidoEscritura pedido;
+    pedido.ruta = ruta;
+    pedido.datos = datos;
+    pedido.size = size;
+    pedido.linea = std::move(linea);
+
+    unique_lock<mutex> lock(estado->cerrojo);
+    estado->hayEspacio.wait(lock, [this, size] {
+        return estado->pendiente == 0 || estado->pendiente + size <= estado->limitePendiente;
+    });
+    estado->pendiente += size;
+    estado->pedidos.push_back(std::move(pedido));
+    estado->hayPedidos.notify_one();
+}
+
+void EscritorResultados::borrar(const string& ruta) {
+    PedidoEscritura pedido;
+    pedido.ruta = ruta;
+    pedido.borrar = true;
+
+    lock_guard<mutex> lock(estado->cerrojo);
+    estado->pedidos.push_back(std::move(pedido));
+    estado->hayPedidos.notify_one();
+}
+
+void EscritorResultados::mostrar(string texto) {
+    PedidoEscritura pedido;
+    pedido.texto = std::move(texto);
+
+    lock_guard<mutex> lock(estado->cerrojo);
+    estado->pedidos.push_back(std::move(pedido));
+    estado->hayPedidos.notify_one();
+}
+
+void EscritorResultados::terminar() {
+    {
+        lock_guard<mutex> lock(estado->cerrojo);
+        estado->cerrado = true;
+        estado->hayPedidos.notify_all();
+    }
+    if (estado->hilo.joinable()) {
+        estado->hilo.join();
+    }
+}
+
+int EscritorResultados::errores() const {
+    return estado->errores.load();
+}
+
+EscritorResultados& EscritorCompartido() {
+    static EscritorResultados escritor;
+    return escritor;
+}
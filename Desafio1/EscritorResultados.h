@@ -0,0 +1,117 @@
+#ifndef ESCRITORRESULTADOS_H
+#define ESCRITORRESULTADOS_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+/**
+ * @brief Escribe un archivo completo sin que otro proceso pueda ver una versión a medias.
+ *
+ * Los datos se escriben en un temporal junto al destino con `write` de a bloques de
+ * 1 MiB alineados al inicio del archivo, y el temporal se renombra sobre el destino.
+ * En POSIX el temporal se sincroniza con `fsync` antes del rename y el directorio
+ * después, así que tras una caída el destino tiene el contenido viejo o el nuevo completo.
+ * Con `directa`, en Linux se intenta `O_DIRECT` (los bloques se copian a un buffer
+ * alineado y la cola se escribe sin `O_DIRECT`); si el sistema de archivos no lo
+ * admite se usa la escritura normal. Si algo falla, el temporal se borra y el destino
+ * queda como estaba.
+ *
+ * @param rutaArchivo Archivo destino.
+ * @param datos Bytes a escribir.
+ * @param size Cantidad de bytes.
+ * @param directa true para intentar escribir sin pasar por la caché de páginas.
+ * @return true si el destino quedó con el contenido nuevo.
+ */
+bool EscribirArchivoAtomico(const char* rutaArchivo, const unsigned char* datos, size_t size, bool directa = false);
+
+/** @brief Activa `O_DIRECT` para los archivos grandes que guarda @ref EscritorResultados. */
+void ConfigurarEscrituraDirecta(bool activar);
+
+struct EstadoArchivoAtomico;
+
+/**
+ * @brief Archivo que se escribe por partes y reemplaza al destino recién al confirmarse.
+ *
+ * Como @ref EscribirArchivoAtomico, pero sin tener todo el contenido en memoria: las partes
+ * van a un temporal junto al destino, y @ref confirmar lo sincroniza y lo renombra. Si no se
+ * confirma (o se descarta), el temporal se borra y el destino queda como estaba.
+ */
+class ArchivoAtomico {
+public:
+    explicit ArchivoAtomico(const char* rutaArchivo);
+    ~ArchivoAtomico();
+    ArchivoAtomico(const ArchivoAtomico&) = delete;
+    ArchivoAtomico& operator=(const ArchivoAtomico&) = delete;
+
+    /** @brief Indica si el temporal se pudo crear (y aún no se confirmó ni descartó). */
+    bool abierto() const;
+    /** @brief Agrega bytes al temporal. @return false si la escritura falló (ahora o antes). */
+    bool escribir(const unsigned char* datos, size_t size);
+    /** @brief Pone el temporal en lugar del destino. @return true si el destino quedó con el contenido nuevo. */
+    bool confirmar();
+    /** @brief Vacía el temporal para volver a escribirlo desde el principio. */
+    bool reiniciar();
+    /** @brief Borra el temporal sin tocar el destino. */
+    void descartar();
+
+private:
+    EstadoArchivoAtomico* estado;
+};
+
+struct EstadoEscritor;
+
+/**
+ * @brief Hilo escritor con una cola acotada: guarda resultados y agrupa los mensajes de consola.
+ *
+ * Quien encuentra un resultado le entrega el texto con @ref guardar y sigue trabajando;
+ * el hilo escritor lo guarda con @ref EscribirArchivoAtomico y libera el buffer. La cola
+ * se acota por bytes pendientes, así que un productor solo espera si los resultados sin
+ * guardar superan el límite (un resultado más grande que el límite entra solo, con la
+ * cola vacía). Los mensajes se acumulan y se escriben juntos en la consola cuando la
+ * cola se vacía, sin un `flush` por línea.
+ */
+class EscritorResultados {
+public:
+    /** @brief Arma la línea a mostrar cuando termina de guardarse un archivo (vacía = nada). */
+    typedef std::function<std::string(bool guardado)> LineaGuardado;
+
+    static const size_t LIMITE_PENDIENTE = (size_t)256 << 20;
+
+    explicit EscritorResultados(size_t limitePendiente = LIMITE_PENDIENTE);
+    ~EscritorResultados();
+
+    EscritorResultados(const EscritorResultados&) = delete;
+    EscritorResultados& operator=(const EscritorResultados&) = delete;
+
+    /**
+     * @brief Encola un archivo para guardar; el escritor se queda con `datos` y lo libera con delete[].
+     *
+     * @param linea Texto a mostrar al terminar; sin ella solo se informan los errores.
+     */
+    void guardar(const std::string& ruta, unsigned char* datos, size_t size, LineaGuardado linea = nullptr);
+
+    /** @brief Encola el borrado de un archivo, en orden con los guardados anteriores. */
+    void borrar(const std::string& ruta);
+
+    /** @brief Encola un mensaje para la consola, en orden con los guardados anteriores. */
+    void mostrar(std::string texto);
+
+    /** @brief Espera que se guarde todo lo encolado y detiene el hilo; no se puede volver a usar. */
+    void terminar();
+
+    /** @brief Archivos que no se pudieron guardar. */
+    int errores() const;
+
+private:
+    EstadoEscritor* estado;
+};
+
+/**
+ * @brief Escritor compartido por los puntos de control y el volcado de métricas del proceso.
+ *
+ * Se crea al primer uso; `main` llama a @ref EscritorResultados::terminar antes de salir.
+ */
+EscritorResultados& EscritorCompartido();
+
+#endif // ESCRITORRESULTADOS_H
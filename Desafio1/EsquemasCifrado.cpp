@@ -0,0 +1,126 @@
+#include <cstring>
+#include "EsquemasCifrado.h"
+#include "OperacionesDeBits.h"
+using namespace std;
+
+/**
+ * @brief El esquema original usa las implementaciones vectoriales en lugar de la cadena genérica.
+ */
+static void DescifrarOriginal(unsigned char* destino, const unsigned char* origen, size_t tamaño,
+                              uint64_t, const ParametrosCifrado& p) {
+    Descifrar(destino, origen, tamaño, p.clave[0], p.bits);
+}
+
+static void CifrarOriginal(unsigned char* destino, const unsigned char* origen, size_t tamaño,
+                           uint64_t, const ParametrosCifrado& p) {
+    Cifrar(destino, origen, tamaño, p.clave[0], p.bits);
+}
+
+typedef CadenaCifrado<EtapaXOR, EtapaRotarIzquierda> CadenaXORRotarIzquierda;
+typedef CadenaCifrado<EtapaRotarDerecha, EtapaXOR> CadenaRotarDerechaXOR;
+typedef CadenaCifrado<EtapaRotarIzquierda, EtapaXOR> CadenaRotarIzquierdaXOR;
+typedef CadenaCifrado<EtapaXORRepetida, EtapaRotarDerecha> CadenaXORRepetidaRotarDerecha;
+typedef CadenaCifrado<EtapaRotarDerecha, EtapaXORRepetida> CadenaRotarDerechaXORRepetida;
+
+// La cadena genérica del esquema original debe coincidir con sus tablas
+static_assert(!CadenaCifrado<EtapaXOR, EtapaRotarDerecha>::POR_POSICION, "XOR y rotacion no dependen de la posicion");
+static_assert(CadenaXORRepetidaRotarDerecha::POR_POSICION, "la clave repetida depende de la posicion");
+
+/*
+ * Los esquemas con clave de dos bytes recorren 255 * 255 * 8 candidatos; el filtro de
+ * la primera terna (ver PrepararMetodosEsquema) descarta casi todos sin descomprimir.
+ */
+static const EsquemaCifrado ESQUEMAS_CIFRADO[] = {
+    { "xor-rotr", "XOR y rotacion a la derecha (formato original)",
+      DescifrarOriginal, CifrarOriginal, 1, true, false },
+    { "xor-rotl", "XOR y rotacion a la izquierda",
+      TransformarBloque<CadenaXORRotarIzquierda, false>, TransformarBloque<CadenaXORRotarIzquierda, true>,
+      1, true, false },
+    { "rotr-xor", "rotacion a la derecha y luego XOR",
+      TransformarBloque<CadenaRotarDerechaXOR, false>, TransformarBloque<CadenaRotarDerechaXOR, true>,
+      1, true, false },
+    { "rotl-xor", "rotacion a la izquierda y luego XOR",
+      TransformarBloque<CadenaRotarIzquierdaXOR, false>, TransformarBloque<CadenaRotarIzquierdaXOR, true>,
+      1, true, false },
+    { "xor2-rotr", "XOR con clave repetida de 2 bytes y rotacion a la derecha",
+      TransformarBloque<CadenaXORRepetidaRotarDerecha, false>, TransformarBloque<CadenaXORRepetidaRotarDerecha, true>,
+      2, true, true },
+    { "rotr-xor2", "rotacion a la derecha y XOR con clave repetida de 2 bytes",
+      TransformarBloque<CadenaRotarDerechaXORRepetida, false>, TransformarBloque<CadenaRotarDerechaXORRepetida, true>,
+      2, true, true },
+};
+
+static const int NUM_ESQUEMAS = (int)(sizeof(ESQUEMAS_CIFRADO) / sizeof(ESQUEMAS_CIFRADO[0]));
+
+const EsquemaCifrado* EsquemasCifrado(int& cantidad) {
+    cantidad = NUM_ESQUEMAS;
+    return ESQUEMAS_CIFRADO;
+}
+
+const EsquemaCifrado* BuscarEsquemaCifrado(const char* nombre) {
+    for (int i = 0; i < NUM_ESQUEMAS; i++) {
+        if (strcmp(ESQUEMAS_CIFRADO[i].nombre, nombre) == 0) {
+            return &ESQUEMAS_CIFRADO[i];
+        }
+    }
+    return nullptr;
+}
+
+// ---------------------------------------------------------------------------
+// EsquemaCifrado
+// ---------------------------------------------------------------------------
+
+int EsquemaCifrado::totalCandidatos() const {
+    int total = rotacion ? 8 : 1;
+    for (int i = 0; i < longitudClave; i++) {
+        total *= 255;
+    }
+    return total;
+}
+
+ParametrosCifrado EsquemaCifrado::parametros(int indice) const {
+    ParametrosCifrado p;
+    memset(&p, 0, sizeof(p));
+    p.longitudClave = longitudClave;
+    if (rotacion) {
+        p.bits = indice % 8;
+        indice /= 8;
+    }
+    for (int i = longitudClave - 1; i >= 0; i--) {
+        p.clave[i] = (unsigned char)(indice % 255);
+        indice /= 255;
+    }
+    return p;
+}
+
+int EsquemaCifrado::indice(const ParametrosCifrado& p) const {
+    int resultado = 0;
+    for (int i = 0; i < longitudClave; i++) {
+        resultado = resultado * 255 + p.clave[i];
+    }
+    return rotacion ? resultado * 8 + (p.bits & 7) : resultado;
+}
+
+// ---------------------------------------------------------------------------
+// ClaveCifrado
+// ---------------------------------------------------------------------------
+
+ClaveCifrado::ClaveCifrado(unsigned char clave, int bits) : esquemaCifrado(&ESQUEMAS_CIFRADO[0]) {
+    memset(&param, 0, sizeof(param));
+    param.clave[0] = clave;
+    param.longitudClave = 1;
+    param.bits = bits & 7;
+}
+
+ClaveCifrado::ClaveCifrado(const EsquemaCifrado& esquema, int indice)
+    : esquemaCifrado(&esquema), param(esquema.parametros(indice)) {}
+
+ClaveCifrado::ClaveCifrado(const EsquemaCifrado& esquema, const ParametrosCifrado& parametros)
+    : esquemaCifrado(&esquema), param(parametros) {
+    param.longitudClave = esquema.longitudClave;
+    param.bits &= 7;
+}
+
+bool ClaveCifrado::original() const {
+    return esquemaCifrado == &ESQUEMAS_CIFRADO[0];
+}
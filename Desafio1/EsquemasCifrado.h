@@ -0,0 +1,213 @@
+#ifndef ESQUEMASCIFRADO_H
+#define ESQUEMASCIFRADO_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Cantidad de candidatos (clave, bits) del espacio de búsqueda: claves 0-254 por rotaciones 0-7.
+ *
+ * Cada candidato se identifica con el índice `clave * 8 + bits`, que respeta el orden
+ * del ciclo secuencial de @ref BuscarParametros.
+ */
+const int TOTAL_CANDIDATOS = 255 * 8;
+
+/**
+ * @brief Bytes máximos de una clave XOR repetida (ver @ref EtapaXORRepetida).
+ */
+const int MAX_LONGITUD_CLAVE = 4;
+
+/**
+ * @brief Parámetros de un candidato de cualquier esquema de cifrado.
+ *
+ * Cada etapa usa solo lo que necesita: las de XOR leen `clave` y las de rotación `bits`.
+ */
+struct ParametrosCifrado {
+    unsigned char clave[MAX_LONGITUD_CLAVE];
+    int longitudClave;  // Bytes usados de `clave` (1 a MAX_LONGITUD_CLAVE)
+    int bits;           // Bits de rotación (0-7)
+};
+
+/*
+ * Etapas de un esquema de cifrado. Cada una define cómo descifra un byte (`aplicar`) y
+ * su inversa (`invertir`), y si depende de la posición del byte en el archivo. `fase` es
+ * la posición módulo la longitud de la clave; las etapas que no dependen de la posición
+ * la ignoran. Todo es estático e `inline`, así que una @ref CadenaCifrado se compila
+ * como un solo ciclo sin llamadas por byte.
+ */
+
+/** @brief XOR con un byte de clave. */
+struct EtapaXOR {
+    static const bool POR_POSICION = false;
+    static unsigned char aplicar(unsigned char c, size_t, const ParametrosCifrado& p) {
+        return (unsigned char)(c ^ p.clave[0]);
+    }
+    static unsigned char invertir(unsigned char c, size_t, const ParametrosCifrado& p) {
+        return (unsigned char)(c ^ p.clave[0]);
+    }
+};
+
+/** @brief XOR con una clave de varios bytes que se repite a lo largo del archivo. */
+struct EtapaXORRepetida {
+    static const bool POR_POSICION = true;
+    static unsigned char aplicar(unsigned char c, size_t fase, const ParametrosCifrado& p) {
+        return (unsigned char)(c ^ p.clave[fase]);
+    }
+    static unsigned char invertir(unsigned char c, size_t fase, const ParametrosCifrado& p) {
+        return (unsigned char)(c ^ p.clave[fase]);
+    }
+};
+
+/** @brief Rotación de `bits` posiciones a la derecha. */
+struct EtapaRotarDerecha {
+    static const bool POR_POSICION = false;
+    static unsigned char aplicar(unsigned char c, size_t, const ParametrosCifrado& p) {
+        int n = p.bits & 7;
+        return (unsigned char)((c >> n) | (c << ((8 - n) & 7)));
+    }
+    static unsigned char invertir(unsigned char c, size_t, const ParametrosCifrado& p) {
+        int n = p.bits & 7;
+        return (unsigned char)((c << n) | (c >> ((8 - n) & 7)));
+    }
+};
+
+/** @brief Rotación de `bits` posiciones a la izquierda. */
+struct EtapaRotarIzquierda {
+    static const bool POR_POSICION = false;
+    static unsigned char aplicar(unsigned char c, size_t fase, const ParametrosCifrado& p) {
+        return EtapaRotarDerecha::invertir(c, fase, p);
+    }
+    static unsigned char invertir(unsigned char c, size_t fase, const ParametrosCifrado& p) {
+        return EtapaRotarDerecha::aplicar(c, fase, p);
+    }
+};
+
+/**
+ * @brief Composición de etapas en tiempo de compilación: descifrar aplica las etapas en orden
+ *        y cifrar aplica sus inversas en el orden contrario.
+ *
+ * Por ejemplo `CadenaCifrado<EtapaXOR, EtapaRotarDerecha>` es el descifrado original
+ * (XOR y luego rotación a la derecha).
+ */
+template <typename... Etapas>
+struct CadenaCifrado;
+
+template <>
+struct CadenaCifrado<> {
+    static const bool POR_POSICION = false;
+    static unsigned char aplicar(unsigned char c, size_t, const ParametrosCifrado&) { return c; }
+    static unsigned char invertir(unsigned char c, size_t, const ParametrosCifrado&) { return c; }
+};
+
+template <typename Primera, typename... Resto>
+struct CadenaCifrado<Primera, Resto...> {
+    static const bool POR_POSICION = Primera::POR_POSICION || CadenaCifrado<Resto...>::POR_POSICION;
+    static unsigned char aplicar(unsigned char c, size_t fase, const ParametrosCifrado& p) {
+        return CadenaCifrado<Resto...>::aplicar(Primera::aplicar(c, fase, p), fase, p);
+    }
+    static unsigned char invertir(unsigned char c, size_t fase, const ParametrosCifrado& p) {
+        return Primera::invertir(CadenaCifrado<Resto...>::invertir(c, fase, p), fase, p);
+    }
+};
+
+/**
+ * @brief Descifra (o cifra, con `Inversa`) un bloque que empieza en `posicion` del archivo.
+ *
+ * Se instancia una vez por cadena: el ciclo queda especializado y sin llamadas por byte.
+ * Las cadenas que no dependen de la posición no llevan la cuenta de la fase.
+ */
+template <typename Cadena, bool Inversa>
+void TransformarBloque(unsigned char* destino, const unsigned char* origen, size_t tamaño,
+                       uint64_t posicion, const ParametrosCifrado& p) {
+    if (!Cadena::POR_POSICION) {
+        for (size_t i = 0; i < tamaño; i++) {
+            destino[i] = Inversa ? Cadena::invertir(origen[i], 0, p) : Cadena::aplicar(origen[i], 0, p);
+        }
+        return;
+    }
+    size_t periodo = (p.longitudClave > 0) ? (size_t)p.longitudClave : 1;
+    size_t fase = (size_t)(posicion % periodo);
+    for (size_t i = 0; i < tamaño; i++) {
+        destino[i] = Inversa ? Cadena::invertir(origen[i], fase, p) : Cadena::aplicar(origen[i], fase, p);
+        if (++fase == periodo) {
+            fase = 0;
+        }
+    }
+}
+
+/**
+ * @brief Función que transforma un bloque; es el único punto de llamada indirecta (una por bloque).
+ */
+typedef void (*FuncionBloqueCifrado)(unsigned char* destino, const unsigned char* origen, size_t tamaño,
+                                     uint64_t posicion, const ParametrosCifrado& parametros);
+
+/**
+ * @brief Esquema de cifrado: una @ref CadenaCifrado ya instanciada y su espacio de parámetros.
+ *
+ * Los candidatos se numeran de 0 a `totalCandidatos() - 1` con los bits de rotación como
+ * dígito menos significativo y luego los bytes de clave (cada uno de 0 a 254), del último
+ * al primero. Para el esquema "xor-rotr" el índice es `clave * 8 + bits`, el mismo de
+ * @ref TOTAL_CANDIDATOS.
+ */
+struct EsquemaCifrado {
+    const char* nombre;
+    const char* descripcion;
+    FuncionBloqueCifrado descifrar;
+    FuncionBloqueCifrado cifrar;
+    int longitudClave;  // Bytes de clave que se recorren
+    bool rotacion;      // Si se recorren los 8 desplazamientos
+    bool porPosicion;   // Si el descifrado de un byte depende de su posición
+
+    /** @brief Cantidad de candidatos del esquema. */
+    int totalCandidatos() const;
+    /** @brief Parámetros del candidato `indice`. */
+    ParametrosCifrado parametros(int indice) const;
+    /** @brief Índice de unos parámetros (inversa de `parametros`). */
+    int indice(const ParametrosCifrado& parametros) const;
+};
+
+/**
+ * @brief Esquemas disponibles; el primero es "xor-rotr", el formato original.
+ *
+ * @param cantidad Salida con la cantidad de esquemas.
+ */
+const EsquemaCifrado* EsquemasCifrado(int& cantidad);
+
+/**
+ * @brief Busca un esquema por nombre; nullptr si no existe.
+ */
+const EsquemaCifrado* BuscarEsquemaCifrado(const char* nombre);
+
+/**
+ * @brief Un candidato concreto de un esquema: sabe descifrar y cifrar bloques de un archivo.
+ *
+ * Es un valor pequeño que se copia por candidato. El esquema "xor-rotr" usa las
+ * implementaciones vectoriales de @ref Descifrar y @ref Cifrar.
+ */
+class ClaveCifrado {
+public:
+    /** @brief Candidato del esquema original: XOR con `clave` y rotación de `bits` a la derecha. */
+    ClaveCifrado(unsigned char clave, int bits);
+    ClaveCifrado(const EsquemaCifrado& esquema, int indice);
+    ClaveCifrado(const EsquemaCifrado& esquema, const ParametrosCifrado& parametros);
+
+    /** @brief Descifra `tamaño` bytes que empiezan en `posicion` del archivo cifrado. */
+    void descifrar(unsigned char* destino, const unsigned char* origen, size_t tamaño, uint64_t posicion) const {
+        esquemaCifrado->descifrar(destino, origen, tamaño, posicion, param);
+    }
+    /** @brief Cifra `tamaño` bytes que irán en `posicion` del archivo cifrado. */
+    void cifrar(unsigned char* destino, const unsigned char* origen, size_t tamaño, uint64_t posicion) const {
+        esquemaCifrado->cifrar(destino, origen, tamaño, posicion, param);
+    }
+
+    const EsquemaCifrado& esquema() const { return *esquemaCifrado; }
+    const ParametrosCifrado& parametros() const { return param; }
+    /** @brief Si es del esquema original, que tiene caminos con tablas por (clave, bits). */
+    bool original() const;
+
+private:
+    const EsquemaCifrado* esquemaCifrado;
+    ParametrosCifrado param;
+};
+
+#endif // ESQUEMASCIFRADO_H
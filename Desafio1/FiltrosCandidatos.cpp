@@ -0,0 +1,311 @@
+#include <cstring>
+#include "Alfabeto.h"
+#include "EsquemasCifrado.h"
+#include "FiltrosCandidatos.h"
+#include "Metricas.h"
+#include "TablasCifrado.h"
+using namespace std;
+
+/**
+ * @brief Deduce los candidatos LZ78 posibles a partir de la primera terna.
+ *
+ * En LZ78 la primera terna solo puede referenciar la entrada 0 del diccionario,
+ * asi que sus dos primeros bytes desencriptados deben ser cero. Como el XOR y la
+ * rotacion son biyecciones por byte y la rotacion de 0 es 0, eso exige
+ * data[0] == data[1] y fija la clave en data[0] para cualquier rotacion.
+ * Luego el tercer byte debe pertenecer al alfabeto activo con esa clave y rotacion.
+ *
+ * @param data Datos encriptados.
+ * @param size Tamaño de los datos.
+ * @param candidatos Arreglo de al menos 8 posiciones donde se escriben los indices clave * 8 + bits.
+ * @return Cantidad de candidatos escritos (0 a 8).
+ */
+int ResolverInvariantesLZ78(const unsigned char* data, size_t size, int* candidatos) {
+    if (data == nullptr || size < 3 || size % 3 != 0) {
+        return 0;
+    }
+
+    // Ambos bytes de la referencia deben quedar en cero con la misma clave
+    if (data[0] != data[1]) {
+        return 0;
+    }
+
+    int clave = data[0];
+    if (clave >= 255) {
+        return 0;  // Fuera del rango de claves que recorre la busqueda
+    }
+
+    const Alfabeto& alfabeto = AlfabetoActivo();
+    int numCandidatos = 0;
+    for (int bits = 0; bits <= 7; bits++) {
+        unsigned char caracter = TablaDescifrado((unsigned char)clave, bits)[data[2]];
+        if (alfabeto.contiene(caracter)) {
+            candidatos[numCandidatos++] = clave * 8 + bits;
+        }
+    }
+    return numCandidatos;
+}
+
+/**
+ * @brief Anota en una sola pasada los valores presentes en cada posicion de terna.
+ *
+ * Se marca la presencia en tres tablas de 256 entradas y al final se pasan a listas
+ * de valores distintos, que son las que recorre cada candidato.
+ */
+void ConstruirHistogramaTernas(const unsigned char* data, size_t size, HistogramaTernas& histograma) {
+    unsigned char presente[3][256];
+    memset(presente, 0, sizeof(presente));
+
+    histograma.numTernas = (data != nullptr) ? size / 3 : 0;
+    const unsigned char* fin = (data != nullptr) ? data + histograma.numTernas * 3 : data;
+    for (const unsigned char* p = data; p != fin; p += 3) {
+        presente[0][p[0]] = 1;
+        presente[1][p[1]] = 1;
+        presente[2][p[2]] = 1;
+    }
+
+    for (int posicion = 0; posicion < 3; posicion++) {
+        int cantidad = 0;
+        for (int valor = 0; valor < 256; valor++) {
+            if (presente[posicion][valor]) {
+                histograma.valores[posicion][cantidad++] = (unsigned char)valor;
+            }
+        }
+        histograma.cantidad[posicion] = cantidad;
+    }
+}
+
+/**
+ * @brief Indica si todos los valores de una posicion, ya desencriptados, cumplen [minimo, maximo].
+ */
+static bool ValoresEnRango(const HistogramaTernas& histograma, int posicion, const unsigned char* tabla,
+                           unsigned char minimo, unsigned char maximo) {
+    for (int i = 0; i < histograma.cantidad[posicion]; i++) {
+        unsigned char valor = tabla[histograma.valores[posicion][i]];
+        if (valor < minimo || valor > maximo) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Indica si todos los valores de una posicion, ya desencriptados, pertenecen al alfabeto.
+ *
+ * Los valores desencriptados se juntan en un arreglo y se validan de a 16 o 32 bytes.
+ */
+static bool ValoresEnAlfabeto(const HistogramaTernas& histograma, int posicion, const unsigned char* tabla,
+                              const Alfabeto& alfabeto) {
+    unsigned char descifrados[256];
+    size_t cantidad = (size_t)histograma.cantidad[posicion];
+    for (size_t i = 0; i < cantidad; i++) {
+        descifrados[i] = tabla[histograma.valores[posicion][i]];
+    }
+    return alfabeto.primerFuera(descifrados, cantidad) == cantidad;
+}
+
+/**
+ * @brief Aplica a un candidato las validaciones por byte de los descompresores usando el histograma.
+ *
+ * Los caracteres valen para los dos formatos. En RLE la cuenta no puede ser cero; en LZ78
+ * la referencia de la terna i es a lo sumo i, asi que su byte alto no supera el de la
+ * ultima terna.
+ */
+int FiltrarMetodosHistograma(const HistogramaTernas& histograma, unsigned char clave, int bits, int metodos) {
+    return FiltrarMetodosHistograma(histograma, TablaDescifrado(clave, bits), metodos);
+}
+
+int FiltrarMetodosHistograma(const HistogramaTernas& histograma, const unsigned char* tabla, int metodos) {
+    if (histograma.numTernas == 0) {
+        return METODO_NINGUNO;
+    }
+
+    if (!ValoresEnAlfabeto(histograma, 2, tabla, AlfabetoActivo())) {
+        return METODO_NINGUNO;
+    }
+    if ((metodos & METODO_RLE) && !ValoresEnRango(histograma, 1, tabla, 1, 255)) {
+        metodos &= ~METODO_RLE;
+    }
+    if (metodos & METODO_LZ78) {
+        size_t maximaReferencia = histograma.numTernas - 1;
+        unsigned char maximoAlto = (maximaReferencia >> 8) > 255 ? 255 : (unsigned char)(maximaReferencia >> 8);
+        if (!ValoresEnRango(histograma, 0, tabla, 0, maximoAlto)) {
+            metodos &= ~METODO_LZ78;
+        }
+    }
+    return metodos;
+}
+
+/**
+ * @brief Clasifica el formato con las ternas ya descifradas de la muestra.
+ *
+ * Cada terna de la muestra descarta los formatos que la harian invalida; como la
+ * primera terna no puede ser valida en los dos formatos a la vez, queda a lo sumo uno.
+ */
+static int ClasificarMuestra(const unsigned char* muestra, size_t numTernas, int metodos) {
+    const Alfabeto& alfabeto = AlfabetoActivo();
+    metodos &= METODOS_TODOS;
+
+    for (size_t i = 0; i < numTernas && metodos != METODO_NINGUNO; i++) {
+        unsigned char alto = muestra[3 * i];
+        unsigned char bajo = muestra[3 * i + 1];
+        unsigned char caracter = muestra[3 * i + 2];
+
+        if (!alfabeto.contiene(caracter)) {
+            return METODO_NINGUNO;
+        }
+        // La terna i de LZ78 solo puede referenciar las entradas 0 a i
+        if ((((size_t)alto << 8) | bajo) > i) {
+            metodos &= ~METODO_LZ78;
+        }
+        // En RLE el segundo byte es la cuenta de repeticiones
+        if (bajo == 0) {
+            metodos &= ~METODO_RLE;
+        }
+    }
+    return metodos;
+}
+
+/**
+ * @brief Clasifica el formato de un candidato con la primera terna y una muestra del comienzo.
+ */
+int ClasificarFormato(const unsigned char* data, size_t size, unsigned char clave, int bits, int metodos) {
+    size_t numTernas = (data != nullptr) ? size / 3 : 0;
+    if (numTernas == 0 || size % 3 != 0) {
+        return METODO_NINGUNO;
+    }
+
+    const unsigned char* tabla = TablaDescifrado(clave, bits);
+    size_t muestra = (numTernas < (size_t)TERNAS_MUESTRA_FORMATO) ? numTernas : (size_t)TERNAS_MUESTRA_FORMATO;
+    unsigned char descifrado[3 * TERNAS_MUESTRA_FORMATO];
+    for (size_t i = 0; i < 3 * muestra; i++) {
+        descifrado[i] = tabla[data[i]];
+    }
+    return ClasificarMuestra(descifrado, muestra, metodos);
+}
+
+/**
+ * @brief Igual que con (clave, bits), descifrando la muestra con el esquema del candidato.
+ *
+ * Primero se descifra solo la primera terna, que ya descarta la gran mayoria de los
+ * candidatos, y recien despues el resto de la muestra.
+ */
+int ClasificarFormato(const unsigned char* data, size_t size, const ClaveCifrado& cifrado, int metodos) {
+    if (cifrado.original()) {
+        return ClasificarFormato(data, size, cifrado.parametros().clave[0], cifrado.parametros().bits, metodos);
+    }
+
+    size_t numTernas = (data != nullptr) ? size / 3 : 0;
+    if (numTernas == 0 || size % 3 != 0) {
+        return METODO_NINGUNO;
+    }
+
+    unsigned char descifrado[3 * TERNAS_MUESTRA_FORMATO];
+    cifrado.descifrar(descifrado, data, 3, 0);
+    int primera = ClasificarMuestra(descifrado, 1, metodos);
+    if (primera == METODO_NINGUNO) {
+        return primera;
+    }
+
+    size_t muestra = (numTernas < (size_t)TERNAS_MUESTRA_FORMATO) ? numTernas : (size_t)TERNAS_MUESTRA_FORMATO;
+    cifrado.descifrar(descifrado + 3, data + 3, 3 * (muestra - 1), 3);
+    return ClasificarMuestra(descifrado, muestra, primera);
+}
+
+int ElegirMetodos(const unsigned char* data, size_t size, unsigned char clave, int bits, int metodos) {
+    if ((metodos & METODOS_TODOS) != METODOS_TODOS) {
+        return metodos;
+    }
+    return ClasificarFormato(data, size, clave, bits, metodos);
+}
+
+int ElegirMetodos(const unsigned char* data, size_t size, const ClaveCifrado& cifrado, int metodos) {
+    if ((metodos & METODOS_TODOS) != METODOS_TODOS) {
+        return metodos;
+    }
+    return ClasificarFormato(data, size, cifrado, metodos);
+}
+
+/**
+ * @brief Calcula que metodos de descompresion vale la pena probar en cada candidato.
+ *
+ * RLE se prueba en todos los candidatos y LZ78 solo en los que deja pasar
+ * @ref ResolverInvariantesLZ78; despues el histograma de las ternas descarta los
+ * candidatos que fallarian alguna validacion por byte, sin descomprimir nada.
+ *
+ * @param data Datos encriptados.
+ * @param size Tamaño de los datos.
+ * @param metodos Arreglo de TOTAL_CANDIDATOS posiciones con la mascara de metodos por candidato.
+ */
+void PrepararMetodosCandidatos(const unsigned char* data, size_t size, unsigned char* metodos) {
+    for (int i = 0; i < TOTAL_CANDIDATOS; i++) {
+        metodos[i] = METODO_RLE;
+    }
+
+    int candidatos[8];
+    int numCandidatos = ResolverInvariantesLZ78(data, size, candidatos);
+    for (int i = 0; i < numCandidatos; i++) {
+        metodos[candidatos[i]] |= METODO_LZ78;
+    }
+
+    // Con una terna incompleta ningun descompresor acepta los datos
+    if (data == nullptr || size == 0 || size % 3 != 0) {
+        for (int i = 0; i < TOTAL_CANDIDATOS; i++) {
+            metodos[i] = METODO_NINGUNO;
+        }
+        return;
+    }
+
+    HistogramaTernas histograma;
+    ConstruirHistogramaTernas(data, size, histograma);
+    for (int i = 0; i < TOTAL_CANDIDATOS; i++) {
+        int restantes = FiltrarMetodosHistograma(histograma, (unsigned char)(i / 8), i % 8, metodos[i]);
+        metodos[i] = (unsigned char)ElegirMetodos(data, size, (unsigned char)(i / 8), i % 8, restantes);
+    }
+}
+
+/**
+ * @brief Prepara las mascaras de metodos de todos los candidatos de un esquema.
+ *
+ * Es el mismo filtrado de @ref PrepararMetodosCandidatos, generalizado: si el esquema no
+ * depende de la posicion, cada candidato se reduce a una tabla de 256 bytes (se descifran
+ * los 256 valores una vez) y pasa por el histograma; en todos los casos la clasificacion
+ * del comienzo descarta los candidatos cuya primera terna no es valida en ningun formato.
+ *
+ * @param metodos Arreglo de `esquema.totalCandidatos()` posiciones.
+ */
+void PrepararMetodosEsquema(const unsigned char* data, size_t size, const EsquemaCifrado& esquema,
+                            unsigned char* metodos) {
+    int cantidad = 0;
+    if (&esquema == EsquemasCifrado(cantidad)) {
+        PrepararMetodosCandidatos(data, size, metodos);
+        return;
+    }
+
+    int total = esquema.totalCandidatos();
+    if (data == nullptr || size == 0 || size % 3 != 0) {
+        memset(metodos, METODO_NINGUNO, (size_t)total);
+        return;
+    }
+
+    HistogramaTernas histograma;
+    if (!esquema.porPosicion) {
+        ConstruirHistogramaTernas(data, size, histograma);
+    }
+
+    unsigned char identidad[256];
+    for (int b = 0; b < 256; b++) {
+        identidad[b] = (unsigned char)b;
+    }
+
+    for (int i = 0; i < total; i++) {
+        ClaveCifrado cifrado(esquema, i);
+        int restantes = ElegirMetodos(data, size, cifrado, METODOS_TODOS);
+        if (restantes != METODO_NINGUNO && !esquema.porPosicion) {
+            unsigned char tabla[256];
+            cifrado.descifrar(tabla, identidad, 256, 0);
+            restantes = FiltrarMetodosHistograma(histograma, tabla, restantes);
+        }
+        metodos[i] = (unsigned char)restantes;
+    }
+}
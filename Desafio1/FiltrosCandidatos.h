@@ -0,0 +1,136 @@
+#ifndef FILTROSCANDIDATOS_H
+#define FILTROSCANDIDATOS_H
+
+#include <cstddef>
+#include "EsquemasCifrado.h"
+#include "Metricas.h"
+
+/**
+ * @brief Deduce analíticamente los candidatos (clave, bits) compatibles con el formato LZ78.
+ *
+ * La primera terna LZ78 solo puede referenciar la entrada 0, así que sus dos primeros
+ * bytes desencriptados son cero. Como XOR y rotación son biyecciones por byte, esto exige
+ * `data[0] == data[1]` y fija la clave en `data[0]` para cualquier rotación. De las 8
+ * rotaciones se conservan las que dejan el tercer byte en el alfabeto activo.
+ *
+ * @param data Puntero a los datos encriptados.
+ * @param size Tamaño en bytes de los datos.
+ * @param candidatos Arreglo de al menos 8 posiciones donde se escriben los índices `clave * 8 + bits`.
+ * @return Cantidad de candidatos encontrados (0 a 8).
+ */
+int ResolverInvariantesLZ78(const unsigned char* data, size_t size, int* candidatos);
+
+/**
+ * @brief Valores de byte que aparecen en cada posición de las ternas encriptadas.
+ *
+ * El conjunto de valores de cada posición no depende del candidato, así que se arma
+ * en una sola pasada y luego cada (clave, bits) se evalúa pasando solo esos valores
+ * (a lo sumo 256 por posición) por su tabla de descifrado.
+ */
+struct HistogramaTernas {
+    unsigned char valores[3][256];  // Valores distintos de cada posición, en orden creciente
+    int cantidad[3];                // Cuántos valores distintos tiene cada posición
+    size_t numTernas;
+};
+
+/**
+ * @brief Recorre una vez los datos y anota qué valores aparecen en cada posición de terna.
+ *
+ * @param data Puntero a los datos encriptados.
+ * @param size Tamaño en bytes de los datos (se ignoran los bytes de una terna incompleta).
+ * @param histograma Histograma de salida.
+ */
+void ConstruirHistogramaTernas(const unsigned char* data, size_t size, HistogramaTernas& histograma);
+
+/**
+ * @brief Quita de `metodos` los métodos cuya validación byte a byte falla con este candidato.
+ *
+ * Para RLE todo carácter debe quedar en el alfabeto activo y ninguna cuenta en cero. Para LZ78
+ * todo carácter debe estar en el alfabeto y el byte alto de cada referencia no puede superar el
+ * de la última entrada posible. Son las mismas comprobaciones de los descompresores, así
+ * que un candidato descartado aquí nunca habría pasado la descompresión.
+ *
+ * @return La máscara de métodos que aún pueden ser válidos.
+ */
+int FiltrarMetodosHistograma(const HistogramaTernas& histograma, unsigned char clave, int bits, int metodos);
+
+/**
+ * @brief Como la versión con (clave, bits), con la tabla de descifrado de cualquier esquema
+ *        que no dependa de la posición.
+ */
+int FiltrarMetodosHistograma(const HistogramaTernas& histograma, const unsigned char* tabla, int metodos);
+
+/**
+ * @brief Cantidad de ternas del comienzo que examina @ref ClasificarFormato.
+ */
+const int TERNAS_MUESTRA_FORMATO = 64;
+
+/**
+ * @brief Decide si un candidato produce un flujo RLE o LZ78 mirando solo el comienzo de los datos.
+ *
+ * La primera terna separa los formatos: en LZ78 su referencia es 0, es decir, sus dos
+ * primeros bytes son cero, mientras que en RLE el segundo byte es una cuenta y nunca vale
+ * cero. En las ternas de la muestra además se exige que las referencias LZ78 no superen
+ * la cantidad de entradas ya creadas y que las cuentas RLE no sean cero. Como la primera
+ * terna nunca es válida en los dos formatos, la decisión es única.
+ *
+ * @param data Puntero a los datos encriptados.
+ * @param size Tamaño en bytes de los datos.
+ * @param clave Clave XOR del candidato.
+ * @param bits Bits de rotación del candidato.
+ * @param metodos Métodos entre los que se elige.
+ * @return El método de `metodos` compatible con el comienzo de los datos (METODO_RLE o
+ *         METODO_LZ78), o METODO_NINGUNO si ninguno lo es.
+ */
+int ClasificarFormato(const unsigned char* data, size_t size, unsigned char clave, int bits,
+                      int metodos = METODOS_TODOS);
+
+/**
+ * @brief Como la versión con (clave, bits), descifrando la muestra con cualquier esquema.
+ */
+int ClasificarFormato(const unsigned char* data, size_t size, const ClaveCifrado& cifrado,
+                      int metodos = METODOS_TODOS);
+
+/**
+ * @brief Aplica @ref ClasificarFormato si `metodos` tiene más de un método.
+ *
+ * Con un solo método no hay nada que decidir y `metodos` se retorna sin cambios.
+ */
+int ElegirMetodos(const unsigned char* data, size_t size, unsigned char clave, int bits, int metodos);
+
+/**
+ * @brief Como la versión con (clave, bits), para un candidato de cualquier esquema.
+ */
+int ElegirMetodos(const unsigned char* data, size_t size, const ClaveCifrado& cifrado, int metodos);
+
+/**
+ * @brief Prepara la máscara de métodos a probar para cada uno de los @ref TOTAL_CANDIDATOS.
+ *
+ * LZ78 solo se prueba en los candidatos que entrega @ref ResolverInvariantesLZ78, y luego
+ * @ref FiltrarMetodosHistograma descarta, sin volver a leer los datos, los candidatos que
+ * fallarían la validación de algún byte. Así la búsqueda solo descomprime los candidatos
+ * que pasan todas las comprobaciones por byte y su costo deja de crecer con 2040 veces
+ * el tamaño del archivo. Por último @ref ElegirMetodos deja un solo formato por candidato.
+ *
+ * @param data Puntero a los datos encriptados.
+ * @param size Tamaño en bytes de los datos.
+ * @param metodos Arreglo de salida con @ref TOTAL_CANDIDATOS máscaras (METODO_RLE | METODO_LZ78).
+ */
+void PrepararMetodosCandidatos(const unsigned char* data, size_t size, unsigned char* metodos);
+
+/**
+ * @brief Prepara la máscara de métodos de cada candidato de un esquema de cifrado.
+ *
+ * Descarta con la primera terna y la muestra de @ref ClasificarFormato los candidatos que
+ * ningún descompresor aceptaría y, si el esquema no depende de la posición, también los
+ * que falla el histograma (@ref FiltrarMetodosHistograma).
+ *
+ * @param data Puntero a los datos encriptados.
+ * @param size Tamaño en bytes de los datos.
+ * @param esquema Esquema cuyos candidatos se recorren.
+ * @param metodos Arreglo de salida con `esquema.totalCandidatos()` máscaras.
+ */
+void PrepararMetodosEsquema(const unsigned char* data, size_t size, const EsquemaCifrado& esquema,
+                            unsigned char* metodos);
+
+#endif // FILTROSCANDIDATOS_H
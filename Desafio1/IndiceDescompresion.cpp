@@ -0,0 +1,355 @@
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include "Alfabeto.h"
+#include "ArchivoMapeado.h"
+#include "CacheParametros.h"
+#include "CompresionDescompresion.h"
+#include "EscritorResultados.h"
+#include "EsquemasCifrado.h"
+#include "IndiceDescompresion.h"
+#include "Metricas.h"
+using namespace std;
+
+static const char MAGICO_INDICE[8] = { 'D', 'S', 'F', 'I', 'D', 'X', '0', '1' };
+static const size_t TERNAS_BLOQUE = 1365;  // Ternas descifradas por bloque
+
+/*
+ * Formato del archivo (enteros en el orden de bytes de la máquina; si no coincide, el
+ * índice se descarta y se vuelve a construir):
+ *
+ *   magico[8] metodo:u32 intervalo:u32 largoNombre:u32 nombre[largoNombre]
+ *   clave[MAX_LONGITUD_CLAVE] longitudClave:i32 bits:i32
+ *   sizeDatos:u64 huella:u64 total:u64 numPuntos:u64 numEntradas:u64
+ *   puntos[numPuntos] = (terna:u64, salida:u64)
+ *   padres[numEntradas]:u16 caracteres[numEntradas]:u8
+ *   control:u64 (HuellaBytes de todo lo anterior)
+ */
+
+template <typename T>
+static void Agregar(string& buffer, const T& valor) {
+    buffer.append(reinterpret_cast<const char*>(&valor), sizeof(T));
+}
+
+template <typename T>
+static bool Leer(const unsigned char*& p, const unsigned char* fin, T& valor) {
+    if ((size_t)(fin - p) < sizeof(T)) {
+        return false;
+    }
+    memcpy(&valor, p, sizeof(T));
+    p += sizeof(T);
+    return true;
+}
+
+IndiceDescompresion::IndiceDescompresion()
+    : metodoIndice(METODO_NINGUNO), esquema(nullptr), parametros(), sizeDatos(0), huellaDatos(0),
+      totalSalida(0), intervalo(INTERVALO_INDICE) {}
+
+bool IndiceDescompresion::construir(const unsigned char* data, size_t size, const ClaveCifrado& cifrado,
+                                    int metodos, unsigned int intervaloTernas) {
+    metodoIndice = METODO_NINGUNO;
+    esquema = &cifrado.esquema();
+    parametros = cifrado.parametros();
+    sizeDatos = size;
+    intervalo = (intervaloTernas > 0) ? intervaloTernas : INTERVALO_INDICE;
+
+    if (data == nullptr || size == 0 || size % 3 != 0) {
+        return false;
+    }
+
+    // Mismo orden que la búsqueda: RLE y luego LZ78
+    const int metodosOrden[2] = { METODO_RLE, METODO_LZ78 };
+    for (int metodo : metodosOrden) {
+        if ((metodos & metodo) && construirMetodo(data, size, cifrado, metodo)) {
+            metodoIndice = metodo;
+            huellaDatos = HuellaBytes(data, size);
+            return true;
+        }
+    }
+    puntosControl.clear();
+    padres.clear();
+    caracteres.clear();
+    longitudes.clear();
+    totalSalida = 0;
+    return false;
+}
+
+/**
+ * @brief Una pasada de validación con un método, anotando los puntos de control.
+ */
+bool IndiceDescompresion::construirMetodo(const unsigned char* data, size_t size, const ClaveCifrado& cifrado,
+                                          int metodo) {
+    puntosControl.clear();
+    padres.clear();
+    caracteres.clear();
+    longitudes.clear();
+    totalSalida = 0;
+
+    if (metodo == METODO_LZ78) {
+        padres.reserve(MAX_ENTRADAS_LZ78);
+        caracteres.reserve(MAX_ENTRADAS_LZ78);
+        longitudes.reserve(MAX_ENTRADAS_LZ78);
+        padres.push_back(0);
+        caracteres.push_back('\0');
+        longitudes.push_back(0);
+    }
+
+    const Alfabeto& alfabeto = AlfabetoActivo();
+    unsigned char descifrado[3 * TERNAS_BLOQUE];
+    uint64_t numTernas = size / 3;
+    uint64_t entradas = 0;
+
+    for (uint64_t terna = 0; terna < numTernas; terna += TERNAS_BLOQUE) {
+        size_t cantidad = (numTernas - terna < TERNAS_BLOQUE) ? (size_t)(numTernas - terna) : TERNAS_BLOQUE;
+        cifrado.descifrar(descifrado, data + terna * 3, cantidad * 3, terna * 3);
+        if (alfabeto.primeraTernaInvalida(descifrado, cantidad) < cantidad) {
+            return false;
+        }
+
+        for (size_t t = 0; t < cantidad; t++) {
+            if ((terna + t) % intervalo == 0) {
+                puntosControl.push_back({ terna + t, totalSalida });
+            }
+
+            const unsigned char* b = descifrado + 3 * t;
+            if (metodo == METODO_RLE) {
+                if (b[1] == 0) {
+                    return false;
+                }
+                totalSalida += b[1];
+                continue;
+            }
+
+            unsigned int numero = ((unsigned int)b[0] << 8) | b[1];
+            if (numero > entradas) {
+                return false;
+            }
+            entradas++;
+            unsigned int len = longitudes[numero] + 1;
+            if (entradas < MAX_ENTRADAS_LZ78) {
+                padres.push_back((unsigned short)numero);
+                caracteres.push_back(b[2]);
+                longitudes.push_back(len);
+            }
+            totalSalida += len;
+        }
+    }
+    return totalSalida > 0;
+}
+
+/**
+ * @brief Longitud de cada frase del diccionario a partir de sus padres.
+ */
+void IndiceDescompresion::calcularLongitudes() {
+    longitudes.assign(padres.size(), 0);
+    for (size_t e = 1; e < padres.size(); e++) {
+        longitudes[e] = longitudes[padres[e]] + 1;
+    }
+}
+
+bool IndiceDescompresion::guardar(const char* ruta) const {
+    if (metodoIndice == METODO_NINGUNO || esquema == nullptr) {
+        return false;
+    }
+
+    string buffer;
+    buffer.reserve(128 + puntosControl.size() * sizeof(PuntoControl) + padres.size() * 3);
+    buffer.append(MAGICO_INDICE, sizeof(MAGICO_INDICE));
+    Agregar(buffer, (uint32_t)metodoIndice);
+    Agregar(buffer, (uint32_t)intervalo);
+    uint32_t largoNombre = (uint32_t)strlen(esquema->nombre);
+    Agregar(buffer, largoNombre);
+    buffer.append(esquema->nombre, largoNombre);
+    buffer.append(reinterpret_cast<const char*>(parametros.clave), MAX_LONGITUD_CLAVE);
+    Agregar(buffer, (int32_t)parametros.longitudClave);
+    Agregar(buffer, (int32_t)parametros.bits);
+    Agregar(buffer, sizeDatos);
+    Agregar(buffer, huellaDatos);
+    Agregar(buffer, totalSalida);
+    Agregar(buffer, (uint64_t)puntosControl.size());
+    Agregar(buffer, (uint64_t)padres.size());
+    for (const PuntoControl& punto : puntosControl) {
+        Agregar(buffer, punto.terna);
+        Agregar(buffer, punto.salida);
+    }
+    buffer.append(reinterpret_cast<const char*>(padres.data()), padres.size() * sizeof(unsigned short));
+    buffer.append(reinterpret_cast<const char*>(caracteres.data()), caracteres.size());
+    Agregar(buffer, HuellaBytes(reinterpret_cast<const unsigned char*>(buffer.data()), buffer.size()));
+
+    return EscribirArchivoAtomico(ruta, reinterpret_cast<const unsigned char*>(buffer.data()), buffer.size());
+}
+
+bool IndiceDescompresion::cargar(const char* ruta, const unsigned char* data, size_t size,
+                                 const ClaveCifrado& cifrado) {
+    metodoIndice = METODO_NINGUNO;
+    ArchivoMapeado archivo(ruta);
+    if (!archivo.abierto() || archivo.size() < sizeof(MAGICO_INDICE) + sizeof(uint64_t)
+        || memcmp(archivo.datos(), MAGICO_INDICE, sizeof(MAGICO_INDICE)) != 0) {
+        return false;
+    }
+    const unsigned char* p = archivo.datos() + sizeof(MAGICO_INDICE);
+    const unsigned char* fin = archivo.datos() + archivo.size() - sizeof(uint64_t);
+
+    // Un índice dañado daría bytes equivocados sin ningún error: se descarta entero
+    uint64_t control = 0;
+    memcpy(&control, fin, sizeof(control));
+    if (control != HuellaBytes(archivo.datos(), (size_t)(fin - archivo.datos()))) {
+        return false;
+    }
+
+    // Cabecera: debe ser del mismo archivo, esquema y parámetros
+    uint32_t metodo = 0;
+    uint32_t intervaloLeido = 0;
+    uint32_t largoNombre = 0;
+    if (!Leer(p, fin, metodo) || !Leer(p, fin, intervaloLeido) || !Leer(p, fin, largoNombre)
+        || (size_t)(fin - p) < largoNombre) {
+        return false;
+    }
+    const char* nombre = cifrado.esquema().nombre;
+    if ((metodo != METODO_RLE && metodo != METODO_LZ78) || intervaloLeido == 0 || largoNombre != strlen(nombre)
+        || memcmp(p, nombre, largoNombre) != 0) {
+        return false;
+    }
+    p += largoNombre;
+
+    ParametrosCifrado leidos = {};
+    int32_t longitudClave = 0;
+    int32_t bits = 0;
+    if ((size_t)(fin - p) < MAX_LONGITUD_CLAVE) {
+        return false;
+    }
+    memcpy(leidos.clave, p, MAX_LONGITUD_CLAVE);
+    p += MAX_LONGITUD_CLAVE;
+    if (!Leer(p, fin, longitudClave) || !Leer(p, fin, bits)) {
+        return false;
+    }
+    const ParametrosCifrado& esperados = cifrado.parametros();
+    if (longitudClave != esperados.longitudClave || bits != esperados.bits || longitudClave < 1
+        || longitudClave > MAX_LONGITUD_CLAVE || memcmp(leidos.clave, esperados.clave, (size_t)longitudClave) != 0) {
+        return false;
+    }
+
+    uint64_t sizeLeido = 0;
+    uint64_t huella = 0;
+    uint64_t total = 0;
+    uint64_t numPuntos = 0;
+    uint64_t numEntradas = 0;
+    if (!Leer(p, fin, sizeLeido) || !Leer(p, fin, huella) || !Leer(p, fin, total) || !Leer(p, fin, numPuntos)
+        || !Leer(p, fin, numEntradas) || sizeLeido != size || size % 3 != 0) {
+        return false;
+    }
+
+    // El resto del archivo debe tener exactamente los puntos y el diccionario anunciados
+    uint64_t numTernas = size / 3;
+    if (numPuntos == 0 || numPuntos > numTernas || numEntradas > MAX_ENTRADAS_LZ78
+        || (metodo == METODO_RLE) != (numEntradas == 0)
+        || (uint64_t)(fin - p) != numPuntos * 16 + numEntradas * (sizeof(unsigned short) + 1)) {
+        return false;
+    }
+
+    vector<PuntoControl> puntos((size_t)numPuntos);
+    for (PuntoControl& punto : puntos) {
+        Leer(p, fin, punto.terna);
+        Leer(p, fin, punto.salida);
+    }
+    if (puntos[0].terna != 0 || puntos[0].salida != 0) {
+        return false;
+    }
+    for (size_t i = 1; i < puntos.size(); i++) {
+        if (puntos[i].terna <= puntos[i - 1].terna || puntos[i].terna >= numTernas
+            || puntos[i].salida < puntos[i - 1].salida || puntos[i].salida > total) {
+            return false;
+        }
+    }
+
+    vector<unsigned short> padresLeidos((size_t)numEntradas);
+    memcpy(padresLeidos.data(), p, padresLeidos.size() * sizeof(unsigned short));
+    p += padresLeidos.size() * sizeof(unsigned short);
+    for (size_t e = 1; e < padresLeidos.size(); e++) {
+        if (padresLeidos[e] >= e) {
+            return false;
+        }
+    }
+
+    // Lo último, porque recorre todo el archivo encriptado
+    if (huella != HuellaBytes(data, size)) {
+        return false;
+    }
+
+    esquema = &cifrado.esquema();
+    parametros = cifrado.parametros();
+    sizeDatos = sizeLeido;
+    huellaDatos = huella;
+    totalSalida = total;
+    intervalo = intervaloLeido;
+    puntosControl.swap(puntos);
+    padres.swap(padresLeidos);
+    caracteres.assign(p, p + numEntradas);
+    calcularLongitudes();
+    metodoIndice = (int)metodo;
+    return true;
+}
+
+size_t IndiceDescompresion::extraer(const unsigned char* data, uint64_t desde, uint64_t hasta,
+                                    unsigned char* destino) const {
+    if (hasta > totalSalida) {
+        hasta = totalSalida;
+    }
+    if (metodoIndice == METODO_NINGUNO || data == nullptr || desde >= hasta) {
+        return 0;
+    }
+
+    // Último punto de control cuya frase empieza en o antes de `desde`
+    auto despues = upper_bound(puntosControl.begin(), puntosControl.end(), desde,
+                               [](uint64_t posicion, const PuntoControl& punto) { return posicion < punto.salida; });
+    const PuntoControl& punto = *(despues - 1);
+
+    ClaveCifrado cifrado(*esquema, parametros);
+    unsigned char descifrado[3 * TERNAS_BLOQUE];
+    uint64_t numTernas = sizeDatos / 3;
+    uint64_t salida = punto.salida;
+
+    for (uint64_t terna = punto.terna; terna < numTernas && salida < hasta; terna += TERNAS_BLOQUE) {
+        size_t cantidad = (numTernas - terna < TERNAS_BLOQUE) ? (size_t)(numTernas - terna) : TERNAS_BLOQUE;
+        cifrado.descifrar(descifrado, data + terna * 3, cantidad * 3, terna * 3);
+
+        for (size_t t = 0; t < cantidad && salida < hasta; t++) {
+            const unsigned char* b = descifrado + 3 * t;
+            uint64_t len;
+            if (metodoIndice == METODO_RLE) {
+                len = b[1];
+                if (salida + len > desde) {
+                    uint64_t inicio = max(salida, desde);
+                    uint64_t final = min(salida + len, hasta);
+                    memset(destino + (inicio - desde), b[2], (size_t)(final - inicio));
+                }
+            } else {
+                unsigned int numero = ((unsigned int)b[0] << 8) | b[1];
+                if (numero >= padres.size()) {
+                    hasta = salida;  // Solo con datos distintos de los indexados
+                    break;
+                }
+                len = (uint64_t)longitudes[numero] + 1;
+                if (salida + len > desde) {
+                    // La frase se recorre de atrás hacia adelante siguiendo los padres
+                    uint64_t inicio = max(salida, desde);
+                    uint64_t final = min(salida + len, hasta);
+                    unsigned char caracter = b[2];
+                    unsigned int nodo = numero;
+                    for (uint64_t pos = salida + len - 1;; pos--) {
+                        if (pos < final) {
+                            destino[pos - desde] = caracter;
+                        }
+                        if (pos == inicio) {
+                            break;
+                        }
+                        caracter = caracteres[nodo];
+                        nodo = padres[nodo];
+                    }
+                }
+            }
+            salida += len;
+        }
+    }
+    return (salida > desde) ? (size_t)(min(salida, hasta) - desde) : 0;
+}
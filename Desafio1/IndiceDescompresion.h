@@ -0,0 +1,89 @@
+#ifndef INDICEDESCOMPRESION_H
+#define INDICEDESCOMPRESION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "EsquemasCifrado.h"
+#include "Metricas.h"
+
+/** @brief Ternas entre puntos de control de un @ref IndiceDescompresion, por defecto. */
+const unsigned int INTERVALO_INDICE = 4096;
+
+/**
+ * @brief Índice para extraer un rango del texto descomprimido sin descomprimir todo el archivo.
+ *
+ * Cada `intervalo` ternas guarda un punto de control: el número de terna y la posición en
+ * el texto donde empieza su frase. En RLE eso alcanza para retomar. En LZ78 hace falta además
+ * el diccionario, pero como solo crece y las referencias llegan hasta la entrada 65535, el
+ * diccionario de cualquier punto es un prefijo de una única tabla de padres y caracteres
+ * (a lo sumo @ref MAX_ENTRADAS_LZ78 entradas, 3 bytes cada una) que comparten todos.
+ *
+ * Para extraer [desde, hasta) se busca el último punto anterior a `desde` y se descifran
+ * solo las ternas desde ahí; las frases que quedan antes del rango no se escriben.
+ *
+ * El índice se guarda en binario junto al archivo encriptado (`ENCRIPTADO.indice`) con el
+ * esquema, los parámetros y la huella del contenido (@ref HuellaBytes), y se descarta al
+ * cargarlo si el archivo cambió.
+ */
+class IndiceDescompresion {
+public:
+    IndiceDescompresion();
+
+    /**
+     * @brief Recorre el archivo una vez, validándolo, y arma el índice.
+     *
+     * @param metodos Métodos que se prueban, en el orden de la búsqueda (RLE y luego LZ78).
+     * @param intervalo Ternas entre puntos de control.
+     * @return true si los datos son válidos con alguno de los métodos.
+     */
+    bool construir(const unsigned char* data, size_t size, const ClaveCifrado& cifrado,
+                   int metodos = METODOS_TODOS, unsigned int intervalo = INTERVALO_INDICE);
+
+    /** @brief Guarda el índice con @ref EscribirArchivoAtomico. */
+    bool guardar(const char* ruta) const;
+
+    /**
+     * @brief Lee un índice guardado; falla si no corresponde a `data` y `cifrado` o está dañado.
+     */
+    bool cargar(const char* ruta, const unsigned char* data, size_t size, const ClaveCifrado& cifrado);
+
+    /**
+     * @brief Escribe en `destino` los bytes [desde, hasta) del texto descomprimido.
+     *
+     * @param data Los mismos datos encriptados con los que se construyó o cargó el índice.
+     * @param destino Espacio para al menos `hasta - desde` bytes.
+     * @return Bytes escritos (menos si el rango pasa el final del texto).
+     */
+    size_t extraer(const unsigned char* data, uint64_t desde, uint64_t hasta, unsigned char* destino) const;
+
+    /** @brief METODO_RLE, METODO_LZ78 o METODO_NINGUNO si el índice está vacío. */
+    int metodo() const { return metodoIndice; }
+    /** @brief Tamaño total del texto descomprimido. */
+    uint64_t total() const { return totalSalida; }
+    /** @brief Cantidad de puntos de control. */
+    size_t puntos() const { return puntosControl.size(); }
+
+private:
+    struct PuntoControl {
+        uint64_t terna;   // Primera terna desde la que se retoma
+        uint64_t salida;  // Posición en el texto donde empieza su frase
+    };
+
+    bool construirMetodo(const unsigned char* data, size_t size, const ClaveCifrado& cifrado, int metodo);
+    void calcularLongitudes();
+
+    int metodoIndice;
+    const EsquemaCifrado* esquema;
+    ParametrosCifrado parametros;
+    uint64_t sizeDatos;
+    uint64_t huellaDatos;
+    uint64_t totalSalida;
+    unsigned int intervalo;
+    std::vector<PuntoControl> puntosControl;
+    std::vector<unsigned short> padres;     // Diccionario LZ78 referenciable
+    std::vector<unsigned char> caracteres;
+    std::vector<unsigned int> longitudes;   // Se recalcula al cargar; no se guarda
+};
+
+#endif // INDICEDESCOMPRESION_H
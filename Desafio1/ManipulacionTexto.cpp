@@ -1,13 +1,17 @@
+#include <climits>
 #include <iostream>
 #include <fstream>
+#include "Alfabeto.h"
+#include "EscritorResultados.h"
+#include "ManipulacionTexto.h"
 using namespace std;
 
 /**
  * @brief Crea un archivo y escribe un texto dentro de él.
  *
- * Abre (o crea) un archivo en modo binario y escribe en él el contenido
- * de un arreglo de bytes. Si el archivo no puede abrirse o crearse,
- * muestra un mensaje de error y devuelve false.
+ * Escribe el contenido de un arreglo de bytes con @ref EscribirArchivoAtomico: un
+ * archivo existente se reemplaza completo o queda como estaba. Si el archivo no puede
+ * crearse, muestra un mensaje de error y devuelve false.
  *
  * @param rutaArchivo Ruta del archivo a crear o sobrescribir (cadena tipo C).
  * @param texto Puntero al arreglo de bytes a escribir.
@@ -15,16 +19,10 @@ using namespace std;
  * @return true si el archivo se creó y escribió correctamente, false en caso de error.
  */
 bool crearArchivoConTexto(const char* rutaArchivo, unsigned char* texto, int size) {
-    ofstream archivo(rutaArchivo, ios::binary);
-    if (!archivo.is_open()) {
+    if (!EscribirArchivoAtomico(rutaArchivo, texto, (size > 0) ? (size_t)size : 0)) {
         cerr << "No se pudo crear o abrir el archivo." << endl;
         return false;
     }
-
-    // Escribir el texto en el archivo
-    archivo.write(reinterpret_cast<const char*>(texto), size);
-    archivo.close();
-
     return true;
 }
 
@@ -53,7 +51,13 @@ unsigned char* leerArchivoACharArray(const char* rutaArchivo, int& size) {
 
     // Contar caracteres
     archivo.seekg(0, ios::end);
-    size = static_cast<int>(archivo.tellg());
+    streamoff largo = archivo.tellg();
+    if (largo < 0 || largo > INT_MAX) {
+        cerr << "El archivo es demasiado grande para leerlo completo." << endl;
+        size = 0;
+        return nullptr;
+    }
+    size = static_cast<int>(largo);
     archivo.seekg(0, ios::beg);
 
     // Reservar memoria para arreglo (+1 para terminador nulo)
@@ -73,22 +77,26 @@ unsigned char* leerArchivoACharArray(const char* rutaArchivo, int& size) {
  * @brief Muestra el contenido de un arreglo de bytes como texto imprimible.
  *
  * Esta función recorre un arreglo de bytes y muestra en consola
- * los caracteres ASCII que son letras como char y el resto de caracteres como enteros.
+ * los caracteres que acepta el alfabeto activo (@ref AlfabetoActivo) tal cual y el
+ * resto de los bytes como enteros.
  *
  * @param titulo Texto que se mostrará como encabezado antes del contenido (cadena tipo C).
  * @param contenido Puntero al arreglo de bytes a mostrar.
  * @param size Número de bytes en el arreglo.
  */
-void mostrarContenido( unsigned char* contenido, int size) {
-
-
+void mostrarContenido(const unsigned char* contenido, int size) {
+    // Se arma el texto completo y se escribe de una vez, sin una llamada por carácter
+    string texto;
+    texto.reserve((size_t)(size > 0 ? size : 0) * 2 + 2);
+    const Alfabeto& alfabeto = AlfabetoActivo();
     for (int i = 0; i < size; ++i) {
-        if (contenido[i] >= 'a' && contenido[i] <= 'z'
-            ) {
-            cout << contenido[i];  // solo se imprimen caracteres que son letras
+        if (alfabeto.contiene(contenido[i])) {
+            texto += (char)contenido[i];  // se imprimen tal cual los caracteres del alfabeto activo
         } else {
-            cout << (int)contenido[i];  // caracteres diferentes de letras se imprimen como enteros
+            texto += to_string((int)contenido[i]);  // los demás bytes se imprimen como enteros
         }
     }
-    cout << endl << endl;
+    texto += "\n\n";
+    cout.write(texto.data(), (streamsize)texto.size());
+    cout.flush();
 }
@@ -0,0 +1,37 @@
+#ifndef MANIPULACIONTEXTO_H
+#define MANIPULACIONTEXTO_H
+
+/**
+ * @brief Crea un archivo y escribe un texto dentro de él.
+ *
+ * @param rutaArchivo Ruta del archivo.
+ * @param texto Puntero al texto a escribir.
+ * @param size Número de bytes a escribir.
+ * @return true si se creó/escribió correctamente, false en caso contrario.
+ */
+bool crearArchivoConTexto(const char* rutaArchivo, unsigned char* texto, int size);
+
+/**
+ * @brief Lee un archivo y devuelve su contenido como un arreglo dinámico.
+ *
+ * Los archivos de más de INT_MAX bytes no caben en `size`; para esos está @ref ArchivoMapeado.
+ *
+ * @param rutaArchivo Ruta del archivo.
+ * @param size Referencia donde se almacenará el tamaño leído.
+ * @return char* Puntero al contenido del archivo (se debe liberar con delete[]).
+ */
+unsigned char* leerArchivoACharArray(const char* rutaArchivo, int& size);
+
+/**
+ * @brief Muestra el contenido de un arreglo de bytes como texto imprimible.
+ *
+ * Esta función recorre un arreglo de bytes y muestra en consola
+ * los caracteres que acepta el alfabeto activo (@ref AlfabetoActivo) tal cual y el
+ * resto de los bytes como enteros.
+ *
+ * @param contenido Puntero al arreglo de bytes a mostrar.
+ * @param size Número de bytes en el arreglo.
+ */
+void mostrarContenido(const unsigned char* contenido, int size);
+
+#endif // MANIPULACIONTEXTO_H
@@ -0,0 +1,248 @@
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include "EscritorResultados.h"
+#include "Metricas.h"
+using namespace std;
+
+/*
+ * Todos los contadores son atómicos y se actualizan con orden relajado: se registran
+ * una vez por candidato o por etapa, nunca por byte, así que un mismo contador puede
+ * compartirse entre los hilos de búsqueda sin costo apreciable.
+ */
+
+static const int NUM_METODOS = 3;  // Índices METODO_NINGUNO, METODO_RLE y METODO_LZ78
+
+static atomic<bool> metricasActivas(false);
+static atomic<uint64_t> descompresiones[NUM_METODOS];
+static atomic<uint64_t> bytesDescomprimidos[NUM_METODOS];
+static atomic<uint64_t> rechazos[NUM_METODOS][TOTAL_MOTIVOS];
+static atomic<int64_t> nanosegundosEtapa[TOTAL_ETAPAS];
+
+// Volcado pedido por señal: el manejador solo marca; el siguiente registro toma la foto
+// de los contadores y el hilo escritor la guarda
+static atomic<int> volcadoPedido(0);
+static string rutaVolcado;
+static FormatoMetricas formatoVolcado = METRICAS_JSON;
+static mutex cerrojoVolcado;
+
+static const char* const NOMBRES_METODO[NUM_METODOS] = { "ninguno", "rle", "lz78" };
+static const char* const NOMBRES_MOTIVO[TOTAL_MOTIVOS] = {
+    "caracter", "referencia", "repeticion_cero", "tamano", "pista_ausente", "salida"
+};
+static const char* const NOMBRES_ETAPA[TOTAL_ETAPAS] = {
+    "lectura", "verificacion", "construccion", "coincidencia", "escritura"
+};
+
+static int IndiceMetodo(int metodo) {
+    return (metodo == METODO_RLE || metodo == METODO_LZ78) ? metodo : METODO_NINGUNO;
+}
+
+void ActivarMetricas(bool activar) {
+    metricasActivas.store(activar, memory_order_relaxed);
+}
+
+bool MetricasActivas() {
+    return metricasActivas.load(memory_order_relaxed);
+}
+
+/**
+ * @brief Atiende un volcado pedido con SIGUSR1.
+ *
+ * El hilo que registra solo arma el texto; la escritura la hace el hilo de
+ * @ref EscritorCompartido, así el descompresor no espera al disco.
+ */
+static void AtenderVolcado() {
+    if (volcadoPedido.exchange(0, memory_order_relaxed) == 0) {
+        return;
+    }
+    string ruta;
+    FormatoMetricas formato;
+    {
+        lock_guard<mutex> lock(cerrojoVolcado);
+        ruta = rutaVolcado;
+        formato = formatoVolcado;
+    }
+
+    string texto = ExportarMetricas(formato);
+    if (ruta == "-") {
+        EscritorCompartido().mostrar(std::move(texto));
+        return;
+    }
+    unsigned char* datos = new unsigned char[texto.size()];
+    memcpy(datos, texto.data(), texto.size());
+    EscritorCompartido().guardar(ruta, datos, texto.size(), [ruta](bool guardado) {
+        return guardado ? string() : "No se pudieron escribir las metricas en " + ruta + "\n";
+    });
+}
+
+void RegistrarDescompresion(int metodo, uint64_t bytes) {
+    if (!MetricasActivas()) {
+        return;
+    }
+    int i = IndiceMetodo(metodo);
+    descompresiones[i].fetch_add(1, memory_order_relaxed);
+    bytesDescomprimidos[i].fetch_add(bytes, memory_order_relaxed);
+    if (volcadoPedido.load(memory_order_relaxed) != 0) {
+        AtenderVolcado();
+    }
+}
+
+void RegistrarRechazo(int metodo, MotivoRechazo motivo) {
+    if (!MetricasActivas() || motivo < 0 || motivo >= TOTAL_MOTIVOS) {
+        return;
+    }
+    rechazos[IndiceMetodo(metodo)][motivo].fetch_add(1, memory_order_relaxed);
+}
+
+void RegistrarTiempo(EtapaProceso etapa, int64_t nanosegundos) {
+    if (etapa < 0 || etapa >= TOTAL_ETAPAS) {
+        return;
+    }
+    nanosegundosEtapa[etapa].fetch_add(nanosegundos, memory_order_relaxed);
+}
+
+int64_t RelojNanosegundos() {
+    return (int64_t)chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void ReiniciarMetricas() {
+    for (int m = 0; m < NUM_METODOS; m++) {
+        descompresiones[m].store(0, memory_order_relaxed);
+        bytesDescomprimidos[m].store(0, memory_order_relaxed);
+        for (int r = 0; r < TOTAL_MOTIVOS; r++) {
+            rechazos[m][r].store(0, memory_order_relaxed);
+        }
+    }
+    for (int e = 0; e < TOTAL_ETAPAS; e++) {
+        nanosegundosEtapa[e].store(0, memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Un objeto JSON por descompresor, con sus contadores y rechazos por motivo.
+ */
+static void ExportarJSON(ostringstream& salida) {
+    salida << "{\"descompresores\":{";
+    for (int m = METODO_RLE; m < NUM_METODOS; m++) {
+        salida << (m > METODO_RLE ? "," : "") << "\"" << NOMBRES_METODO[m] << "\":{"
+               << "\"descompresiones\":" << descompresiones[m].load(memory_order_relaxed)
+               << ",\"bytes\":" << bytesDescomprimidos[m].load(memory_order_relaxed)
+               << ",\"rechazos\":{";
+        for (int r = 0; r < TOTAL_MOTIVOS; r++) {
+            salida << (r > 0 ? "," : "") << "\"" << NOMBRES_MOTIVO[r] << "\":"
+                   << rechazos[m][r].load(memory_order_relaxed);
+        }
+        salida << "}}";
+    }
+    salida << "},\"etapas_s\":{";
+    for (int e = 0; e < TOTAL_ETAPAS; e++) {
+        salida << (e > 0 ? "," : "") << "\"" << NOMBRES_ETAPA[e] << "\":"
+               << nanosegundosEtapa[e].load(memory_order_relaxed) / 1e9;
+    }
+    salida << "}}\n";
+}
+
+/**
+ * @brief Formato de texto de Prometheus: una serie por descompresor, motivo y etapa.
+ */
+static void ExportarPrometheus(ostringstream& salida) {
+    salida << "# HELP desafio_descompresiones_total Descompresiones intentadas.\n"
+           << "# TYPE desafio_descompresiones_total counter\n";
+    for (int m = METODO_RLE; m < NUM_METODOS; m++) {
+        salida << "desafio_descompresiones_total{metodo=\"" << NOMBRES_METODO[m] << "\"} "
+               << descompresiones[m].load(memory_order_relaxed) << "\n";
+    }
+    salida << "# HELP desafio_bytes_descomprimidos_total Bytes descomprimidos y validados.\n"
+           << "# TYPE desafio_bytes_descomprimidos_total counter\n";
+    for (int m = METODO_RLE; m < NUM_METODOS; m++) {
+        salida << "desafio_bytes_descomprimidos_total{metodo=\"" << NOMBRES_METODO[m] << "\"} "
+               << bytesDescomprimidos[m].load(memory_order_relaxed) << "\n";
+    }
+    salida << "# HELP desafio_rechazos_total Candidatos rechazados por motivo.\n"
+           << "# TYPE desafio_rechazos_total counter\n";
+    for (int m = METODO_RLE; m < NUM_METODOS; m++) {
+        for (int r = 0; r < TOTAL_MOTIVOS; r++) {
+            salida << "desafio_rechazos_total{metodo=\"" << NOMBRES_METODO[m] << "\",motivo=\""
+                   << NOMBRES_MOTIVO[r] << "\"} " << rechazos[m][r].load(memory_order_relaxed) << "\n";
+        }
+    }
+    salida << "# HELP desafio_etapa_segundos_total Tiempo acumulado por etapa, sumado entre hilos.\n"
+           << "# TYPE desafio_etapa_segundos_total counter\n";
+    for (int e = 0; e < TOTAL_ETAPAS; e++) {
+        salida << "desafio_etapa_segundos_total{etapa=\"" << NOMBRES_ETAPA[e] << "\"} "
+               << nanosegundosEtapa[e].load(memory_order_relaxed) / 1e9 << "\n";
+    }
+}
+
+string ExportarMetricas(FormatoMetricas formato) {
+    ostringstream salida;
+    if (formato == METRICAS_PROMETHEUS) {
+        ExportarPrometheus(salida);
+    } else {
+        ExportarJSON(salida);
+    }
+    return salida.str();
+}
+
+bool EscribirMetricas(const char* ruta, FormatoMetricas formato) {
+    string texto = ExportarMetricas(formato);
+    if (ruta == nullptr || ruta[0] == '\0' || strcmp(ruta, "-") == 0) {
+        cout << texto << flush;
+        return true;
+    }
+    // Quien lee el archivo mientras tanto ve las métricas anteriores o las nuevas, nunca una mezcla
+    if (!EscribirArchivoAtomico(ruta, reinterpret_cast<const unsigned char*>(texto.data()), texto.size())) {
+        cout << "No se pudieron escribir las metricas en " << ruta << endl;
+        return false;
+    }
+    return true;
+}
+
+#ifdef SIGUSR1
+static void ManejadorSenalMetricas(int) {
+    volcadoPedido.store(1, memory_order_relaxed);
+}
+#endif
+
+void InstalarSenalMetricas(const char* ruta, FormatoMetricas formato) {
+    {
+        lock_guard<mutex> lock(cerrojoVolcado);
+        rutaVolcado = (ruta != nullptr) ? ruta : "-";
+        formatoVolcado = formato;
+    }
+    ActivarMetricas(true);
+#ifdef SIGUSR1
+    signal(SIGUSR1, ManejadorSenalMetricas);
+#endif
+}
+
+// ---------------------------------------------------------------------------
+// ReporteProgreso
+// ---------------------------------------------------------------------------
+
+ReporteProgreso::ReporteProgreso(uint64_t total, double intervaloSegundos)
+    : total(total), intervalo((int64_t)(intervaloSegundos * 1e9)), inicio(RelojNanosegundos()),
+      siguiente(inicio + intervalo) {}
+
+/**
+ * @brief Imprime el avance solo si pasó el intervalo desde la última línea.
+ *
+ * La comparación con el reloj es lo único que se paga en cada llamada.
+ */
+void ReporteProgreso::avanzar(uint64_t hechos, int clave, int bits) {
+    int64_t ahora = RelojNanosegundos();
+    if (ahora < siguiente) {
+        return;
+    }
+    siguiente = ahora + intervalo;
+
+    double segundos = (ahora - inicio) / 1e9;
+    cout << "Progreso: " << hechos << "/" << total << " (Clave: " << clave << ", Bits: " << bits << ", "
+         << (segundos > 0 ? (uint64_t)(hechos / segundos) : 0) << " candidatos/s)" << endl;
+}
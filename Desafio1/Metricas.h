@@ -0,0 +1,151 @@
+#ifndef METRICAS_H
+#define METRICAS_H
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Métodos de compresión que puede reconocer la búsqueda.
+ */
+enum MetodoCompresion {
+    METODO_NINGUNO = 0,
+    METODO_RLE = 1,
+    METODO_LZ78 = 2
+};
+
+/**
+ * @brief Máscara con todos los métodos de compresión (METODO_RLE | METODO_LZ78).
+ */
+const int METODOS_TODOS = METODO_RLE | METODO_LZ78;
+
+/**
+ * @brief Motivo por el que un descompresor rechazó una entrada o un candidato no sirvió.
+ */
+enum MotivoRechazo {
+    RECHAZO_CARACTER = 0,      // Carácter fuera del alfabeto activo (ver @ref Alfabeto)
+    RECHAZO_REFERENCIA,        // Referencia LZ78 a una entrada que aún no existe
+    RECHAZO_REPETICION_CERO,   // Terna RLE con cero repeticiones
+    RECHAZO_TAMAÑO,            // Tamaño no múltiplo de 3, salida vacía o mayor al límite
+    RECHAZO_PISTA_AUSENTE,     // Descompresión válida, pero sin la pista
+    RECHAZO_SALIDA,            // El sumidero no pudo completar la salida
+    TOTAL_MOTIVOS
+};
+
+/**
+ * @brief Etapas cuyo tiempo se acumula en las métricas.
+ *
+ * En la verificación de candidatos el desencriptado, la validación y la búsqueda
+ * de la pista ocurren en la misma pasada, así que se miden juntos como
+ * ETAPA_VERIFICACION; ETAPA_CONSTRUCCION y ETAPA_COINCIDENCIA corresponden a la
+ * descompresión completa del candidato ganador.
+ */
+enum EtapaProceso {
+    ETAPA_LECTURA = 0,         // Apertura o mapeo de los archivos
+    ETAPA_VERIFICACION,        // Desencriptado y validación de candidatos
+    ETAPA_CONSTRUCCION,        // Descompresión del texto completo
+    ETAPA_COINCIDENCIA,        // Búsqueda de la pista en el texto construido
+    ETAPA_ESCRITURA,           // Escritura del archivo de salida
+    TOTAL_ETAPAS
+};
+
+/**
+ * @brief Formatos en que se exportan las métricas.
+ */
+enum FormatoMetricas {
+    METRICAS_JSON,
+    METRICAS_PROMETHEUS
+};
+
+/**
+ * @brief Activa o desactiva el registro de métricas (desactivado por defecto).
+ *
+ * Desactivadas, cada registro cuesta una comparación y no se lee el reloj.
+ */
+void ActivarMetricas(bool activar);
+
+/** @brief Indica si las métricas se están registrando. */
+bool MetricasActivas();
+
+/** @brief Cuenta una descompresión intentada con `metodo` y los bytes que alcanzó a validar. */
+void RegistrarDescompresion(int metodo, uint64_t bytes);
+
+/** @brief Cuenta un rechazo de `metodo` por `motivo`. */
+void RegistrarRechazo(int metodo, MotivoRechazo motivo);
+
+/** @brief Suma `nanosegundos` al tiempo acumulado de `etapa`. */
+void RegistrarTiempo(EtapaProceso etapa, int64_t nanosegundos);
+
+/** @brief Reloj monótono en nanosegundos. */
+int64_t RelojNanosegundos();
+
+/** @brief Pone en cero todos los contadores. */
+void ReiniciarMetricas();
+
+/**
+ * @brief Texto con todas las métricas en el formato pedido.
+ *
+ * Los tiempos son la suma de lo medido en todos los hilos.
+ */
+std::string ExportarMetricas(FormatoMetricas formato);
+
+/**
+ * @brief Escribe las métricas en `ruta` ("-" o nullptr escribe en la salida estándar).
+ *
+ * El archivo se reemplaza con @ref EscribirArchivoAtomico, así un lector nunca lo ve a medias.
+ *
+ * @return true si se pudieron escribir.
+ */
+bool EscribirMetricas(const char* ruta, FormatoMetricas formato);
+
+/**
+ * @brief Activa las métricas y hace que la señal SIGUSR1 las escriba en `ruta` durante la ejecución.
+ *
+ * El manejador solo marca la petición. El siguiente registro de una descompresión arma el
+ * texto y lo entrega a @ref EscritorCompartido, que lo guarda en su hilo. En sistemas sin
+ * SIGUSR1 solo se activan las métricas.
+ */
+void InstalarSenalMetricas(const char* ruta, FormatoMetricas formato);
+
+/**
+ * @brief Mide el tiempo de una etapa mientras el objeto está vivo.
+ *
+ * Con las métricas desactivadas no lee el reloj.
+ */
+class MedidorEtapa {
+public:
+    explicit MedidorEtapa(EtapaProceso etapa)
+        : etapa(etapa), inicio(MetricasActivas() ? RelojNanosegundos() : -1) {}
+    ~MedidorEtapa() {
+        if (inicio >= 0) {
+            RegistrarTiempo(etapa, RelojNanosegundos() - inicio);
+        }
+    }
+    MedidorEtapa(const MedidorEtapa&) = delete;
+    MedidorEtapa& operator=(const MedidorEtapa&) = delete;
+
+private:
+    EtapaProceso etapa;
+    int64_t inicio;
+};
+
+/**
+ * @brief Informa el avance de un recorrido largo a lo sumo una vez por intervalo.
+ *
+ * Reemplaza a los mensajes cada cierta cantidad de intentos: las búsquedas cortas no
+ * imprimen nada y las largas imprimen una línea por intervalo con el avance y la tasa.
+ */
+class ReporteProgreso {
+public:
+    ReporteProgreso(uint64_t total, double intervaloSegundos = 1.0);
+
+    /** @brief Registra que ya se hicieron `hechos` pasos; imprime si pasó el intervalo. */
+    void avanzar(uint64_t hechos, int clave, int bits);
+
+private:
+    uint64_t total;
+    int64_t intervalo;
+    int64_t inicio;
+    int64_t siguiente;
+};
+
+#endif // METRICAS_H
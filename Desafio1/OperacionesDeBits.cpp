@@ -1,8 +1,186 @@
 #include <iostream>
+#include "OperacionesDeBits.h"
+#include "TablasCifrado.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define DESAFIO_X86_SIMD 1
+#endif
 
 using namespace std;
 
 
+/**
+ * @brief Desencripta un arreglo byte a byte con la tabla del candidato (versión de referencia).
+ *
+ * Cada byte de `origen` se transforma con XOR y rotación a la derecha y se escribe
+ * en `destino`. Es la implementación que se usa cuando el procesador no tiene
+ * instrucciones vectoriales y contra la que se comparan las versiones SIMD.
+ *
+ * @param destino Arreglo donde se escribe el resultado (puede ser igual a `origen`).
+ * @param origen Arreglo de bytes encriptados.
+ * @param tamaño Número de bytes a procesar.
+ * @param clave Clave XOR.
+ * @param bits Bits de rotación a la derecha (0-7).
+ */
+void DescifrarEscalar(unsigned char* destino, const unsigned char* origen, size_t tamaño,
+                      unsigned char clave, int bits) {
+    const unsigned char* tabla = TablaDescifrado(clave, bits);
+    for (size_t i = 0; i < tamaño; ++i) {
+        destino[i] = tabla[origen[i]];
+    }
+}
+
+#ifdef DESAFIO_X86_SIMD
+
+/*
+ * x86 no tiene desplazamientos de bytes, así que la rotación se arma con
+ * desplazamientos de 16 bits y máscaras que descartan los bits que cruzan
+ * al byte vecino: rotr(x, n) = ((x >> n) & (0xFF >> n)) | ((x << (8 - n)) & (0xFF << (8 - n))).
+ * La cola que no llena un registro se procesa con la versión escalar.
+ */
+
+__attribute__((target("sse2")))
+static void DescifrarSSE2(unsigned char* destino, const unsigned char* origen, size_t tamaño,
+                          unsigned char clave, int bits) {
+    bits &= 7;
+    const __m128i vClave = _mm_set1_epi8((char)clave);
+    const __m128i mascaraBaja = _mm_set1_epi8((char)(0xFF >> bits));
+    const __m128i mascaraAlta = _mm_set1_epi8((char)(0xFF << (8 - bits)));
+    const __m128i nDerecha = _mm_cvtsi32_si128(bits);
+    const __m128i nIzquierda = _mm_cvtsi32_si128(8 - bits);
+
+    size_t i = 0;
+    for (; i + 16 <= tamaño; i += 16) {
+        __m128i x = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(origen + i)), vClave);
+        __m128i derecha = _mm_and_si128(_mm_srl_epi16(x, nDerecha), mascaraBaja);
+        __m128i izquierda = _mm_and_si128(_mm_sll_epi16(x, nIzquierda), mascaraAlta);
+        _mm_storeu_si128((__m128i*)(destino + i), _mm_or_si128(derecha, izquierda));
+    }
+    DescifrarEscalar(destino + i, origen + i, tamaño - i, clave, bits);
+}
+
+__attribute__((target("avx2")))
+static void DescifrarAVX2(unsigned char* destino, const unsigned char* origen, size_t tamaño,
+                          unsigned char clave, int bits) {
+    bits &= 7;
+    const __m256i vClave = _mm256_set1_epi8((char)clave);
+    const __m256i mascaraBaja = _mm256_set1_epi8((char)(0xFF >> bits));
+    const __m256i mascaraAlta = _mm256_set1_epi8((char)(0xFF << (8 - bits)));
+    const __m128i nDerecha = _mm_cvtsi32_si128(bits);
+    const __m128i nIzquierda = _mm_cvtsi32_si128(8 - bits);
+
+    size_t i = 0;
+    for (; i + 32 <= tamaño; i += 32) {
+        __m256i x = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(origen + i)), vClave);
+        __m256i derecha = _mm256_and_si256(_mm256_srl_epi16(x, nDerecha), mascaraBaja);
+        __m256i izquierda = _mm256_and_si256(_mm256_sll_epi16(x, nIzquierda), mascaraAlta);
+        _mm256_storeu_si256((__m256i*)(destino + i), _mm256_or_si256(derecha, izquierda));
+    }
+    DescifrarEscalar(destino + i, origen + i, tamaño - i, clave, bits);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static void DescifrarAVX512(unsigned char* destino, const unsigned char* origen, size_t tamaño,
+                            unsigned char clave, int bits) {
+    bits &= 7;
+    const __m512i vClave = _mm512_set1_epi8((char)clave);
+    const __m512i mascaraBaja = _mm512_set1_epi8((char)(0xFF >> bits));
+    const __m512i mascaraAlta = _mm512_set1_epi8((char)(0xFF << (8 - bits)));
+    const __m128i nDerecha = _mm_cvtsi32_si128(bits);
+    const __m128i nIzquierda = _mm_cvtsi32_si128(8 - bits);
+
+    size_t i = 0;
+    for (; i + 64 <= tamaño; i += 64) {
+        __m512i x = _mm512_xor_si512(_mm512_loadu_si512((const void*)(origen + i)), vClave);
+        __m512i derecha = _mm512_and_si512(_mm512_srl_epi16(x, nDerecha), mascaraBaja);
+        __m512i izquierda = _mm512_and_si512(_mm512_sll_epi16(x, nIzquierda), mascaraAlta);
+        _mm512_storeu_si512((void*)(destino + i), _mm512_or_si512(derecha, izquierda));
+    }
+    DescifrarEscalar(destino + i, origen + i, tamaño - i, clave, bits);
+}
+
+#endif // DESAFIO_X86_SIMD
+
+typedef void (*FuncionDescifrar)(unsigned char*, const unsigned char*, size_t, unsigned char, int);
+
+/**
+ * @brief Elige la mejor implementación disponible según las instrucciones del procesador.
+ */
+static FuncionDescifrar ElegirDescifrado(const char*& nombre) {
+#ifdef DESAFIO_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512bw")) {
+        nombre = "AVX-512";
+        return DescifrarAVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        nombre = "AVX2";
+        return DescifrarAVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        nombre = "SSE2";
+        return DescifrarSSE2;
+    }
+#endif
+    nombre = "escalar";
+    return DescifrarEscalar;
+}
+
+static const char* nombreDescifrado = "escalar";
+
+/**
+ * @brief Implementación elegida, detectada una sola vez en el primer uso.
+ */
+static FuncionDescifrar DescifradoActual() {
+    static const FuncionDescifrar funcion = ElegirDescifrado(nombreDescifrado);
+    return funcion;
+}
+
+/**
+ * @brief Desencripta un arreglo (XOR y rotación a la derecha) en una sola pasada.
+ *
+ * Usa la implementación vectorial elegida en el primer uso
+ * (AVX-512, AVX2, SSE2 o escalar).
+ *
+ * @param destino Arreglo donde se escribe el resultado (puede ser igual a `origen`).
+ * @param origen Arreglo de bytes encriptados.
+ * @param tamaño Número de bytes a procesar.
+ * @param clave Clave XOR.
+ * @param bits Bits de rotación a la derecha (0-7).
+ */
+void Descifrar(unsigned char* destino, const unsigned char* origen, size_t tamaño,
+               unsigned char clave, int bits) {
+    DescifradoActual()(destino, origen, tamaño, clave, bits);
+}
+
+/**
+ * @brief Encripta un arreglo (rotación a la izquierda y luego XOR) en una sola pasada.
+ *
+ * Rotar n a la izquierda es rotar 8 - n a la derecha, y un XOR posterior a la rotación
+ * equivale a uno previo con la clave rotada al revés, así que se reutiliza @ref Descifrar.
+ *
+ * @param destino Arreglo donde se escribe el resultado (puede ser igual a `origen`).
+ * @param origen Arreglo de bytes sin encriptar.
+ * @param tamaño Número de bytes a procesar.
+ * @param clave Clave XOR.
+ * @param bits Bits de rotación a la izquierda (0-7).
+ */
+void Cifrar(unsigned char* destino, const unsigned char* origen, size_t tamaño,
+            unsigned char clave, int bits) {
+    int derecha = (8 - (bits & 7)) & 7;
+    unsigned char claveRotada = (unsigned char)((clave << derecha) | (clave >> ((8 - derecha) & 7)));
+    DescifradoActual()(destino, origen, tamaño, claveRotada, derecha);
+}
+
+/**
+ * @brief Nombre de la implementación de @ref Descifrar elegida en este procesador.
+ */
+const char* ImplementacionDescifrado() {
+    DescifradoActual();
+    return nombreDescifrado;
+}
+
 /**
  * @brief Aplica una operación XOR sobre un arreglo de texto.
  *
@@ -15,10 +193,11 @@ using namespace std;
 
 
 void DoXOR(unsigned char* texto, unsigned char clave, int tamaño) {
-
-    for (int i = 0; i < tamaño; ++i) {
-        texto[i] ^= clave;
+    if (tamaño <= 0) {
+        return;
     }
+    // XOR sin rotación
+    Descifrar(texto, texto, tamaño, clave, 0);
 }
 
 
@@ -33,10 +212,10 @@ void DoXOR(unsigned char* texto, unsigned char clave, int tamaño) {
  * @param n Número de posiciones a rotar (0-7).
  */
 void RotarDerecha(int tamaño, unsigned char* texto, int n) {
-    n %= 8; // Asegurar que n esté entre 0 y 7
-    for (int i = 0; i < tamaño; ++i) {
-        texto[i] = (texto[i] >> n) | (texto[i] << (8 - n));
+    if (tamaño <= 0) {
+        return;
     }
+    Descifrar(texto, texto, tamaño, 0, n & 7); // Asegurar que n esté entre 0 y 7
 }
 
 /**
@@ -50,8 +229,9 @@ void RotarDerecha(int tamaño, unsigned char* texto, int n) {
  * @param n Número de posiciones a rotar (0-7).
  */
 void RotarIzquierda(int tamaño, unsigned char* texto, int n) {
-    n %= 8; // Asegurar que n esté entre 0 y 7
-    for (int i = 0; i < tamaño; ++i) {
-        texto[i] = (texto[i] << n) | (texto[i] >> (8 - n));
+    if (tamaño <= 0) {
+        return;
     }
+    // Rotar n a la izquierda equivale a rotar 8 - n a la derecha
+    Descifrar(texto, texto, tamaño, 0, (8 - (n & 7)) & 7);
 }
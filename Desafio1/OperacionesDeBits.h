@@ -0,0 +1,76 @@
+#ifndef OPERACIONESDEBITS_H
+#define OPERACIONESDEBITS_H
+
+#include <cstddef>
+
+/**
+ * @brief Desencripta un arreglo completo (XOR y luego rotación a la derecha) en una sola pasada.
+ *
+ * Usa la implementación vectorial más amplia que soporte el procesador (AVX-512, AVX2
+ * o SSE2, detectada en el primer uso) y recurre a @ref DescifrarEscalar en otro caso.
+ *
+ * @param destino Arreglo donde se escribe el resultado (puede ser el mismo `origen`).
+ * @param origen Arreglo de bytes encriptados.
+ * @param tamaño Número de bytes a procesar.
+ * @param clave Clave XOR.
+ * @param bits Bits de rotación a la derecha (0-7).
+ */
+void Descifrar(unsigned char* destino, const unsigned char* origen, size_t tamaño,
+               unsigned char clave, int bits);
+
+/**
+ * @brief Versión escalar de @ref Descifrar basada en @ref TablaDescifrado.
+ *
+ * Es la implementación de respaldo y la referencia contra la que se validan las versiones SIMD.
+ */
+void DescifrarEscalar(unsigned char* destino, const unsigned char* origen, size_t tamaño,
+                      unsigned char clave, int bits);
+
+/**
+ * @brief Encripta un arreglo completo (rotación a la izquierda y luego XOR), inversa de @ref Descifrar.
+ *
+ * Como `rotl(b, n) ^ k == rotr(b ^ rotl(k, 8 - n), 8 - n)`, se resuelve con las mismas
+ * implementaciones vectoriales de @ref Descifrar.
+ *
+ * @param destino Arreglo donde se escribe el resultado (puede ser el mismo `origen`).
+ * @param origen Arreglo de bytes sin encriptar.
+ * @param tamaño Número de bytes a procesar.
+ * @param clave Clave XOR.
+ * @param bits Bits de rotación a la izquierda (0-7).
+ */
+void Cifrar(unsigned char* destino, const unsigned char* origen, size_t tamaño,
+            unsigned char clave, int bits);
+
+/**
+ * @brief Nombre de la implementación que usa @ref Descifrar en este procesador ("AVX-512", "AVX2", "SSE2" o "escalar").
+ */
+const char* ImplementacionDescifrado();
+
+/**
+ * @brief Aplica XOR con una clave a cada byte del arreglo.
+ *
+ * @param texto Puntero al arreglo de bytes (se modifica en el lugar).
+ * @param clave Byte usado como clave.
+ * @param tamaño Número de bytes en el arreglo.
+ */
+void DoXOR(unsigned char* texto, unsigned char clave, int tamaño);
+
+/**
+ * @brief Rota los bits de cada byte hacia la derecha `n` posiciones (rotación circular).
+ *
+ * @param tamaño Número de bytes en el texto.
+ * @param texto Puntero al arreglo de bytes (se modifica en el lugar).
+ * @param n Número de posiciones a rotar (0-7).
+ */
+void RotarDerecha(int tamaño, unsigned char* texto, int n);
+
+/**
+ * @brief Rota los bits de cada byte hacia la izquierda `n` posiciones (rotación circular).
+ *
+ * @param tamaño Número de bytes en el texto.
+ * @param texto Puntero al arreglo de bytes (se modifica en el lugar).
+ * @param n Número de posiciones a rotar (0-7).
+ */
+void RotarIzquierda(int tamaño, unsigned char* texto, int n);
+
+#endif // OPERACIONESDEBITS_H
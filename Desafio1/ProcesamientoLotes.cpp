@@ -0,0 +1,440 @@
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include "ArchivoMapeado.h"
+#include "BusquedaParametros.h"
+#include "ConjuntoPistas.h"
+#include "ContextoDescompresion.h"
+#include "EscritorResultados.h"
+#include "Metricas.h"
+#include "ProcesamientoLotes.h"
+#include "Sumideros.h"
+using namespace std;
+namespace fs = std::filesystem;
+
+/**
+ * @brief Cola FIFO con capacidad máxima, compartida entre las etapas del pipeline.
+ *
+ * `poner` bloquea mientras la cola está llena, así una etapa rápida no adelanta
+ * más de `capacidad` archivos a la siguiente. `cerrar` avisa que no habrá más
+ * elementos: `sacar` retorna false cuando la cola está cerrada y vacía.
+ */
+template <typename T>
+class ColaAcotada {
+public:
+    explicit ColaAcotada(size_t capacidad) : capacidad(capacidad > 0 ? capacidad : 1), cerrada(false) {}
+
+    void poner(T elemento) {
+        unique_lock<mutex> lock(cerrojo);
+        hayEspacio.wait(lock, [this] { return elementos.size() < capacidad; });
+        elementos.push_back(std::move(elemento));
+        hayElementos.notify_one();
+    }
+
+    bool sacar(T& elemento) {
+        unique_lock<mutex> lock(cerrojo);
+        hayElementos.wait(lock, [this] { return cerrada || !elementos.empty(); });
+        if (elementos.empty()) {
+            return false;
+        }
+        elemento = std::move(elementos.front());
+        elementos.pop_front();
+        hayEspacio.notify_one();
+        return true;
+    }
+
+    void cerrar() {
+        lock_guard<mutex> lock(cerrojo);
+        cerrada = true;
+        hayElementos.notify_all();
+    }
+
+private:
+    mutex cerrojo;
+    condition_variable hayEspacio;
+    condition_variable hayElementos;
+    deque<T> elementos;
+    size_t capacidad;
+    bool cerrada;
+};
+
+/**
+ * @brief Archivo ya abierto por el lector, listo para la búsqueda.
+ */
+struct ArchivoCargado {
+    const TrabajoArchivo* trabajo = nullptr;
+    ArchivoMapeado encriptado;
+    ArchivoMapeado pista;
+    vector<ArchivoMapeado> adicionales;  // Pistas adicionales del manifiesto
+    chrono::steady_clock::time_point inicio;
+};
+
+/**
+ * @brief Resultado de la búsqueda de un archivo, pendiente de escribir e informar.
+ */
+struct ResultadoArchivo {
+    const TrabajoArchivo* trabajo = nullptr;
+    bool leido = false;
+    bool encontrado = false;
+    int clave = 0;
+    int bits = 0;
+    int metodo = METODO_NINGUNO;
+    int intentos = 0;
+    int numPistas = 1;       // Pistas buscadas (incluidas las comunes a todo el lote)
+    int pistasHalladas = 1;  // Pistas que aparecen en el texto del candidato ganador
+    bool desdeCache = false; // Parámetros tomados de la caché y comprobados con una descompresión
+    unsigned char* descomprimido = nullptr; // Liberar con delete[]
+    size_t total = 0;
+    chrono::steady_clock::time_point inicio;
+};
+
+/**
+ * @brief Compara el inicio de `nombre` con `prefijo` sin distinguir mayúsculas.
+ */
+static bool EmpiezaCon(const string& nombre, const char* prefijo) {
+    size_t i = 0;
+    for (; prefijo[i] != '\0'; i++) {
+        if (i >= nombre.size() || tolower((unsigned char)nombre[i]) != tolower((unsigned char)prefijo[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Extrae N de un nombre con la forma `<prefijo>N.txt`.
+ *
+ * @return true si el nombre tiene esa forma y N cabe en un int.
+ */
+static bool NumeroDeArchivo(const string& nombre, const char* prefijo, int& numero) {
+    size_t largoPrefijo = char_traits<char>::length(prefijo);
+    if (!EmpiezaCon(nombre, prefijo) || nombre.size() <= largoPrefijo + 4) {
+        return false;
+    }
+    size_t finNumero = nombre.size() - 4;
+    if (!EmpiezaCon(nombre.substr(finNumero), ".txt")) {
+        return false;
+    }
+
+    long long valor = 0;
+    for (size_t i = largoPrefijo; i < finNumero; i++) {
+        if (!isdigit((unsigned char)nombre[i])) {
+            return false;
+        }
+        valor = valor * 10 + (nombre[i] - '0');
+        if (valor > INT_MAX) {
+            return false;
+        }
+    }
+    numero = (int)valor;
+    return true;
+}
+
+bool DescubrirArchivos(const string& directorio, vector<TrabajoArchivo>& trabajos) {
+    error_code error;
+    fs::directory_iterator it(directorio, error);
+    if (error) {
+        cout << "No se pudo abrir el directorio " << directorio << ": " << error.message() << endl;
+        return false;
+    }
+
+    // Primero las pistas, para emparejar sin depender del orden del directorio
+    vector<pair<int, string>> encriptados;
+    vector<pair<int, string>> pistas;
+    for (const fs::directory_entry& entrada : it) {
+        if (!entrada.is_regular_file(error)) {
+            continue;
+        }
+        string nombre = entrada.path().filename().string();
+        int numero = 0;
+        if (NumeroDeArchivo(nombre, "Encriptado", numero)) {
+            encriptados.emplace_back(numero, entrada.path().string());
+        } else if (NumeroDeArchivo(nombre, "pista", numero)) {
+            pistas.emplace_back(numero, entrada.path().string());
+        }
+    }
+    sort(encriptados.begin(), encriptados.end());
+    sort(pistas.begin(), pistas.end());
+
+    for (const pair<int, string>& encriptado : encriptados) {
+        auto pista = lower_bound(pistas.begin(), pistas.end(), make_pair(encriptado.first, string()));
+        if (pista == pistas.end() || pista->first != encriptado.first) {
+            cout << "Advertencia: " << encriptado.second << " no tiene pista" << encriptado.first
+                 << ".txt; se omite" << endl;
+            continue;
+        }
+
+        TrabajoArchivo trabajo;
+        trabajo.indice = encriptado.first;
+        trabajo.rutaEncriptado = encriptado.second;
+        trabajo.rutaPista = pista->second;
+        trabajo.rutaModificado = (fs::path(directorio) / ("modificado" + to_string(encriptado.first) + ".txt")).string();
+        trabajos.push_back(trabajo);
+    }
+    return true;
+}
+
+bool LeerManifiesto(const string& rutaManifiesto, vector<TrabajoArchivo>& trabajos) {
+    ifstream manifiesto(rutaManifiesto);
+    if (!manifiesto.is_open()) {
+        cout << "No se pudo abrir el manifiesto " << rutaManifiesto << endl;
+        return false;
+    }
+
+    fs::path base = fs::path(rutaManifiesto).parent_path();
+    auto resolver = [&base](const string& ruta) {
+        fs::path camino(ruta);
+        return (camino.is_relative() ? base / camino : camino).string();
+    };
+
+    bool correcto = true;
+    string linea;
+    int numeroLinea = 0;
+    while (getline(manifiesto, linea)) {
+        numeroLinea++;
+        istringstream campos(linea);
+        string encriptado, pista, salida;
+        if (!(campos >> encriptado) || encriptado[0] == '#') {
+            continue;
+        }
+        if (!(campos >> pista)) {
+            cout << "Manifiesto, linea " << numeroLinea << ": falta la pista" << endl;
+            correcto = false;
+            continue;
+        }
+
+        TrabajoArchivo trabajo;
+        trabajo.indice = (int)trabajos.size() + 1;
+        trabajo.rutaEncriptado = resolver(encriptado);
+        // Varias pistas se separan con comas; la primera es la principal
+        istringstream rutasPistas(pista);
+        string rutaPista;
+        while (getline(rutasPistas, rutaPista, ',')) {
+            if (rutaPista.empty()) {
+                continue;
+            }
+            if (trabajo.rutaPista.empty()) {
+                trabajo.rutaPista = resolver(rutaPista);
+            } else {
+                trabajo.pistasAdicionales.push_back(resolver(rutaPista));
+            }
+        }
+        if (campos >> salida) {
+            trabajo.rutaModificado = resolver(salida);
+        } else {
+            trabajo.rutaModificado = (fs::path(trabajo.rutaEncriptado).parent_path()
+                                      / ("modificado" + to_string(trabajo.indice) + ".txt")).string();
+        }
+        trabajos.push_back(trabajo);
+    }
+    return correcto;
+}
+
+/**
+ * @brief Arma el conjunto de pistas de un archivo: las comunes del lote, la suya y las adicionales.
+ *
+ * @return false si alguna pista propia no se pudo leer o el conjunto queda vacío.
+ */
+static bool ArmarConjuntoPistas(const ArchivoCargado& cargado, const ConjuntoPistas* comunes, int requeridas,
+                                ConjuntoPistas& conjunto) {
+    if (comunes != nullptr) {
+        conjunto = *comunes;
+    }
+    conjunto.agregar(cargado.pista.datos(), cargado.pista.size());
+    for (const ArchivoMapeado& adicional : cargado.adicionales) {
+        if (!adicional.abierto()) {
+            return false;
+        }
+        conjunto.agregar(adicional.datos(), adicional.size());
+    }
+    conjunto.preparar(requeridas);
+    return conjunto.size() > 0;
+}
+
+/**
+ * @brief Busca los parámetros de un archivo cargado sin imprimir nada.
+ *
+ * Usa la misma búsqueda que @ref BuscarParametros, así que el candidato elegido es
+ * el mismo, y descomprime una sola vez el candidato ganador para el escritor.
+ * El contexto es el del hilo buscador y se reutiliza de un archivo al siguiente.
+ * Con pistas comunes, pistas adicionales o un criterio distinto de "cualquiera",
+ * la búsqueda usa un @ref ConjuntoPistas. Con la caché de parámetros activa, un archivo
+ * ya resuelto se comprueba con una sola descompresión antes de buscar.
+ */
+static ResultadoArchivo BuscarArchivo(ArchivoCargado& cargado, int hilosPorBusqueda,
+                                      ContextoDescompresion& contexto, const ConjuntoPistas* comunes,
+                                      int requeridas) {
+    ResultadoArchivo resultado;
+    resultado.trabajo = cargado.trabajo;
+    resultado.inicio = cargado.inicio;
+
+    const ArchivoMapeado& enc = cargado.encriptado;
+    const ArchivoMapeado& pista = cargado.pista;
+    if (!enc.abierto() || !pista.abierto() || enc.size() == 0 || pista.size() == 0) {
+        return resultado;
+    }
+
+    // Un solo conjunto o una sola pista; la búsqueda es la misma para los dos
+    ConjuntoPistas conjunto;
+    VarianteBusqueda* variante = nullptr;
+    BusquedaConjunto* busquedaConjunto = nullptr;
+    if (comunes != nullptr || requeridas != 1 || !cargado.adicionales.empty()) {
+        if (!ArmarConjuntoPistas(cargado, comunes, requeridas, conjunto)) {
+            return resultado;
+        }
+        busquedaConjunto = new BusquedaConjunto(conjunto);
+        variante = busquedaConjunto;
+        resultado.numPistas = (int)conjunto.size();
+    } else {
+        variante = new BusquedaPista(pista.datos(), pista.size());
+    }
+    resultado.leido = true;
+
+    SumideroMemoria texto;
+    ResultadoBusqueda busqueda;
+    resultado.encontrado = BuscarGanador(*variante, enc.datos(), enc.size(), hilosPorBusqueda,
+                                         cargado.trabajo->rutaModificado.c_str(), &texto, contexto, false,
+                                         busqueda);
+    resultado.intentos = busqueda.intentos;
+    if (resultado.encontrado) {
+        resultado.clave = busqueda.indice / 8;
+        resultado.bits = busqueda.indice % 8;
+        resultado.metodo = busqueda.metodo;
+        resultado.desdeCache = busqueda.desdeCache;
+        resultado.total = texto.tamaño();
+        resultado.descomprimido = texto.liberar();
+        if (busquedaConjunto != nullptr) {
+            resultado.pistasHalladas = busquedaConjunto->encontradas();
+        }
+    }
+    delete variante;
+    return resultado;
+}
+
+/**
+ * @brief Arma la línea que informa un archivo; la usa el hilo escritor al terminar de guardarlo.
+ */
+static string DescribirResultado(const ResultadoArchivo& resultado, bool guardado) {
+    const TrabajoArchivo& trabajo = *resultado.trabajo;
+    double segundos = chrono::duration<double>(chrono::steady_clock::now() - resultado.inicio).count();
+    ostringstream linea;
+    linea << "[" << trabajo.indice << "] " << trabajo.rutaEncriptado << ": ";
+    if (!resultado.leido) {
+        linea << "error al leer el encriptado o la pista";
+    } else if (!resultado.encontrado) {
+        linea << "sin parametros validos (" << resultado.intentos << " intentos)";
+    } else {
+        linea << (resultado.metodo == METODO_RLE ? "RLE" : "LZ78") << ", clave " << resultado.clave
+              << ", bits " << resultado.bits << ", " << resultado.intentos << " intentos";
+        if (resultado.desdeCache) {
+            linea << " (cache)";
+        }
+        if (resultado.numPistas > 1) {
+            linea << ", pistas " << resultado.pistasHalladas << "/" << resultado.numPistas;
+        }
+        if (guardado) {
+            linea << " -> " << trabajo.rutaModificado;
+        } else {
+            linea << ", error al guardar " << trabajo.rutaModificado;
+        }
+    }
+    linea << " (" << segundos << " s)\n";
+    return linea.str();
+}
+
+/**
+ * @brief Entrega un resultado al escritor sin esperar al disco.
+ *
+ * El texto descomprimido pasa a ser del escritor; la línea del archivo se arma cuando
+ * termina de guardarse, y los archivos sin resultado se informan enseguida.
+ */
+static void EntregarResultado(ResultadoArchivo& resultado, EscritorResultados& escritor, atomic<int>& exitos) {
+    if (!resultado.encontrado) {
+        escritor.mostrar(DescribirResultado(resultado, false));
+        return;
+    }
+    unsigned char* descomprimido = resultado.descomprimido;
+    resultado.descomprimido = nullptr;
+    escritor.guardar(resultado.trabajo->rutaModificado, descomprimido, resultado.total,
+                     [resultado, &exitos](bool guardado) {
+                         if (guardado) {
+                             exitos++;
+                         }
+                         return DescribirResultado(resultado, guardado);
+                     });
+}
+
+int ProcesarLote(const vector<TrabajoArchivo>& trabajos, int numHilos, const ConjuntoPistas* comunes,
+                 int requeridas) {
+    if (trabajos.empty()) {
+        return 0;
+    }
+    if (numHilos <= 0) {
+        numHilos = (int)thread::hardware_concurrency();
+        if (numHilos <= 0) {
+            numHilos = 1;
+        }
+    }
+
+    // Con menos archivos que hilos, cada búsqueda reparte sus candidatos entre los hilos sobrantes;
+    // el resto de la división va a las primeras búsquedas, así se usan todos los hilos
+    int buscadores = (numHilos < (int)trabajos.size()) ? numHilos : (int)trabajos.size();
+    int hilosPorBusqueda = numHilos / buscadores;
+    int conHiloExtra = numHilos % buscadores;
+
+    // La cola acota cuántos archivos hay abiertos; el escritor, cuántos bytes esperan en memoria
+    ColaAcotada<ArchivoCargado> cargados((size_t)buscadores + 1);
+    EscritorResultados escritor;
+    atomic<int> exitos(0);
+
+    thread lector([&trabajos, &cargados] {
+        for (const TrabajoArchivo& trabajo : trabajos) {
+            ArchivoCargado cargado;
+            cargado.trabajo = &trabajo;
+            cargado.inicio = chrono::steady_clock::now();
+            cargado.encriptado.abrir(trabajo.rutaEncriptado.c_str());
+            cargado.pista.abrir(trabajo.rutaPista.c_str());
+            for (const string& ruta : trabajo.pistasAdicionales) {
+                cargado.adicionales.emplace_back(ruta.c_str());
+            }
+            cargados.poner(std::move(cargado));
+        }
+        cargados.cerrar();
+    });
+
+    vector<thread> hilos;
+    for (int i = 0; i < buscadores; i++) {
+        int hilosBusqueda = hilosPorBusqueda + ((i < conHiloExtra) ? 1 : 0);
+        hilos.emplace_back([&cargados, &escritor, &exitos, hilosBusqueda, comunes, requeridas] {
+            ArchivoCargado cargado;
+            ContextoDescompresion contexto;
+            while (cargados.sacar(cargado)) {
+                ResultadoArchivo resultado = BuscarArchivo(cargado, hilosBusqueda, contexto,
+                                                           comunes, requeridas);
+                cargado.encriptado.cerrar();
+                cargado.pista.cerrar();
+                cargado.adicionales.clear();
+                EntregarResultado(resultado, escritor, exitos);
+            }
+        });
+    }
+
+    lector.join();
+    for (thread& h : hilos) {
+        h.join();
+    }
+    escritor.terminar();
+
+    return exitos.load();
+}
@@ -0,0 +1,63 @@
+#ifndef PROCESAMIENTOLOTES_H
+#define PROCESAMIENTOLOTES_H
+
+#include <string>
+#include <vector>
+#include "ConjuntoPistas.h"
+
+/**
+ * @brief Un archivo del lote: rutas de entrada y de salida y su número.
+ */
+struct TrabajoArchivo {
+    int indice;             // N de EncriptadoN.txt (o posición en el manifiesto)
+    std::string rutaEncriptado;
+    std::string rutaPista;
+    std::string rutaModificado;
+    std::vector<std::string> pistasAdicionales;  // Otras pistas del mismo archivo (manifiesto)
+};
+
+/**
+ * @brief Busca en un directorio los pares `EncriptadoN.txt` / `pistaN.txt`, con N de cualquier tamaño.
+ *
+ * Los nombres se comparan sin distinguir mayúsculas. Un encriptado sin su pista se
+ * informa y se omite. La salida de cada par es `modificadoN.txt` en el mismo directorio.
+ *
+ * @param directorio Directorio donde buscar.
+ * @param trabajos Vector de salida, ordenado por N.
+ * @return true si el directorio se pudo recorrer.
+ */
+bool DescubrirArchivos(const std::string& directorio, std::vector<TrabajoArchivo>& trabajos);
+
+/**
+ * @brief Lee un manifiesto de trabajos: una línea `ENCRIPTADO PISTA[,PISTA...] [SALIDA]` por archivo.
+ *
+ * Varias pistas separadas por comas se buscan juntas con un @ref ConjuntoPistas.
+ * Se ignoran las líneas vacías y las que empiezan con '#'. Las rutas relativas se toman
+ * desde el directorio del manifiesto. Sin SALIDA se usa `modificadoK.txt` junto al
+ * encriptado, con K la posición de la línea entre los trabajos.
+ *
+ * @param rutaManifiesto Ruta del manifiesto.
+ * @param trabajos Vector de salida, en el orden del manifiesto.
+ * @return true si el manifiesto se pudo leer sin errores de formato.
+ */
+bool LeerManifiesto(const std::string& rutaManifiesto, std::vector<TrabajoArchivo>& trabajos);
+
+/**
+ * @brief Procesa un lote de archivos con un pipeline acotado.
+ *
+ * Un hilo lector abre (mapea) los archivos siguientes mientras se buscan los actuales,
+ * un grupo de `numHilos` hilos busca los parámetros de varios archivos a la vez y un
+ * @ref EscritorResultados guarda los resultados en segundo plano: los buscadores no
+ * esperan al disco mientras los resultados pendientes quepan en su límite. Cada archivo
+ * se informa en una línea apenas termina de guardarse, en el orden en que se completan.
+ *
+ * @param trabajos Archivos a procesar.
+ * @param numHilos Hilos de búsqueda compartidos por todo el lote (0 = todos los núcleos).
+ * @param comunes Pistas que se agregan a las de cada archivo (opcional, ya cargadas).
+ * @param requeridas Pistas que deben aparecer por archivo: 1, k o @ref PISTAS_TODAS.
+ * @return Cantidad de archivos cuyos parámetros se encontraron y guardaron.
+ */
+int ProcesarLote(const std::vector<TrabajoArchivo>& trabajos, int numHilos,
+                 const ConjuntoPistas* comunes = nullptr, int requeridas = 1);
+
+#endif // PROCESAMIENTOLOTES_H
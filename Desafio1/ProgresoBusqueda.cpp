@@ -0,0 +1,227 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <vector>
+#include "CacheParametros.h"
+#include "EscritorResultados.h"
+#include "ProgresoBusqueda.h"
+using namespace std;
+
+static double intervaloPuntosControl = 0.0;
+static bool reanudarBusquedas = false;
+
+void ConfigurarPuntosControl(double intervaloSegundos, bool reanudar) {
+    intervaloPuntosControl = (intervaloSegundos > 0.0) ? intervaloSegundos : 0.0;
+    reanudarBusquedas = reanudar;
+}
+
+bool PuntosControlActivos() {
+    return intervaloPuntosControl > 0.0;
+}
+
+/**
+ * @brief Estado compartido por los hilos de una búsqueda con puntos de control.
+ */
+struct EstadoProgreso {
+    string ruta;
+    HuellaBusqueda huella;
+    vector<atomic<unsigned char>> marcas;  // 1 = candidato descartado
+    int descartadosPrevios = 0;
+    double segundosPrevios = 0.0;
+    chrono::steady_clock::time_point inicio;
+    int64_t intervalo;                     // Nanosegundos entre guardados
+    atomic<int64_t> proximoGuardado;       // Nanosegundos desde `inicio`
+    mutex cerrojoGuardado;
+    bool terminado = false;
+
+    EstadoProgreso(const char* rutaSalida, const HuellaBusqueda& huella, int total)
+        : ruta(string(rutaSalida) + ".progreso"), huella(huella), marcas((size_t)total),
+          inicio(chrono::steady_clock::now()),
+          intervalo((int64_t)(intervaloPuntosControl * 1e9)), proximoGuardado(intervalo) {
+        for (atomic<unsigned char>& marca : marcas) {
+            marca.store(0, memory_order_relaxed);
+        }
+    }
+
+    int64_t transcurrido() const {
+        return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - inicio).count();
+    }
+};
+
+/**
+ * @brief Lee el avance guardado y marca sus rangos si es de la misma búsqueda.
+ *
+ * @return true si el archivo existía y coincide con la búsqueda.
+ */
+static bool CargarProgreso(EstadoProgreso& estado) {
+    ifstream archivo(estado.ruta);
+    if (!archivo.is_open()) {
+        return false;
+    }
+
+    HuellaBusqueda huella = {};
+    size_t candidatos = 0;
+    bool hayHuella = false;
+    vector<pair<size_t, size_t>> rangos;
+    string linea;
+    while (getline(archivo, linea)) {
+        istringstream campos(linea);
+        string nombre;
+        if (!(campos >> nombre) || nombre[0] == '#') {
+            continue;
+        }
+        if (nombre == "huella") {
+            hayHuella = (bool)(campos >> hex >> huella.datos >> dec >> huella.tamaño >> hex >> huella.pistas);
+        } else if (nombre == "candidatos") {
+            campos >> candidatos;
+        } else if (nombre == "segundos") {
+            campos >> estado.segundosPrevios;
+        } else if (nombre == "rangos") {
+            // Rangos inclusivos "inicio-fin" separados por espacios
+            string rango;
+            while (campos >> rango) {
+                unsigned long long inicio = 0;
+                unsigned long long fin = 0;
+                if (sscanf(rango.c_str(), "%llu-%llu", &inicio, &fin) != 2) {
+                    return false;
+                }
+                rangos.emplace_back((size_t)inicio, (size_t)fin);
+            }
+        }
+    }
+
+    if (!hayHuella || huella.datos != estado.huella.datos || huella.tamaño != estado.huella.tamaño
+        || huella.pistas != estado.huella.pistas || candidatos != estado.marcas.size()) {
+        estado.segundosPrevios = 0.0;
+        return false;
+    }
+
+    for (const pair<size_t, size_t>& rango : rangos) {
+        for (size_t i = rango.first; i <= rango.second && i < estado.marcas.size(); i++) {
+            if (estado.marcas[i].load(memory_order_relaxed) == 0) {
+                estado.marcas[i].store(1, memory_order_relaxed);
+                estado.descartadosPrevios++;
+            }
+        }
+    }
+    return true;
+}
+
+ProgresoBusqueda::ProgresoBusqueda() : estado(nullptr) {}
+
+ProgresoBusqueda::~ProgresoBusqueda() {
+    delete estado;
+}
+
+bool ProgresoBusqueda::iniciar(const char* rutaSalida, const HuellaBusqueda& huella, int totalCandidatos) {
+    delete estado;
+    estado = nullptr;
+    if (!PuntosControlActivos() || rutaSalida == nullptr || totalCandidatos <= 0) {
+        return false;
+    }
+
+    estado = new EstadoProgreso(rutaSalida, huella, totalCandidatos);
+    if (reanudarBusquedas && CargarProgreso(*estado)) {
+        cout << "Reanudando desde " << estado->ruta << ": " << estado->descartadosPrevios << " de "
+             << totalCandidatos << " candidatos ya descartados (" << estado->segundosPrevios << " s)" << endl;
+    }
+    return true;
+}
+
+bool ProgresoBusqueda::agotado(int indice) const {
+    return estado != nullptr && estado->marcas[(size_t)indice].load(memory_order_relaxed) != 0;
+}
+
+void ProgresoBusqueda::marcar(int indice) {
+    if (estado == nullptr) {
+        return;
+    }
+    estado->marcas[(size_t)indice].store(1, memory_order_relaxed);
+
+    // Un solo hilo arma la foto del avance; los demás siguen sin esperar
+    int64_t ahora = estado->transcurrido();
+    if (ahora >= estado->proximoGuardado.load(memory_order_relaxed)) {
+        unique_lock<mutex> lock(estado->cerrojoGuardado, try_to_lock);
+        if (lock.owns_lock() && ahora >= estado->proximoGuardado.load(memory_order_relaxed)) {
+            estado->proximoGuardado.store(ahora + estado->intervalo, memory_order_relaxed);
+            lock.unlock();
+            guardar();
+        }
+    }
+}
+
+int ProgresoBusqueda::descartadosPrevios() const {
+    return (estado != nullptr) ? estado->descartadosPrevios : 0;
+}
+
+double ProgresoBusqueda::segundosPrevios() const {
+    return (estado != nullptr) ? estado->segundosPrevios : 0.0;
+}
+
+/**
+ * @brief Copia el avance bajo el cerrojo y lo encola en @ref EscritorCompartido.
+ *
+ * El temporal, el fsync y el rename los hace el hilo escritor, así el hilo de búsqueda
+ * que pasó el intervalo solo paga la copia. El cerrojo ordena los guardados con
+ * @ref terminar: el borrado va a la misma cola, detrás del último guardado.
+ */
+bool ProgresoBusqueda::guardar() {
+    if (estado == nullptr) {
+        return false;
+    }
+    lock_guard<mutex> lock(estado->cerrojoGuardado);
+    if (estado->terminado) {
+        return false;
+    }
+
+    // Los hilos de trabajo se apropian de rangos contiguos, así que quedan pocos rangos
+    ostringstream rangos;
+    size_t descartados = 0;
+    size_t total = estado->marcas.size();
+    for (size_t i = 0; i < total;) {
+        if (estado->marcas[i].load(memory_order_relaxed) == 0) {
+            i++;
+            continue;
+        }
+        size_t inicio = i;
+        while (i < total && estado->marcas[i].load(memory_order_relaxed) != 0) {
+            i++;
+        }
+        rangos << " " << inicio << "-" << (i - 1);
+        descartados += i - inicio;
+    }
+
+    char huella[64];
+    snprintf(huella, sizeof(huella), "%016llx %llu %016llx", (unsigned long long)estado->huella.datos,
+             (unsigned long long)estado->huella.tamaño, (unsigned long long)estado->huella.pistas);
+    ostringstream texto;
+    texto << "# Avance de busqueda; se borra al terminar\n"
+          << "huella " << huella << "\n"
+          << "candidatos " << total << "\n"
+          << "descartados " << descartados << "\n"
+          << "segundos " << estado->segundosPrevios + estado->transcurrido() / 1e9 << "\n"
+          << "rangos" << rangos.str() << "\n";
+    string contenido = texto.str();
+
+    unsigned char* datos = new unsigned char[contenido.size()];
+    memcpy(datos, contenido.data(), contenido.size());
+    string ruta = estado->ruta;
+    EscritorCompartido().guardar(ruta, datos, contenido.size(), [ruta](bool guardado) {
+        return guardado ? string() : "No se pudo guardar el avance en " + ruta + "\n";
+    });
+    return true;
+}
+
+void ProgresoBusqueda::terminar() {
+    if (estado == nullptr) {
+        return;
+    }
+    lock_guard<mutex> lock(estado->cerrojoGuardado);
+    estado->terminado = true;
+    EscritorCompartido().borrar(estado->ruta);
+}
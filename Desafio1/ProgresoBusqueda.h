@@ -0,0 +1,73 @@
+#ifndef PROGRESOBUSQUEDA_H
+#define PROGRESOBUSQUEDA_H
+
+#include "CacheParametros.h"
+
+struct EstadoProgreso;
+
+/**
+ * @brief Avance de una búsqueda larga, guardado cada cierto tiempo para poder reanudarla.
+ *
+ * Cada candidato descartado (todos los métodos de su máscara probados sin encontrar la
+ * pista) se marca en un arreglo compartido por los hilos. Cada tanto un hilo copia los
+ * rangos de candidatos descartados, los intentos y el tiempo acumulados, con la huella de
+ * la búsqueda (@ref HuellaBusqueda), y @ref EscritorCompartido los guarda en su hilo en un
+ * archivo chico junto a la salida. Al
+ * reanudar, los candidatos descartados se saltean: como el ganador es el menor índice
+ * que contiene la pista, el resultado es el mismo que sin interrupción. El ganador y los
+ * candidatos que estaban a medio evaluar no se marcan, así que se vuelven a evaluar.
+ *
+ * Sin @ref ConfigurarPuntosControl el objeto queda inactivo y no cuesta nada.
+ */
+class ProgresoBusqueda {
+public:
+    ProgresoBusqueda();
+    ~ProgresoBusqueda();
+
+    ProgresoBusqueda(const ProgresoBusqueda&) = delete;
+    ProgresoBusqueda& operator=(const ProgresoBusqueda&) = delete;
+
+    /**
+     * @brief Activa el progreso de una búsqueda si los puntos de control están configurados.
+     *
+     * Con `--reanudar` carga el avance guardado en `rutaSalida` + ".progreso" si es de
+     * la misma búsqueda; si no, empieza de cero y lo sobrescribe en el primer guardado.
+     *
+     * @return true si el progreso quedó activo.
+     */
+    bool iniciar(const char* rutaSalida, const HuellaBusqueda& huella, int totalCandidatos);
+
+    bool activo() const { return estado != nullptr; }
+
+    /** @brief Indica si el candidato ya se descartó (en esta corrida o en una anterior). */
+    bool agotado(int indice) const;
+
+    /** @brief Marca un candidato descartado y guarda el avance si pasó el intervalo. */
+    void marcar(int indice);
+
+    /** @brief Candidatos descartados y segundos de búsqueda de las corridas anteriores. */
+    int descartadosPrevios() const;
+    double segundosPrevios() const;
+
+    /** @brief Encola el avance actual para que lo escriba el hilo escritor. */
+    bool guardar();
+
+    /** @brief La búsqueda terminó (con o sin ganador): encola el borrado del archivo de avance. */
+    void terminar();
+
+private:
+    EstadoProgreso* estado;
+};
+
+/**
+ * @brief Configura los puntos de control de todas las búsquedas siguientes.
+ *
+ * @param intervaloSegundos Segundos entre guardados (0 = sin puntos de control).
+ * @param reanudar true para continuar desde el avance guardado de cada búsqueda.
+ */
+void ConfigurarPuntosControl(double intervaloSegundos, bool reanudar);
+
+/** @brief Indica si las búsquedas guardan su avance. */
+bool PuntosControlActivos();
+
+#endif // PROGRESOBUSQUEDA_H
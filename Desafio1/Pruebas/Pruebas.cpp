@@ -0,0 +1,512 @@
+/**
+ * @file Pruebas.cpp
+ * @brief Pruebas de ida y vuelta de los módulos del desafío.
+ *
+ * Cada prueba genera sus datos al azar con una semilla fija (o la de `--semilla N`), así
+ * que una falla se repite corriendo de nuevo con la semilla que se muestra al empezar.
+ * El programa retorna 0 si todas las comprobaciones pasan y 1 si alguna falla.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "BuscadorPista.h"
+#include "CompresionDescompresion.h"
+#include "ConjuntoPistas.h"
+#include "EsquemasCifrado.h"
+#include "OperacionesDeBits.h"
+#include "Sumideros.h"
+using namespace std;
+
+static const unsigned int SEMILLA_PREDETERMINADA = 20240917;
+
+static int comprobaciones = 0;
+static int fallas = 0;
+
+/**
+ * @brief Cuenta una comprobación y, si falla, muestra qué se esperaba.
+ */
+static void Comprobar(bool condicion, const string& descripcion) {
+    comprobaciones++;
+    if (!condicion) {
+        fallas++;
+        if (fallas <= 50) {
+            cout << "  FALLA: " << descripcion << endl;
+        }
+    }
+}
+
+static bool Iguales(const unsigned char* datos, size_t tamaño, const vector<unsigned char>& esperado) {
+    return tamaño == esperado.size() && (tamaño == 0 || memcmp(datos, esperado.data(), tamaño) == 0);
+}
+
+/**
+ * @brief Texto de letras del alfabeto dado, en corridas de 1 a `corridaMaxima` caracteres.
+ */
+static vector<unsigned char> TextoAlAzar(mt19937& azar, size_t largo, const string& alfabeto,
+                                         size_t corridaMaxima) {
+    uniform_int_distribution<size_t> letra(0, alfabeto.size() - 1);
+    uniform_int_distribution<size_t> corrida(1, corridaMaxima);
+    vector<unsigned char> texto;
+    texto.reserve(largo);
+    while (texto.size() < largo) {
+        unsigned char c = (unsigned char)alfabeto[letra(azar)];
+        size_t n = min(corrida(azar), largo - texto.size());
+        texto.insert(texto.end(), n, c);
+    }
+    return texto;
+}
+
+static vector<unsigned char> BytesAlAzar(mt19937& azar, size_t largo) {
+    uniform_int_distribution<int> byte(0, 255);
+    vector<unsigned char> datos(largo);
+    for (size_t i = 0; i < largo; i++) {
+        datos[i] = (unsigned char)byte(azar);
+    }
+    return datos;
+}
+
+/** @brief Candidatos a probar de un esquema: el primero, el último y algunos al azar. */
+static vector<int> IndicesAlAzar(mt19937& azar, const EsquemaCifrado& esquema, int cantidad) {
+    int total = esquema.totalCandidatos();
+    vector<int> indices = { 0, total - 1 };
+    uniform_int_distribution<int> indice(0, total - 1);
+    for (int i = 0; i < cantidad; i++) {
+        indices.push_back(indice(azar));
+    }
+    return indices;
+}
+
+static string Nombre(const ClaveCifrado& clave, int indice) {
+    return string(clave.esquema().nombre) + " #" + to_string(indice);
+}
+
+// ---------------------------------------------------------------------------
+// Cifrado
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Cifrar y luego descifrar devuelve los bytes originales, en cualquier esquema.
+ *
+ * También comprueba que cifrar por partes (cada una con su posición en el archivo) da lo
+ * mismo que de una vez, que es lo que hacen los compresores y la descompresión por bloques.
+ */
+static void PruebaEsquemasCifrado(mt19937& azar) {
+    int cantidad = 0;
+    const EsquemaCifrado* esquemas = EsquemasCifrado(cantidad);
+    uniform_int_distribution<uint64_t> posicionAlAzar(0, 1 << 20);
+    for (int e = 0; e < cantidad; e++) {
+        const EsquemaCifrado& esquema = esquemas[e];
+        for (int indice : IndicesAlAzar(azar, esquema, 6)) {
+            ClaveCifrado clave(esquema, indice);
+            Comprobar(esquema.indice(esquema.parametros(indice)) == indice,
+                      Nombre(clave, indice) + ": índice de sus parámetros");
+
+            size_t largo = uniform_int_distribution<size_t>(1, 5000)(azar);
+            vector<unsigned char> original = BytesAlAzar(azar, largo);
+            vector<unsigned char> cifrado(largo), descifrado(largo), porPartes(largo);
+            uint64_t posicion = posicionAlAzar(azar);
+
+            clave.cifrar(cifrado.data(), original.data(), largo, posicion);
+            clave.descifrar(descifrado.data(), cifrado.data(), largo, posicion);
+            Comprobar(descifrado == original, Nombre(clave, indice) + ": cifrar y descifrar");
+
+            size_t hecho = 0;
+            while (hecho < largo) {
+                size_t parte = min(uniform_int_distribution<size_t>(1, 97)(azar), largo - hecho);
+                clave.cifrar(porPartes.data() + hecho, original.data() + hecho, parte, posicion + hecho);
+                hecho += parte;
+            }
+            Comprobar(porPartes == cifrado, Nombre(clave, indice) + ": cifrar por partes");
+        }
+    }
+
+    // Las versiones vectoriales del esquema original contra la escalar, desde un origen desalineado
+    vector<unsigned char> datos = BytesAlAzar(azar, 1031);
+    vector<unsigned char> simd(datos.size()), escalar(datos.size()), ida(datos.size());
+    for (int clave = 0; clave < 256; clave++) {
+        for (int bits = 0; bits < 8; bits++) {
+            size_t n = datos.size() - 1;
+            Descifrar(simd.data(), datos.data() + 1, n, (unsigned char)clave, bits);
+            DescifrarEscalar(escalar.data(), datos.data() + 1, n, (unsigned char)clave, bits);
+            Comprobar(memcmp(simd.data(), escalar.data(), n) == 0,
+                      "Descifrar contra DescifrarEscalar, clave " + to_string(clave) + " bits " + to_string(bits));
+            Cifrar(ida.data(), datos.data() + 1, n, (unsigned char)clave, bits);
+            Descifrar(simd.data(), ida.data(), n, (unsigned char)clave, bits);
+            Comprobar(memcmp(simd.data(), datos.data() + 1, n) == 0,
+                      "Cifrar y Descifrar, clave " + to_string(clave) + " bits " + to_string(bits));
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Compresión
+// ---------------------------------------------------------------------------
+
+/** @brief Comprime `texto` entregándolo en bloques de largo al azar. */
+template <typename Compresor>
+static bool Comprimir(mt19937& azar, const ClaveCifrado& clave, const vector<unsigned char>& texto,
+                      SumideroMemoria& salida) {
+    Compresor compresor(clave, salida);
+    size_t hecho = 0;
+    while (hecho < texto.size()) {
+        size_t parte = min(uniform_int_distribution<size_t>(1, 4096)(azar), texto.size() - hecho);
+        if (!compresor.procesar(texto.data() + hecho, parte)) {
+            return false;
+        }
+        hecho += parte;
+    }
+    return compresor.finalizar() && compresor.total() == salida.tamaño();
+}
+
+/**
+ * @brief El descompresor RLE en una pasada entrega lo mismo a cada tipo de sumidero.
+ *
+ * El descompresor finaliza el sumidero al terminar, así que el archivo ya queda en su lugar.
+ */
+static void ComprobarSumiderosRLE(const ClaveCifrado& clave, const string& nombre,
+                                  const SumideroMemoria& comprimido, const vector<unsigned char>& texto,
+                                  const string& rutaTemporal) {
+    size_t total = 0;
+    vector<unsigned char> recibido;
+    size_t bloquesMayores = 0;
+    SumideroBloques bloques(61, [&](const unsigned char* bytes, size_t cantidad) {
+        if (cantidad > 61) {
+            bloquesMayores++;
+        }
+        recibido.insert(recibido.end(), bytes, bytes + cantidad);
+        return true;
+    });
+    bool valido = descompresionRLEFlujo(comprimido.datos(), comprimido.tamaño(), clave, bloques, total);
+    Comprobar(valido && recibido == texto && bloquesMayores == 0, nombre + ": RLE a SumideroBloques");
+
+    recibido.clear();
+    SumideroFuncion funcion([&](const unsigned char* bytes, size_t cantidad) {
+        recibido.insert(recibido.end(), bytes, bytes + cantidad);
+        return true;
+    });
+    valido = descompresionRLEFlujo(comprimido.datos(), comprimido.tamaño(), clave, funcion, total);
+    Comprobar(valido && recibido == texto, nombre + ": RLE a SumideroFuncion");
+
+    {
+        SumideroArchivo archivo(rutaTemporal.c_str());
+        valido = archivo.abierto()
+                 && descompresionRLEFlujo(comprimido.datos(), comprimido.tamaño(), clave, archivo, total);
+    }
+    ifstream leido(rutaTemporal, ios::binary);
+    vector<unsigned char> contenido((istreambuf_iterator<char>(leido)), istreambuf_iterator<char>());
+    Comprobar(valido && contenido == texto, nombre + ": RLE a SumideroArchivo");
+    leido.close();
+    remove(rutaTemporal.c_str());
+}
+
+/**
+ * @brief Comprimir y descomprimir devuelve el texto original, con cada esquema y cada formato.
+ *
+ * Los textos incluyen corridas de más de 255 caracteres, que el RLE parte en varias ternas.
+ * Con el esquema original también se comparan las funciones originales (`descompresionRLE`
+ * y `descompresionLZ78`), y al final se comprueba que una entrada dañada se rechaza.
+ */
+static void PruebaCompresion(mt19937& azar, const string& rutaTemporal) {
+    int cantidad = 0;
+    const EsquemaCifrado* esquemas = EsquemasCifrado(cantidad);
+    const size_t largos[] = { 1, 2, 255, 256, 1000, 70000 };
+    for (int e = 0; e < cantidad; e++) {
+        for (int indice : IndicesAlAzar(azar, esquemas[e], 2)) {
+            ClaveCifrado clave(esquemas[e], indice);
+            string nombre = Nombre(clave, indice);
+            for (size_t largo : largos) {
+                size_t corrida = uniform_int_distribution<size_t>(1, 600)(azar);
+                vector<unsigned char> texto = TextoAlAzar(azar, largo, "abcdefghijklmnopqrstuvwxyz", corrida);
+                string caso = nombre + ", " + to_string(largo) + " bytes";
+
+                SumideroMemoria rle, lz78;
+                Comprobar(Comprimir<CompresorRLE>(azar, clave, texto, rle), caso + ": comprimir RLE");
+                Comprobar(Comprimir<CompresorLZ78>(azar, clave, texto, lz78), caso + ": comprimir LZ78");
+
+                SumideroMemoria salida;
+                size_t total = 0;
+                bool valido = descompresionRLEFlujo(rle.datos(), rle.tamaño(), clave, salida, total);
+                Comprobar(valido && total == largo && Iguales(salida.datos(), salida.tamaño(), texto),
+                          caso + ": ida y vuelta RLE");
+                ComprobarSumiderosRLE(clave, caso, rle, texto, rutaTemporal);
+
+                salida.descartar();
+                valido = descompresionLZ78Flujo(lz78.datos(), lz78.tamaño(), clave, salida, total);
+                Comprobar(valido && total == largo && Iguales(salida.datos(), salida.tamaño(), texto),
+                          caso + ": ida y vuelta LZ78");
+
+                salida.descartar();
+                istringstream flujo(string((const char*)lz78.datos(), lz78.tamaño()));
+                uint64_t totalFlujo = 0;
+                valido = descompresionLZ78Flujo(flujo, clave, salida, totalFlujo, 1000);
+                Comprobar(valido && totalFlujo == largo && Iguales(salida.datos(), salida.tamaño(), texto),
+                          caso + ": ida y vuelta LZ78 desde un flujo");
+
+                if (clave.original()) {
+                    unsigned char claveXOR = clave.parametros().clave[0];
+                    int bits = clave.parametros().bits;
+                    int totalOriginal = 0;
+                    bool validoOriginal = false;
+                    unsigned char* original = descompresionRLE(const_cast<unsigned char*>(rle.datos()),
+                                                               (int)rle.tamaño(), claveXOR, bits,
+                                                               totalOriginal, validoOriginal);
+                    Comprobar(validoOriginal && original != nullptr
+                                  && Iguales(original, (size_t)totalOriginal, texto),
+                              caso + ": descompresionRLE original");
+                    delete[] original;
+
+                    original = descompresionLZ78(const_cast<unsigned char*>(lz78.datos()), (int)lz78.tamaño(),
+                                                 claveXOR, bits, totalOriginal, validoOriginal);
+                    Comprobar(validoOriginal && original != nullptr
+                                  && Iguales(original, (size_t)totalOriginal, texto),
+                              caso + ": descompresionLZ78 original");
+                    delete[] original;
+                }
+            }
+
+            // Una terna con un carácter fuera del alfabeto, y una entrada cortada a media terna
+            vector<unsigned char> texto = TextoAlAzar(azar, 3000, "abc", 20);
+            SumideroMemoria rle;
+            Comprimir<CompresorRLE>(azar, clave, texto, rle);
+            vector<unsigned char> dañado(rle.datos(), rle.datos() + rle.tamaño());
+            size_t terna = uniform_int_distribution<size_t>(0, dañado.size() / 3 - 1)(azar);
+            unsigned char fuera = '#';
+            clave.cifrar(&dañado[3 * terna + 2], &fuera, 1, 3 * terna + 2);
+            SumideroMemoria salida;
+            size_t total = 0;
+            Comprobar(!descompresionRLEFlujo(dañado.data(), dañado.size(), clave, salida, total),
+                      nombre + ": RLE rechaza un carácter fuera del alfabeto");
+            Comprobar(!descompresionRLEFlujo(rle.datos(), rle.tamaño() - 1, clave, salida, total),
+                      nombre + ": RLE rechaza una terna incompleta");
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Búsqueda de pistas
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Alimenta un @ref SumideroCoincidencia con el texto por corridas o por bloques al azar.
+ */
+static void Alimentar(mt19937& azar, SumideroCoincidencia& sumidero, const string& texto) {
+    const unsigned char* bytes = (const unsigned char*)texto.data();
+    size_t i = 0;
+    while (i < texto.size()) {
+        bool seguir;
+        if (azar() % 2 == 0) {
+            size_t fin = i + 1;
+            while (fin < texto.size() && texto[fin] == texto[i]) {
+                fin++;
+            }
+            seguir = sumidero.escribirRepeticion(bytes[i], fin - i);
+            i = fin;
+        } else {
+            size_t parte = min(uniform_int_distribution<size_t>(1, 50)(azar), texto.size() - i);
+            seguir = sumidero.escribir(bytes + i, parte);
+            i += parte;
+        }
+        if (!seguir) {
+            return;
+        }
+    }
+}
+
+/** @brief Pista para buscar: un trozo del texto, una tira al azar o una tira periódica. */
+static string PistaAlAzar(mt19937& azar, const string& texto, const string& alfabeto) {
+    size_t largo = uniform_int_distribution<size_t>(1, 40)(azar);
+    int tipo = (int)(azar() % 3);
+    if (tipo == 0 && texto.size() >= largo) {
+        size_t inicio = uniform_int_distribution<size_t>(0, texto.size() - largo)(azar);
+        return texto.substr(inicio, largo);
+    }
+    vector<unsigned char> azarosa = TextoAlAzar(azar, largo, alfabeto, tipo == 1 ? 1 : 3);
+    string pista(azarosa.begin(), azarosa.end());
+    if (tipo == 2) {
+        size_t periodo = uniform_int_distribution<size_t>(1, 3)(azar);
+        for (size_t i = periodo; i < pista.size(); i++) {
+            pista[i] = pista[i - periodo];
+        }
+    }
+    return pista;
+}
+
+/**
+ * @brief @ref BuscadorPista, @ref SumideroCoincidencia y @ref ConjuntoPistas encuentran lo
+ *        mismo que `std::string::find`.
+ *
+ * Los alfabetos chicos hacen frecuentes las coincidencias parciales y los largos cruzan
+ * el límite de 32 bytes del filtro de dos vías.
+ */
+static void PruebaBuscadores(mt19937& azar) {
+    const string alfabetos[] = { "ab", "abc", "abcdefghijklmnopqrstuvwxyz" };
+    for (const string& alfabeto : alfabetos) {
+        for (int vuelta = 0; vuelta < 300; vuelta++) {
+            size_t largo = uniform_int_distribution<size_t>(0, 3000)(azar);
+            vector<unsigned char> bytes = TextoAlAzar(azar, largo, alfabeto, 1 + vuelta % 5);
+            string texto(bytes.begin(), bytes.end());
+            const unsigned char* datos = bytes.data();
+            string caso = "alfabeto " + alfabeto + ", vuelta " + to_string(vuelta);
+
+            string pista = PistaAlAzar(azar, texto, alfabeto);
+            size_t esperado = texto.find(pista);
+            BuscadorPista buscador((const unsigned char*)pista.data(), pista.size());
+            size_t hallado = buscador.buscar(datos, texto.size());
+            Comprobar(esperado == string::npos ? hallado == BuscadorPista::NO_ENCONTRADO : hallado == esperado,
+                      caso + ": buscar \"" + pista + "\"");
+            Comprobar(buscador.contenidaEn(datos, texto.size()) == (esperado != string::npos),
+                      caso + ": contenidaEn \"" + pista + "\"");
+
+            SumideroCoincidencia sumidero(buscador.automata());
+            Alimentar(azar, sumidero, texto);
+            Comprobar(sumidero.encontrada() == (esperado != string::npos)
+                          && (!sumidero.encontrada() || sumidero.finCoincidencia() == esperado + pista.size()),
+                      caso + ": SumideroCoincidencia \"" + pista + "\"");
+
+            ConjuntoPistas conjunto;
+            vector<string> pistas;
+            int cantidad = 1 + (int)(azar() % 5);
+            for (int i = 0; i < cantidad; i++) {
+                pistas.push_back(i > 0 && azar() % 4 == 0 ? pistas[i - 1] : PistaAlAzar(azar, texto, alfabeto));
+                conjunto.agregar((const unsigned char*)pistas[i].data(), pistas[i].size());
+            }
+            conjunto.preparar(PISTAS_TODAS);
+            vector<uint64_t> finales(pistas.size());
+            int encontradas = conjunto.buscarEn(datos, texto.size(), finales.data());
+            int esperadas = 0;
+            for (size_t i = 0; i < pistas.size(); i++) {
+                size_t posicion = texto.find(pistas[i]);
+                if (posicion != string::npos) {
+                    esperadas++;
+                }
+                Comprobar(posicion == string::npos ? finales[i] == ConjuntoPistas::NO_ENCONTRADA
+                                                   : finales[i] == posicion + pistas[i].size(),
+                          caso + ": ConjuntoPistas \"" + pistas[i] + "\"");
+            }
+            Comprobar(encontradas == esperadas, caso + ": ConjuntoPistas cuenta las encontradas");
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// LZ78 en paralelo
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief La descompresión LZ78 en paralelo da lo mismo que la serial, con ambos sumideros.
+ *
+ * Con el sumidero genérico la salida se compara mientras llega, sin guardarla.
+ */
+static void CompararParalela(const ClaveCifrado& clave, const string& caso, const unsigned char* datos,
+                             size_t tamaño) {
+    SumideroMemoria serial;
+    size_t totalSerial = 0;
+    bool validoSerial = descompresionLZ78Flujo(datos, tamaño, clave, serial, totalSerial);
+
+    const int hilos[] = { 1, 2, 3, 8 };
+    for (int numHilos : hilos) {
+        string nombre = caso + ", " + to_string(numHilos) + " hilos";
+        SumideroMemoria memoria;
+        size_t total = 0;
+        bool valido = descompresionLZ78Paralela(datos, tamaño, clave, memoria, total, numHilos);
+        Comprobar(valido == validoSerial
+                      && (!valido || (total == totalSerial && memoria.tamaño() == serial.tamaño()
+                                      && memcmp(memoria.datos(), serial.datos(), total) == 0)),
+                  nombre + ": paralela a memoria igual a la serial");
+
+        size_t recibido = 0;
+        bool igual = true;
+        SumideroFuncion funcion([&](const unsigned char* bytes, size_t cantidad) {
+            if (recibido + cantidad > serial.tamaño()
+                || memcmp(bytes, serial.datos() + recibido, cantidad) != 0) {
+                igual = false;
+            }
+            recibido += cantidad;
+            return true;
+        });
+        valido = descompresionLZ78Paralela(datos, tamaño, clave, (Sumidero&)funcion, total, numHilos);
+        Comprobar(valido == validoSerial && (!valido || (igual && recibido == totalSerial)),
+                  nombre + ": paralela a un sumidero igual a la serial");
+    }
+}
+
+/**
+ * @brief Entradas de más de 1 MiB (el mínimo para repartir) con esquemas al azar, dañadas
+ *        o no, y una de más de 64 MiB de salida para que el sumidero genérico use varias ventanas.
+ */
+static void PruebaLZ78Paralela(mt19937& azar) {
+    int cantidad = 0;
+    const EsquemaCifrado* esquemas = EsquemasCifrado(cantidad);
+    for (int vuelta = 0; vuelta < 4; vuelta++) {
+        const EsquemaCifrado& esquema = esquemas[vuelta % cantidad];
+        int indice = uniform_int_distribution<int>(0, esquema.totalCandidatos() - 1)(azar);
+        ClaveCifrado clave(esquema, indice);
+        string caso = Nombre(clave, indice);
+
+        vector<unsigned char> texto = TextoAlAzar(azar, 3 << 20, "abcdefghijklmnopqrstuvwxyz", 1 + vuelta);
+        SumideroMemoria comprimido;
+        Comprimir<CompresorLZ78>(azar, clave, texto, comprimido);
+        Comprobar(comprimido.tamaño() > (1 << 20), caso + ": la entrada alcanza para repartir");
+        CompararParalela(clave, caso, comprimido.datos(), comprimido.tamaño());
+
+        // Una referencia fuera del diccionario en una terna al azar
+        vector<unsigned char> dañado(comprimido.datos(), comprimido.datos() + comprimido.tamaño());
+        size_t terna = uniform_int_distribution<size_t>(dañado.size() / 6, dañado.size() / 3 - 1)(azar);
+        unsigned char referencia[2] = { 0xFF, 0xFF };
+        clave.cifrar(&dañado[3 * terna], referencia, 2, 3 * terna);
+        CompararParalela(clave, caso + " dañada", dañado.data(), dañado.size());
+    }
+
+    ClaveCifrado clave(esquemas[0], uniform_int_distribution<int>(0, esquemas[0].totalCandidatos() - 1)(azar));
+    vector<unsigned char> texto(70u << 20, 'a');
+    vector<unsigned char> cola = TextoAlAzar(azar, 3 << 20, "abcdefghijklmnopqrstuvwxyz", 2);
+    texto.insert(texto.end(), cola.begin(), cola.end());
+    SumideroMemoria comprimido;
+    Comprimir<CompresorLZ78>(azar, clave, texto, comprimido);
+    CompararParalela(clave, "salida de 73 MiB", comprimido.datos(), comprimido.tamaño());
+}
+
+int main(int argc, char* argv[]) {
+    unsigned int semilla = SEMILLA_PREDETERMINADA;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--semilla") == 0 && i + 1 < argc) {
+            semilla = (unsigned int)strtoul(argv[++i], nullptr, 10);
+        } else {
+            cerr << "Uso: Pruebas [--semilla N]" << endl;
+            return 1;
+        }
+    }
+    cout << "Semilla: " << semilla << endl;
+
+    string rutaTemporal = (filesystem::temp_directory_path()
+                           / ("Desafio1_Pruebas_" + to_string(semilla) + ".txt")).string();
+
+    struct Prueba {
+        const char* nombre;
+        void (*ejecutar)(mt19937&, const string&);
+    };
+    const Prueba pruebas[] = {
+        { "Cifrado de cada esquema", [](mt19937& azar, const string&) { PruebaEsquemasCifrado(azar); } },
+        { "Compresion y descompresion", PruebaCompresion },
+        { "Busqueda de pistas", [](mt19937& azar, const string&) { PruebaBuscadores(azar); } },
+        { "LZ78 serial y paralelo", [](mt19937& azar, const string&) { PruebaLZ78Paralela(azar); } },
+    };
+    for (const Prueba& prueba : pruebas) {
+        mt19937 azar(semilla);
+        int fallasAntes = fallas;
+        cout << prueba.nombre << "..." << endl;
+        prueba.ejecutar(azar, rutaTemporal);
+        cout << "  " << (fallas == fallasAntes ? "OK" : to_string(fallas - fallasAntes) + " fallas") << endl;
+    }
+
+    cout << "Comprobaciones: " << comprobaciones << ", fallas: " << fallas << endl;
+    return fallas == 0 ? 0 : 1;
+}
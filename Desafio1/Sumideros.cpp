@@ -0,0 +1,368 @@
+#include <cstdio>
+#include <cstring>
+#include "BuscadorPista.h"
+#include "ConjuntoPistas.h"
+#include "Sumideros.h"
+using namespace std;
+
+static const size_t BLOQUE_ARCHIVO = (size_t)1 << 20;  // Bytes acumulados por escritura al temporal
+
+/**
+ * @brief Implementación por defecto: expande la repetición en bloques de 256 bytes.
+ */
+bool Sumidero::escribirRepeticion(unsigned char caracter, size_t cantidad) {
+    unsigned char bloque[256];
+    memset(bloque, caracter, sizeof(bloque));
+    while (cantidad > 0) {
+        size_t parte = (cantidad < sizeof(bloque)) ? cantidad : sizeof(bloque);
+        if (!escribir(bloque, parte)) {
+            return false;
+        }
+        cantidad -= parte;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// SumideroMemoria
+// ---------------------------------------------------------------------------
+
+SumideroMemoria::SumideroMemoria(size_t capacidadInicial)
+    : buffer(nullptr), usado(0), capacidad(0) {
+    if (capacidadInicial > 0) {
+        reservar(capacidadInicial);
+    }
+}
+
+SumideroMemoria::~SumideroMemoria() {
+    delete[] buffer;
+}
+
+/**
+ * @brief Asegura espacio para `minimo` bytes más el terminador nulo, duplicando la capacidad.
+ */
+void SumideroMemoria::reservar(size_t minimo) {
+    if (minimo + 1 <= capacidad) {
+        return;
+    }
+    size_t nueva = (capacidad > 0) ? capacidad : 64;
+    while (nueva < minimo + 1) {
+        nueva *= 2;
+    }
+    unsigned char* nuevoBuffer = new unsigned char[nueva];
+    if (usado > 0) {
+        memcpy(nuevoBuffer, buffer, usado);
+    }
+    delete[] buffer;
+    buffer = nuevoBuffer;
+    capacidad = nueva;
+}
+
+bool SumideroMemoria::escribir(const unsigned char* bytes, size_t cantidad) {
+    reservar(usado + cantidad);
+    memcpy(buffer + usado, bytes, cantidad);
+    usado += cantidad;
+    return true;
+}
+
+bool SumideroMemoria::escribirRepeticion(unsigned char caracter, size_t cantidad) {
+    reservar(usado + cantidad);
+    memset(buffer + usado, caracter, cantidad);
+    usado += cantidad;
+    return true;
+}
+
+void SumideroMemoria::descartar() {
+    usado = 0;
+}
+
+/**
+ * @brief Entrega el buffer al llamador, terminado en '\0', y deja el sumidero vacío.
+ *
+ * @return Puntero que debe liberarse con delete[] (nunca nullptr).
+ */
+unsigned char* SumideroMemoria::liberar() {
+    reservar(usado);
+    buffer[usado] = '\0';
+    unsigned char* resultado = buffer;
+    buffer = nullptr;
+    usado = 0;
+    capacidad = 0;
+    return resultado;
+}
+
+/**
+ * @brief Agrega `cantidad` bytes al final sin inicializarlos; quien llama los escribe.
+ *
+ * @return Puntero al primero de los bytes agregados, válido hasta la próxima escritura.
+ */
+unsigned char* SumideroMemoria::extender(size_t cantidad) {
+    reservar(usado + cantidad);
+    unsigned char* inicio = buffer + usado;
+    usado += cantidad;
+    return inicio;
+}
+
+// ---------------------------------------------------------------------------
+// SumideroBloques
+// ---------------------------------------------------------------------------
+
+SumideroBloques::SumideroBloques(size_t capacidadBloque, FuncionBloque destino)
+    : bloque(new unsigned char[capacidadBloque > 0 ? capacidadBloque : 1]),
+      capacidad(capacidadBloque > 0 ? capacidadBloque : 1), usado(0), destino(destino) {}
+
+SumideroBloques::~SumideroBloques() {
+    delete[] bloque;
+}
+
+bool SumideroBloques::escribir(const unsigned char* bytes, size_t cantidad) {
+    while (cantidad > 0) {
+        size_t parte = capacidad - usado;
+        if (parte > cantidad) {
+            parte = cantidad;
+        }
+        memcpy(bloque + usado, bytes, parte);
+        usado += parte;
+        bytes += parte;
+        cantidad -= parte;
+
+        if (usado == capacidad && !vaciar()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SumideroBloques::finalizar() {
+    vaciar();
+    return true;
+}
+
+void SumideroBloques::descartar() {
+    usado = 0;
+}
+
+/**
+ * @brief Entrega el bloque acumulado al destino.
+ *
+ * @return false si el destino no necesita más datos.
+ */
+bool SumideroBloques::vaciar() {
+    if (usado == 0) {
+        return true;
+    }
+    size_t cantidad = usado;
+    usado = 0;
+    return destino(bloque, cantidad);
+}
+
+// ---------------------------------------------------------------------------
+// SumideroArchivo
+// ---------------------------------------------------------------------------
+
+SumideroArchivo::SumideroArchivo(const char* rutaArchivo)
+    : archivo(rutaArchivo), bloque(new unsigned char[BLOQUE_ARCHIVO]), usado(0) {}
+
+SumideroArchivo::~SumideroArchivo() {
+    delete[] bloque;
+}
+
+bool SumideroArchivo::abierto() const {
+    return archivo.abierto();
+}
+
+bool SumideroArchivo::escribir(const unsigned char* bytes, size_t cantidad) {
+    if (usado + cantidad > BLOQUE_ARCHIVO && !vaciar()) {
+        return false;
+    }
+    if (cantidad >= BLOQUE_ARCHIVO) {
+        return archivo.escribir(bytes, cantidad);
+    }
+    memcpy(bloque + usado, bytes, cantidad);
+    usado += cantidad;
+    return true;
+}
+
+/**
+ * @brief Copia la repetición directo al bloque, sin pasar por bloques de 256 bytes.
+ */
+bool SumideroArchivo::escribirRepeticion(unsigned char caracter, size_t cantidad) {
+    while (cantidad > 0) {
+        if (usado == BLOQUE_ARCHIVO && !vaciar()) {
+            return false;
+        }
+        size_t parte = (cantidad < BLOQUE_ARCHIVO - usado) ? cantidad : BLOQUE_ARCHIVO - usado;
+        memset(bloque + usado, caracter, parte);
+        usado += parte;
+        cantidad -= parte;
+    }
+    return true;
+}
+
+/**
+ * @brief Escribe lo que queda en el bloque y reemplaza el destino.
+ */
+bool SumideroArchivo::finalizar() {
+    return vaciar() && archivo.confirmar();
+}
+
+/**
+ * @brief Vacía el temporal; el destino queda como estaba.
+ */
+void SumideroArchivo::descartar() {
+    usado = 0;
+    archivo.reiniciar();
+}
+
+/**
+ * @brief Pasa el bloque acumulado al temporal.
+ *
+ * @return false si la escritura falló.
+ */
+bool SumideroArchivo::vaciar() {
+    size_t cantidad = usado;
+    usado = 0;
+    return cantidad == 0 || archivo.escribir(bloque, cantidad);
+}
+
+// ---------------------------------------------------------------------------
+// SumideroFuncion
+// ---------------------------------------------------------------------------
+
+SumideroFuncion::SumideroFuncion(FuncionBloque funcion) : funcion(funcion) {}
+
+bool SumideroFuncion::escribir(const unsigned char* bytes, size_t cantidad) {
+    return funcion(bytes, cantidad);
+}
+
+// ---------------------------------------------------------------------------
+// SumideroCoincidencia
+// ---------------------------------------------------------------------------
+
+SumideroCoincidencia::SumideroCoincidencia(const AutomataPista& automata)
+    : automata(automata), estado(0), recibidos(0), hallada(false), finPista(0) {
+    hallada = automata.aceptado(estado);
+}
+
+/**
+ * @brief Avanza el autómata con cada byte; deja de pedir datos al completar la pista.
+ */
+bool SumideroCoincidencia::escribir(const unsigned char* bytes, size_t cantidad) {
+    if (hallada) {
+        return false;
+    }
+    for (size_t i = 0; i < cantidad; i++) {
+        estado = automata.avanzar(estado, bytes[i]);
+        if (automata.aceptado(estado)) {
+            hallada = true;
+            finPista = recibidos + i + 1;
+            recibidos += i + 1;
+            return false;
+        }
+    }
+    recibidos += cantidad;
+    return true;
+}
+
+/**
+ * @brief Avanza el autómata con una corrida; se corta en cuanto el estado deja de cambiar.
+ */
+bool SumideroCoincidencia::escribirRepeticion(unsigned char caracter, size_t cantidad) {
+    if (hallada) {
+        return false;
+    }
+    for (size_t i = 0; i < cantidad; i++) {
+        unsigned int siguiente = automata.avanzar(estado, caracter);
+        if (automata.aceptado(siguiente)) {
+            hallada = true;
+            finPista = recibidos + i + 1;
+            recibidos += i + 1;
+            estado = siguiente;
+            return false;
+        }
+        if (siguiente == estado) {
+            break;  // Punto fijo: el resto de la corrida no cambia el estado
+        }
+        estado = siguiente;
+    }
+    recibidos += cantidad;
+    return true;
+}
+
+void SumideroCoincidencia::descartar() {
+    estado = 0;
+    recibidos = 0;
+    hallada = automata.aceptado(estado);
+    finPista = 0;
+}
+
+// ---------------------------------------------------------------------------
+// SumideroPistas
+// ---------------------------------------------------------------------------
+
+SumideroPistas::SumideroPistas(const ConjuntoPistas& conjunto, uint64_t* finales, bool todas)
+    : conjunto(conjunto), finales(finales), estado(0), recibidos(0), numEncontradas(0),
+      objetivo(todas ? (int)conjunto.size() : conjunto.requeridas()) {
+    descartar();
+}
+
+bool SumideroPistas::cumplido() const {
+    return numEncontradas >= conjunto.requeridas();
+}
+
+/**
+ * @brief Avanza el autómata con cada byte; deja de pedir datos al alcanzar el objetivo.
+ */
+bool SumideroPistas::escribir(const unsigned char* bytes, size_t cantidad) {
+    if (numEncontradas >= objetivo) {
+        return false;
+    }
+    for (size_t i = 0; i < cantidad; i++) {
+        estado = conjunto.avanzar(estado, bytes[i]);
+        if (conjunto.tieneSalida(estado)) {
+            numEncontradas += conjunto.marcar(estado, recibidos + i + 1, finales);
+            if (numEncontradas >= objetivo) {
+                recibidos += i + 1;
+                return false;
+            }
+        }
+    }
+    recibidos += cantidad;
+    return true;
+}
+
+/**
+ * @brief Avanza el autómata con una corrida; se corta en cuanto el estado deja de cambiar.
+ *
+ * En el punto fijo las pistas del estado ya se anotaron al entrar en él por primera vez.
+ */
+bool SumideroPistas::escribirRepeticion(unsigned char caracter, size_t cantidad) {
+    if (numEncontradas >= objetivo) {
+        return false;
+    }
+    for (size_t i = 0; i < cantidad; i++) {
+        unsigned int siguiente = conjunto.avanzar(estado, caracter);
+        if (siguiente == estado) {
+            break;  // Punto fijo: el resto de la corrida no cambia el estado
+        }
+        estado = siguiente;
+        if (conjunto.tieneSalida(estado)) {
+            numEncontradas += conjunto.marcar(estado, recibidos + i + 1, finales);
+            if (numEncontradas >= objetivo) {
+                recibidos += i + 1;
+                return false;
+            }
+        }
+    }
+    recibidos += cantidad;
+    return true;
+}
+
+void SumideroPistas::descartar() {
+    for (size_t i = 0; i < conjunto.size(); i++) {
+        finales[i] = ConjuntoPistas::NO_ENCONTRADA;
+    }
+    estado = 0;
+    recibidos = 0;
+    numEncontradas = 0;
+}
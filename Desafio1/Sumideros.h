@@ -0,0 +1,212 @@
+#ifndef SUMIDEROS_H
+#define SUMIDEROS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include "EscritorResultados.h"
+
+/**
+ * @brief Destino genérico para los bytes que produce un descompresor por flujo.
+ *
+ * Los descompresores entregan su salida por partes llamando a `escribir` (o a
+ * `escribirRepeticion` para las corridas RLE). Si alguno retorna false, el sumidero
+ * no necesita más datos: el descompresor deja de producir salida pero sigue validando
+ * el resto de la entrada, que es mucho más barato. Al terminar con éxito se llama a
+ * `finalizar`; si la entrada resulta inválida se llama a `descartar` y lo recibido no
+ * debe usarse.
+ */
+class Sumidero {
+public:
+    virtual ~Sumidero() {}
+
+    /** @brief Recibe `cantidad` bytes. @return false si no necesita más datos. */
+    virtual bool escribir(const unsigned char* bytes, size_t cantidad) = 0;
+
+    /** @brief Recibe `cantidad` repeticiones de `caracter`. Por defecto se expande en bloques y llama a `escribir`. */
+    virtual bool escribirRepeticion(unsigned char caracter, size_t cantidad);
+
+    /** @brief Se llama una vez al terminar con éxito. @return false si no se pudo completar la salida. */
+    virtual bool finalizar() { return true; }
+
+    /** @brief Se llama cuando la entrada resultó inválida; debe deshacer lo recibido. */
+    virtual void descartar() {}
+};
+
+/**
+ * @brief Función que recibe un bloque de bytes; retorna false si no necesita más datos.
+ */
+typedef std::function<bool(const unsigned char*, size_t)> FuncionBloque;
+
+/**
+ * @brief Sumidero que acumula la salida en un buffer dinámico que crece al doble cuando se llena.
+ */
+class SumideroMemoria : public Sumidero {
+public:
+    explicit SumideroMemoria(size_t capacidadInicial = 0);
+    ~SumideroMemoria();
+    SumideroMemoria(const SumideroMemoria&) = delete;
+    SumideroMemoria& operator=(const SumideroMemoria&) = delete;
+
+    bool escribir(const unsigned char* bytes, size_t cantidad) override;
+    bool escribirRepeticion(unsigned char caracter, size_t cantidad) override;
+    void descartar() override;
+
+    /** @brief Bytes acumulados (no terminados en '\0'). */
+    const unsigned char* datos() const { return buffer; }
+    /** @brief Cantidad de bytes acumulados. */
+    size_t tamaño() const { return usado; }
+    /** @brief Entrega el buffer terminado en '\0' (liberar con `delete[]`) y deja el sumidero vacío. */
+    unsigned char* liberar();
+    /**
+     * @brief Agrega `cantidad` bytes sin inicializar y devuelve dónde empiezan, para escribirlos
+     *        en el lugar (por ejemplo desde varios hilos, cada uno en su parte).
+     */
+    unsigned char* extender(size_t cantidad);
+
+private:
+    void reservar(size_t minimo);
+
+    unsigned char* buffer;
+    size_t usado;
+    size_t capacidad;
+};
+
+/**
+ * @brief Sumidero con un bloque de tamaño fijo que se entrega a una función cada vez que se llena.
+ *
+ * Útil para procesar salidas muy grandes con memoria acotada. El último bloque
+ * parcial se entrega en `finalizar`.
+ */
+class SumideroBloques : public Sumidero {
+public:
+    SumideroBloques(size_t capacidadBloque, FuncionBloque destino);
+    ~SumideroBloques();
+    SumideroBloques(const SumideroBloques&) = delete;
+    SumideroBloques& operator=(const SumideroBloques&) = delete;
+
+    bool escribir(const unsigned char* bytes, size_t cantidad) override;
+    bool finalizar() override;
+    void descartar() override;
+
+private:
+    bool vaciar();
+
+    unsigned char* bloque;
+    size_t capacidad;
+    size_t usado;
+    FuncionBloque destino;
+};
+
+/**
+ * @brief Sumidero que escribe la salida en un archivo binario a través de un @ref ArchivoAtomico.
+ *
+ * La salida se acumula en bloques de 1 MiB; el destino se reemplaza recién al finalizar.
+ * Descartar vacía el temporal (el sumidero se puede volver a usar, como @ref SumideroMemoria)
+ * y el destino queda como estaba; el temporal se borra al destruir el sumidero.
+ */
+class SumideroArchivo : public Sumidero {
+public:
+    explicit SumideroArchivo(const char* rutaArchivo);
+    ~SumideroArchivo();
+    SumideroArchivo(const SumideroArchivo&) = delete;
+    SumideroArchivo& operator=(const SumideroArchivo&) = delete;
+
+    /** @brief Indica si el archivo se pudo crear. */
+    bool abierto() const;
+
+    bool escribir(const unsigned char* bytes, size_t cantidad) override;
+    bool escribirRepeticion(unsigned char caracter, size_t cantidad) override;
+    bool finalizar() override;
+    void descartar() override;
+
+private:
+    bool vaciar();
+
+    ArchivoAtomico archivo;
+    unsigned char* bloque;
+    size_t usado;
+};
+
+/**
+ * @brief Sumidero que entrega cada parte de la salida directamente a una función.
+ */
+class SumideroFuncion : public Sumidero {
+public:
+    explicit SumideroFuncion(FuncionBloque funcion);
+
+    bool escribir(const unsigned char* bytes, size_t cantidad) override;
+
+private:
+    FuncionBloque funcion;
+};
+
+/**
+ * @brief Sumidero que busca la pista en la salida a medida que se descomprime, sin guardarla.
+ *
+ * Avanza un @ref AutomataPista con cada byte recibido y, en cuanto la pista se completa,
+ * responde que no necesita más datos. Las corridas RLE se procesan hasta que el estado del
+ * autómata deja de cambiar, sin recorrer cada repetición.
+ */
+class AutomataPista;
+
+class SumideroCoincidencia : public Sumidero {
+public:
+    explicit SumideroCoincidencia(const AutomataPista& automata);
+
+    bool escribir(const unsigned char* bytes, size_t cantidad) override;
+    bool escribirRepeticion(unsigned char caracter, size_t cantidad) override;
+    void descartar() override;
+
+    /** @brief Indica si la pista apareció en lo recibido. */
+    bool encontrada() const { return hallada; }
+    /** @brief Posición (en la salida) del byte siguiente al final de la pista encontrada. */
+    uint64_t finCoincidencia() const { return finPista; }
+
+private:
+    const AutomataPista& automata;
+    unsigned int estado;
+    uint64_t recibidos;
+    bool hallada;
+    uint64_t finPista;
+};
+
+/**
+ * @brief Sumidero que busca un @ref ConjuntoPistas en la salida, sin guardarla.
+ *
+ * Anota dónde termina la primera aparición de cada pista y responde que no necesita más
+ * datos apenas aparecen las pistas requeridas por el conjunto. Como @ref SumideroCoincidencia,
+ * corta las corridas RLE cuando el estado del autómata deja de cambiar.
+ */
+class ConjuntoPistas;
+
+class SumideroPistas : public Sumidero {
+public:
+    /**
+     * @param conjunto Conjunto ya preparado.
+     * @param finales Arreglo de `conjunto.size()` posiciones donde se anota el fin de cada pista
+     *                (o @ref ConjuntoPistas::NO_ENCONTRADA); lo aporta quien llama.
+     * @param todas true para seguir pidiendo datos hasta encontrar todas las pistas, como
+     *              @ref ConjuntoPistas::buscarEn, en lugar de cortar al cumplirse el criterio.
+     */
+    SumideroPistas(const ConjuntoPistas& conjunto, uint64_t* finales, bool todas = false);
+
+    bool escribir(const unsigned char* bytes, size_t cantidad) override;
+    bool escribirRepeticion(unsigned char caracter, size_t cantidad) override;
+    void descartar() override;
+
+    /** @brief Indica si ya aparecieron las pistas requeridas. */
+    bool cumplido() const;
+    /** @brief Cantidad de pistas distintas encontradas hasta ahora. */
+    int encontradas() const { return numEncontradas; }
+
+private:
+    const ConjuntoPistas& conjunto;
+    uint64_t* finales;
+    unsigned int estado;
+    uint64_t recibidos;
+    int numEncontradas;
+    int objetivo;
+};
+
+#endif // SUMIDEROS_H
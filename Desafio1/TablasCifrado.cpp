@@ -0,0 +1,65 @@
+#include "TablasCifrado.h"
+
+/**
+ * @brief Descifra un byte: XOR con `clave` y luego rotacion de `bits` a la derecha.
+ */
+static constexpr unsigned char DescifrarByte(unsigned char b, unsigned char clave, int bits) {
+    return (unsigned char)(((unsigned char)(b ^ clave) >> bits) | ((unsigned char)(b ^ clave) << ((8 - bits) & 7)));
+}
+
+/**
+ * @brief Cifra un byte: rotacion de `bits` a la izquierda y luego XOR con `clave`.
+ */
+static constexpr unsigned char CifrarByte(unsigned char b, unsigned char clave, int bits) {
+    return (unsigned char)((unsigned char)((b << bits) | (b >> ((8 - bits) & 7))) ^ clave);
+}
+
+// Verificaciones en tiempo de compilacion de algunos valores conocidos
+static_assert(DescifrarByte('a', 0, 0) == 'a', "la identidad debe conservar el byte");
+static_assert(DescifrarByte(0x5A, 0x5A, 0) == 0, "XOR con la misma clave debe dar cero");
+static_assert(DescifrarByte(0x01, 0, 1) == 0x80, "rotacion a la derecha de un bit");
+static_assert(CifrarByte(0x80, 0, 1) == 0x01, "rotacion a la izquierda de un bit");
+static_assert(DescifrarByte(CifrarByte(0x3C, 0xA7, 5), 0xA7, 5) == 0x3C, "cifrar y descifrar son inversas");
+
+/**
+ * @brief Tablas de cifrado y descifrado para los 256 x 8 pares (clave, rotacion).
+ *
+ * `descifrar[clave][bits][b]` es `DescifrarByte(b, clave, bits)` y `cifrar` su inversa.
+ * Cada tabla ocupa 512 KiB, pero un candidato solo usa 256 bytes de ella.
+ */
+struct TablasCifrado {
+    unsigned char descifrar[256][8][256];
+    unsigned char cifrar[256][8][256];
+};
+
+static void LlenarTablasCifrado(TablasCifrado& tablas) {
+    for (int clave = 0; clave < 256; clave++) {
+        for (int bits = 0; bits < 8; bits++) {
+            for (int b = 0; b < 256; b++) {
+                tablas.descifrar[clave][bits][b] = DescifrarByte((unsigned char)b, (unsigned char)clave, bits);
+                tablas.cifrar[clave][bits][b] = CifrarByte((unsigned char)b, (unsigned char)clave, bits);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Las tablas se llenan en el primer uso (una sola vez, aunque lo pidan varios hilos).
+ *
+ * Generarlas en tiempo de compilacion supera el limite de evaluacion constexpr de
+ * algunos compiladores y agrega 1 MiB de datos a cada ejecutable.
+ */
+static const TablasCifrado& Tablas() {
+    static TablasCifrado tablas;
+    static const bool llenas = (LlenarTablasCifrado(tablas), true);
+    (void)llenas;
+    return tablas;
+}
+
+const unsigned char* TablaDescifrado(unsigned char clave, int bits) {
+    return Tablas().descifrar[clave][bits & 7];
+}
+
+const unsigned char* TablaCifrado(unsigned char clave, int bits) {
+    return Tablas().cifrar[clave][bits & 7];
+}
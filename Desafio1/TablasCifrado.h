@@ -0,0 +1,28 @@
+#ifndef TABLASCIFRADO_H
+#define TABLASCIFRADO_H
+
+/**
+ * @brief Retorna la tabla de descifrado de 256 bytes para un par (clave, rotación).
+ *
+ * `tabla[b]` es el byte `b` tras aplicar XOR con `clave` y rotar `bits` posiciones
+ * a la derecha. Las tablas de los 256 x 8 pares se llenan una vez, en el primer uso
+ * (TablasCifrado.cpp), así que descifrar un byte es un solo acceso a memoria.
+ *
+ * @param clave Clave XOR.
+ * @param bits Bits de rotación a la derecha (se reduce a 0-7).
+ * @return Puntero a 256 bytes de solo lectura.
+ */
+const unsigned char* TablaDescifrado(unsigned char clave, int bits);
+
+/**
+ * @brief Retorna la tabla de cifrado de 256 bytes para un par (clave, rotación).
+ *
+ * Es la inversa de @ref TablaDescifrado: rota `bits` posiciones a la izquierda y luego aplica XOR.
+ *
+ * @param clave Clave XOR.
+ * @param bits Bits de rotación a la izquierda (se reduce a 0-7).
+ * @return Puntero a 256 bytes de solo lectura.
+ */
+const unsigned char* TablaCifrado(unsigned char clave, int bits);
+
+#endif // TABLASCIFRADO_H
@@ -9,28 +9,259 @@
  *
  * El flujo principal es:
  * 1. Construcción dinámica de las rutas de entrada/salida.
- * 2. Lectura de los archivos encriptados y de pistas en memoria.
+ * 2. Apertura de los archivos encriptados y de pistas (mapeados en memoria, sin copias).
  * 3. Llamado a la función de procesamiento (@ref BuscarParametros).
  * 4. Escritura del archivo modificado.
  * 5. Liberación de memoria.
  */
 
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <iostream>
 
-#include "funciones.h"
+#include "Alfabeto.h"
+#include "ArchivoMapeado.h"
+#include "BusquedaParametros.h"
+#include "CacheParametros.h"
+#include "CompresionDescompresion.h"
+#include "ConjuntoPistas.h"
+#include "EscritorResultados.h"
+#include "EsquemasCifrado.h"
+#include "IndiceDescompresion.h"
+#include "Metricas.h"
+#include "ProcesamientoLotes.h"
+#include "ProgresoBusqueda.h"
+#include "Sumideros.h"
 
     using namespace std;
 
+/**
+ * @brief Descomprime por bloques un archivo LZ78 con parámetros conocidos.
+ *
+ * @param rutaEntrada Archivo encriptado y comprimido.
+ * @param rutaSalida Archivo donde se escribe el texto descomprimido.
+ * @param cifrado Clave y bits con los que se cifró el archivo.
+ * @return 0 si la descompresión fue válida, 1 en caso contrario.
+ */
+static int DescomprimirArchivoLZ78(const char* rutaEntrada, const char* rutaSalida, const ClaveCifrado& cifrado) {
+    ifstream entrada(rutaEntrada, ios::binary);
+    if (!entrada.is_open()) {
+        cout << "No se pudo abrir el archivo " << rutaEntrada << endl;
+        return 1;
+    }
+    SumideroArchivo salida(rutaSalida);
+    if (!salida.abierto()) {
+        cout << "No se pudo crear el archivo " << rutaSalida << endl;
+        return 1;
+    }
+
+    uint64_t total = 0;
+    if (!descompresionLZ78Flujo(entrada, cifrado, salida, total)) {
+        cout << "Los datos no son LZ78 validos con esa clave y bits" << endl;
+        return 1;
+    }
+    cout << "Bytes descomprimidos: " << total << endl;
+    return 0;
+}
+
+/**
+ * @brief Lee una clave "K" o "K1,K2,..." con los bytes que usa el esquema, y los bits de rotación.
+ *
+ * @return true si la cantidad de bytes coincide con el esquema, cada uno está entre 0 y 254
+ *         y los bits son un número entre 0 y 7.
+ */
+static bool LeerClaveCifrado(const char* texto, const char* textoBits, const EsquemaCifrado& esquema,
+                             ParametrosCifrado& parametros) {
+    parametros = {};
+    char* finBits = nullptr;
+    long bits = strtol(textoBits, &finBits, 10);
+    if (finBits == textoBits || *finBits != '\0' || bits < 0 || bits > 7) {
+        return false;
+    }
+    parametros.bits = (int)bits;
+    const char* p = texto;
+    while (*p != '\0') {
+        char* fin = nullptr;
+        long byte = strtol(p, &fin, 10);
+        if (fin == p || byte < 0 || byte > 254 || parametros.longitudClave == MAX_LONGITUD_CLAVE) {
+            return false;
+        }
+        parametros.clave[parametros.longitudClave++] = (unsigned char)byte;
+        p = (*fin == ',') ? fin + 1 : fin;
+        if (*fin != ',' && *fin != '\0') {
+            return false;
+        }
+    }
+    return parametros.longitudClave == esquema.longitudClave;
+}
+
+/**
+ * @brief Extrae los bytes [desde, hasta) del texto de un archivo con parámetros conocidos.
+ *
+ * Usa el índice `ENCRIPTADO.indice` (@ref IndiceDescompresion) si corresponde al archivo y
+ * a los parámetros; si no, lo construye con una pasada y lo guarda para las siguientes
+ * extracciones. Con SALIDA "-" los bytes se escriben en la consola, sin otros mensajes.
+ *
+ * @return 0 si se pudo extraer, 1 en caso contrario.
+ */
+static int ExtraerRango(const char* rutaEntrada, const char* rutaSalida, const ClaveCifrado& cifrado,
+                        uint64_t desde, uint64_t hasta) {
+    bool consola = (strcmp(rutaSalida, "-") == 0);
+    ArchivoMapeado entrada(rutaEntrada);
+    if (!entrada.abierto()) {
+        cout << "No se pudo abrir el archivo " << rutaEntrada << endl;
+        return 1;
+    }
+
+    string rutaIndice = string(rutaEntrada) + ".indice";
+    IndiceDescompresion indice;
+    if (!indice.cargar(rutaIndice.c_str(), entrada.datos(), entrada.size(), cifrado)) {
+        if (!indice.construir(entrada.datos(), entrada.size(), cifrado)) {
+            cout << "Los datos no son RLE ni LZ78 validos con esos parametros" << endl;
+            return 1;
+        }
+        if (!indice.guardar(rutaIndice.c_str())) {
+            cout << "No se pudo guardar el indice " << rutaIndice << endl;
+        } else if (!consola) {
+            cout << "Indice guardado en " << rutaIndice << " (" << indice.puntos() << " puntos de control)" << endl;
+        }
+    }
+
+    if (hasta > indice.total()) {
+        hasta = indice.total();
+    }
+    size_t cantidad = (desde < hasta) ? (size_t)(hasta - desde) : 0;
+    unsigned char* bytes = new unsigned char[cantidad + 1];
+    size_t extraidos = indice.extraer(entrada.datos(), desde, hasta, bytes);
+
+    bool escrito = true;
+    if (consola) {
+        cout.write(reinterpret_cast<const char*>(bytes), (streamsize)extraidos);
+        cout.flush();
+    } else {
+        escrito = EscribirArchivoAtomico(rutaSalida, bytes, extraidos);
+        cout << "Bytes extraidos: " << extraidos << " de " << indice.total() << " ("
+             << ((indice.metodo() == METODO_RLE) ? "RLE" : "LZ78") << ")" << endl;
+    }
+    delete[] bytes;
+    if (!escrito) {
+        cout << "No se pudo escribir el archivo " << rutaSalida << endl;
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Interpreta el criterio de `--aceptar`: "cualquiera" (o "any"), "todas" (o "all") o un número k.
+ *
+ * @return Pistas requeridas (1, k o @ref PISTAS_TODAS); 1 si el texto no es válido.
+ */
+static int LeerCriterioPistas(const char* texto) {
+    if (strcmp(texto, "todas") == 0 || strcmp(texto, "all") == 0) {
+        return PISTAS_TODAS;
+    }
+    if (strcmp(texto, "cualquiera") == 0 || strcmp(texto, "any") == 0) {
+        return 1;
+    }
+    int k = atoi(texto);
+    if (k <= 0) {
+        cout << "Criterio de pistas no valido: " << texto << "; se acepta con cualquiera" << endl;
+        return 1;
+    }
+    return k;
+}
+
+/**
+ * @brief Muestra los esquemas de cifrado disponibles para `--cifrado`.
+ */
+static void MostrarEsquemasCifrado() {
+    int cantidad = 0;
+    const EsquemaCifrado* esquemas = EsquemasCifrado(cantidad);
+    cout << "Esquemas de cifrado disponibles:" << endl;
+    for (int i = 0; i < cantidad; i++) {
+        cout << "  " << esquemas[i].nombre << ": " << esquemas[i].descripcion << endl;
+    }
+}
+
+/**
+ * @brief Descubre los archivos de un directorio o de un manifiesto y los procesa en lote.
+ *
+ * @return 0 si todos los archivos se resolvieron, 1 en caso contrario.
+ */
+static int ProcesarLoteArchivos(const char* directorio, const char* manifiesto, int numHilos,
+                                const ConjuntoPistas* comunes, int requeridas) {
+    vector<TrabajoArchivo> trabajos;
+    bool listado = (manifiesto != nullptr) ? LeerManifiesto(manifiesto, trabajos)
+                                           : DescubrirArchivos(directorio, trabajos);
+    if (!listado && trabajos.empty()) {
+        return 1;
+    }
+    if (trabajos.empty()) {
+        cout << "No se encontraron archivos para procesar" << endl;
+        return 1;
+    }
+
+    cout << "Procesando " << trabajos.size() << " archivos..." << endl;
+    int exitos = ProcesarLote(trabajos, numHilos, comunes, requeridas);
+    cout << "Archivos resueltos: " << exitos << "/" << trabajos.size() << endl;
+    return (listado && exitos == (int)trabajos.size()) ? 0 : 1;
+}
+
 /**
  * @brief Punto de entrada principal del programa.
  *
  * Procesa secuencialmente un conjunto de archivos encriptados y sus pistas asociadas.
  * Para cada archivo:
  * - Construye las rutas de entrada y salida.
- * - Lee en memoria los datos encriptados y la pista.
+ * - Mapea en memoria los datos encriptados y la pista (@ref ArchivoMapeado).
  * - Llama a @ref BuscarParametros para generar un archivo modificado.
- * - Libera la memoria reservada.
+ * - Libera los mapeos al terminar la iteración.
+ *
+ * Opciones de línea de comandos:
+ * - `--hilos N`: cantidad de hilos para la búsqueda de parámetros (1 por defecto,
+ *   0 para usar todos los núcleos disponibles).
+ * - `--hilos-descompresion N`: hilos para construir el texto LZ78 de un ganador grande
+ *   (@ref descompresionLZ78Paralela). Por defecto los de `--hilos`, salvo en lote, donde
+ *   los hilos ya están ocupados con otros archivos y se usa uno.
+ * - `--lz78 ENTRADA SALIDA CLAVE BITS`: descomprime por bloques un archivo LZ78 con
+ *   parámetros ya conocidos, sin cargarlo completo en memoria, y termina. CLAVE se lee
+ *   como en `--extraer`.
+ * - `--extraer ENCRIPTADO SALIDA CLAVE BITS DESDE HASTA`: escribe en SALIDA ("-" para la
+ *   consola) los bytes [DESDE, HASTA) del texto descomprimido, decodificando solo desde el
+ *   punto de control más cercano (@ref IndiceDescompresion), y termina. CLAVE lleva un byte
+ *   por cada byte de clave del esquema de `--cifrado`, separados por comas.
+ * - `--lote DIRECTORIO`: procesa todos los pares `EncriptadoN.txt` / `pistaN.txt` del
+ *   directorio con @ref ProcesarLote, usando `--hilos` como tamaño del grupo de hilos.
+ * - `--manifiesto ARCHIVO`: igual que `--lote`, pero con la lista de @ref LeerManifiesto.
+ * - `--metricas RUTA`: registra rechazos por motivo, bytes descomprimidos y tiempos por etapa
+ *   y los escribe en RUTA ("-" para la consola) al terminar o al recibir SIGUSR1.
+ * - `--formato-metricas json|prometheus`: formato de las métricas (JSON por defecto).
+ * - `--diccionario ARCHIVO`: pistas adicionales, una por línea, que se buscan en todos los
+ *   archivos junto con la pista propia, en una sola pasada (@ref ConjuntoPistas).
+ * - `--aceptar cualquiera|todas|K`: cuántas de las pistas deben aparecer para aceptar un
+ *   candidato (cualquiera por defecto).
+ * - `--cifrado NOMBRE`: esquema de cifrado de los archivos (@ref EsquemaCifrado); por defecto
+ *   "xor-rotr", el formato original. Con otro esquema se usa @ref BuscarParametrosCifrado
+ *   con la pista propia de cada archivo.
+ * - `--caracteres NOMBRE|ARCHIVO`: caracteres que se aceptan en el texto descomprimido
+ *   (@ref Alfabeto): "minusculas" (por defecto), "letras", "alfanumerico", "texto", "utf8"
+ *   o un archivo con los caracteres (ver @ref LeerAlfabeto).
+ * - `--cache ARCHIVO`: caché persistente de parámetros por contenido (@ref AbrirCacheParametros);
+ *   un archivo ya resuelto se comprueba con una sola descompresión en lugar de buscarse.
+ * - `--escritura-directa`: guarda los resultados grandes con `O_DIRECT` cuando el sistema
+ *   de archivos lo admite (ver @ref EscribirArchivoAtomico).
+ * - `--punto-control SEGUNDOS`: cada SEGUNDOS guarda junto a la salida (`SALIDA.progreso`)
+ *   los candidatos ya descartados de la búsqueda en curso (@ref ProgresoBusqueda).
+ * - `--reanudar`: continúa las búsquedas desde su último punto de control; sin
+ *   `--punto-control`, los guarda cada 60 segundos.
  *
+ * El texto de cada ganador se escribe en su archivo a medida que se descomprime; los puntos
+ * de control y las métricas se guardan en segundo plano (@ref EscritorResultados) y antes de
+ * salir se espera que terminen de guardarse.
+ *
+ * @param argc Cantidad de argumentos de la línea de comandos.
+ * @param argv Argumentos de la línea de comandos.
  * @return int Código de retorno estándar (0 si la ejecución fue correcta).
  *
  * @var sizeEncriptado Tamaño en bytes del archivo encriptado leído en memoria.
@@ -38,40 +269,191 @@
  * @var nBits          Número de bits deducido del análisis de los archivos.
  * @var claveK         Clave encontrada a partir de la pista y del encriptado.
  * @var nArchivos      Número total de archivos a procesar.
- * @var archivoEncriptado Ruta base del archivo encriptado (se modifica en cada iteración).
- * @var archivoPista      Ruta base del archivo de pista (se modifica en cada iteración).
- * @var archivoModificado Ruta base del archivo de salida modificado (se modifica en cada iteración).
+ * @var numHilos       Cantidad de hilos usada por @ref BuscarParametros.
+ * @var archivoEncriptado Ruta del archivo encriptado N (se arma en cada iteración, N sin límite de dígitos).
+ * @var archivoPista      Ruta del archivo de pista N.
+ * @var archivoModificado Ruta del archivo de salida N.
  */
-int main() {
-    int sizeEncriptado = 0;
-    int sizePista = 0;
+int main(int argc, char* argv[]) {
+    int numHilos = 1;
+    const char* directorioLote = nullptr;
+    const char* manifiesto = nullptr;
+    const char* rutaMetricas = nullptr;
+    FormatoMetricas formatoMetricas = METRICAS_JSON;
+    const char* diccionario = nullptr;
+    int requeridas = 1;
+    const char* nombreCifrado = nullptr;
+    const char* caracteres = nullptr;
+    const char* rutaCache = nullptr;
+    double intervaloPuntosControl = 0.0;
+    bool reanudar = false;
+    char** extraer = nullptr;
+    char** lz78 = nullptr;
+    int hilosDescompresion = -1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--hilos") == 0 && i + 1 < argc) {
+            numHilos = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--hilos-descompresion") == 0 && i + 1 < argc) {
+            hilosDescompresion = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--lz78") == 0 && i + 4 < argc) {
+            lz78 = argv + i + 1;
+            i += 4;
+        } else if (strcmp(argv[i], "--extraer") == 0 && i + 6 < argc) {
+            extraer = argv + i + 1;
+            i += 6;
+        } else if (strcmp(argv[i], "--lote") == 0 && i + 1 < argc) {
+            directorioLote = argv[++i];
+        } else if (strcmp(argv[i], "--manifiesto") == 0 && i + 1 < argc) {
+            manifiesto = argv[++i];
+        } else if (strcmp(argv[i], "--metricas") == 0 && i + 1 < argc) {
+            rutaMetricas = argv[++i];
+        } else if (strcmp(argv[i], "--formato-metricas") == 0 && i + 1 < argc) {
+            formatoMetricas = (strcmp(argv[++i], "prometheus") == 0) ? METRICAS_PROMETHEUS : METRICAS_JSON;
+        } else if (strcmp(argv[i], "--diccionario") == 0 && i + 1 < argc) {
+            diccionario = argv[++i];
+        } else if (strcmp(argv[i], "--aceptar") == 0 && i + 1 < argc) {
+            requeridas = LeerCriterioPistas(argv[++i]);
+        } else if (strcmp(argv[i], "--cifrado") == 0 && i + 1 < argc) {
+            nombreCifrado = argv[++i];
+        } else if (strcmp(argv[i], "--caracteres") == 0 && i + 1 < argc) {
+            caracteres = argv[++i];
+        } else if (strcmp(argv[i], "--cache") == 0 && i + 1 < argc) {
+            rutaCache = argv[++i];
+        } else if (strcmp(argv[i], "--escritura-directa") == 0) {
+            ConfigurarEscrituraDirecta(true);
+        } else if (strcmp(argv[i], "--punto-control") == 0 && i + 1 < argc) {
+            intervaloPuntosControl = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--reanudar") == 0) {
+            reanudar = true;
+        }
+    }
+
+    // El alfabeto se fija antes de cualquier búsqueda; los hilos solo lo leen
+    if (caracteres != nullptr) {
+        Alfabeto alfabeto;
+        if (!CargarAlfabeto(caracteres, alfabeto)) {
+            cout << "Alfabetos predefinidos: minusculas, letras, alfanumerico, texto, utf8" << endl;
+            return 1;
+        }
+        ConfigurarAlfabeto(alfabeto);
+        cout << "Caracteres aceptados: " << alfabeto.tamaño() << " (validacion " << ImplementacionAlfabeto()
+             << ")" << endl;
+    }
+
+    if (rutaCache != nullptr && !AbrirCacheParametros(rutaCache)) {
+        return 1;
+    }
+
+    if (reanudar && intervaloPuntosControl <= 0.0) {
+        intervaloPuntosControl = 60.0;
+    }
+    ConfigurarPuntosControl(intervaloPuntosControl, reanudar);
+
+    bool enLote = (directorioLote != nullptr || manifiesto != nullptr);
+    if (hilosDescompresion < 0) {
+        hilosDescompresion = enLote ? 1 : numHilos;
+    }
+    ConfigurarDescompresionParalela(hilosDescompresion);
+
+    // El esquema original sigue por los caminos de siempre (tablas y conjuntos de pistas)
+    const EsquemaCifrado* esquema = nullptr;
+    if (nombreCifrado != nullptr) {
+        esquema = BuscarEsquemaCifrado(nombreCifrado);
+        if (esquema == nullptr) {
+            cout << "Esquema de cifrado desconocido: " << nombreCifrado << endl;
+            MostrarEsquemasCifrado();
+            return 1;
+        }
+        int cantidad = 0;
+        if (esquema == EsquemasCifrado(cantidad)) {
+            esquema = nullptr;
+        }
+    }
+
+    // La extracción y la descompresión directa necesitan el esquema y los caracteres
+    // aceptados, así que van después de leerlos
+    if (extraer != nullptr || lz78 != nullptr) {
+        int cantidad = 0;
+        const EsquemaCifrado& esquemaArchivo = (esquema != nullptr) ? *esquema : EsquemasCifrado(cantidad)[0];
+        char** argumentos = (extraer != nullptr) ? extraer : lz78;
+        ParametrosCifrado parametros;
+        if (!LeerClaveCifrado(argumentos[2], argumentos[3], esquemaArchivo, parametros)) {
+            cout << "Clave o bits no validos para el esquema " << esquemaArchivo.nombre << endl;
+            return 1;
+        }
+        ClaveCifrado cifrado(esquemaArchivo, parametros);
+        if (lz78 != nullptr) {
+            return DescomprimirArchivoLZ78(lz78[0], lz78[1], cifrado);
+        }
+        return ExtraerRango(extraer[0], extraer[1], cifrado, strtoull(extraer[4], nullptr, 10),
+                            strtoull(extraer[5], nullptr, 10));
+    }
+
+    if (rutaMetricas != nullptr) {
+        InstalarSenalMetricas(rutaMetricas, formatoMetricas);
+    }
+
+    // Pistas comunes a todos los archivos
+    ConjuntoPistas comunes;
+    if (diccionario != nullptr && !LeerDiccionarioPistas(diccionario, comunes)) {
+        return 1;
+    }
+    bool usarConjunto = (diccionario != nullptr || requeridas != 1);
+
+    if (enLote) {
+        if (esquema != nullptr) {
+            cout << "El procesamiento en lote solo admite el esquema xor-rotr" << endl;
+            return 1;
+        }
+        int codigo = ProcesarLoteArchivos(directorioLote, manifiesto, numHilos,
+                                          (diccionario != nullptr) ? &comunes : nullptr, requeridas);
+        // Los avances de las búsquedas y los volcados de métricas van por el escritor compartido
+        EscritorCompartido().terminar();
+        if (rutaMetricas != nullptr) {
+            EscribirMetricas(rutaMetricas, formatoMetricas);
+        }
+        return codigo;
+    }
+
+    size_t sizeEncriptado = 0;
+    size_t sizePista = 0;
     int nBits = 0;
     int claveK = 0;
     int nArchivos;
     cout<<"Ingrese la cantidad de archivos a procesar: "<<endl;
     cin>>nArchivos;
-    char archivoEncriptado[] = "../../Datos/Encriptado0.txt";
-    char archivoPista[]      = "../../Datos/pista0.txt";
-    char archivoModificado[] = "../../Datos/modificado0.txt";
 
     for (int i = 1; i <= nArchivos; i++) {
-        archivoEncriptado[sizeof("../../Datos/Encriptado") - 1] = '0' + i;
-        archivoPista[sizeof("../../Datos/pista") - 1] = '0' + i;
-        archivoModificado[sizeof("../../Datos/modificado") - 1] = '0' + i;
+        string archivoEncriptado = "../../Datos/Encriptado" + to_string(i) + ".txt";
+        string archivoPista      = "../../Datos/pista" + to_string(i) + ".txt";
+        string archivoModificado = "../../Datos/modificado" + to_string(i) + ".txt";
 
         cout << "=== Procesando archivo " << i << " ===" << endl;
         cout << "Archivo encriptado: " << archivoEncriptado << endl;
         cout << "Archivo pista     : " << archivoPista << endl;
         cout << "Archivo salida    : " << archivoModificado << endl;
 
-        unsigned char* enc = leerArchivoACharArray(archivoEncriptado, sizeEncriptado);
-        unsigned char* pista = leerArchivoACharArray(archivoPista, sizePista);
-
-        if (enc != nullptr && pista != nullptr) {
-            BuscarParametros(enc, nBits, claveK, sizeEncriptado, sizePista, pista, archivoModificado);
+        // Los datos se leen directamente de las páginas del archivo; se liberan al salir del bloque
+        ArchivoMapeado enc(archivoEncriptado.c_str());
+        ArchivoMapeado pista(archivoPista.c_str());
 
-            delete[] enc;
-            delete[] pista;
+        if (enc.abierto() && pista.abierto() && enc.size() > 0 && pista.size() > 0) {
+            sizeEncriptado = enc.size();
+            sizePista = pista.size();
+            if (esquema != nullptr) {
+                ParametrosCifrado encontrados;
+                BuscarParametrosCifrado(enc.datos(), sizeEncriptado, pista.datos(), sizePista, *esquema,
+                                        archivoModificado.c_str(), numHilos, encontrados);
+            } else if (usarConjunto) {
+                ConjuntoPistas conjunto = comunes;
+                conjunto.agregar(pista.datos(), pista.size());
+                conjunto.preparar(requeridas);
+                BuscarParametrosPistas(enc.datos(), sizeEncriptado, conjunto, archivoModificado.c_str(),
+                                       numHilos, nBits, claveK);
+            } else {
+                BuscarParametros(enc.datos(), nBits, claveK, sizeEncriptado, sizePista, pista.datos(),
+                                 archivoModificado.c_str(), numHilos);
+            }
         } else {
             cout << "Error al leer los archivos para el indice " << i << endl;
         }
@@ -79,6 +461,13 @@ int main() {
         cout << "=== Fin procesamiento archivo " << i << " ===" << endl << endl;
     }
 
-    return 0;
+    // Los puntos de control se guardan en segundo plano; las métricas incluyen la escritura
+    EscritorResultados& escritor = EscritorCompartido();
+    escritor.terminar();
+
+    if (rutaMetricas != nullptr) {
+        EscribirMetricas(rutaMetricas, formatoMetricas);
+    }
+    return (escritor.errores() == 0) ? 0 : 1;
 }
 